@@ -0,0 +1,112 @@
+/*
+ * ColumnScanPerf.cpp -- CalendarColumnar queries over 1k, 100k and 1M one-time events,
+ * timed with the ColumnScan kernels picked for this CPU.  ColumnScanPerfScalar is the
+ * same, built with the kernels pinned to the plain loops, for comparison.
+ *
+ * Built with the CMake (host) build, see the top-level CMakeLists.txt, and run as
+ *   ./build/examples/ColumnScanPerf
+ *   ./build/examples/ColumnScanPerfScalar
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_NUM_EVENTS			1000000
+#define OCCURRENCES_LIST_SIZE	30
+// queries per size: about as many epochs compared for each
+#define NUM_COMPARISONS			200000000UL
+
+DefineColumnarCalendarType(Agenda, MAX_NUM_EVENTS, 4);
+
+// (13 bytes per event: a global, not on the stack)
+static Agenda MyAgenda;
+
+static const Chronos::DateTime YearStart(2016, 1, 1, 0, 0, 0);
+static const Chronos::EpochTime YearLength = 366UL * 24 * 3600;
+
+// numEvents one-time events, anywhere in 2016, up to 4 hours long
+static void setupAgenda(uint32_t numEvents)
+{
+	MyAgenda.clear();
+	srand(36);
+	for (uint32_t i=0; i<numEvents; i++)
+	{
+		Chronos::DateTime start(YearStart + (Chronos::EpochTime)(rand() % YearLength));
+		MyAgenda.emplace(1 + (i % 100), start, start + Chronos::Span::Seconds(rand() % (4 * 3600)));
+	}
+
+	// and a couple of recurring ones, as calendars do have
+	MyAgenda.emplace<Chronos::Mark::Daily>(101, Chronos::Span::Minutes(45), 9, 0, 0);
+	MyAgenda.emplace<Chronos::Mark::Weekly>(102, Chronos::Span::Hours(1),
+			Chronos::Weekday::Monday, 10, 30, 0);
+}
+
+static void run(uint32_t numEvents)
+{
+	setupAgenda(numEvents);
+
+	unsigned long numQueries = NUM_COMPARISONS / numEvents;
+	uint32_t numFound = 0;
+	Chronos::Event::Occurrence occurrenceList[OCCURRENCES_LIST_SIZE];
+	double secs[3];
+	for (int q=0; q<3; q++)
+	{
+		srand(360);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (unsigned long i=0; i<numQueries; i++)
+		{
+			Chronos::DateTime dt(YearStart + (Chronos::EpochTime)(rand() % YearLength));
+			Chronos::DateTime next;
+			switch (q)
+			{
+			case 0:
+				numFound += MyAgenda.listNext(OCCURRENCES_LIST_SIZE, occurrenceList, dt);
+				break;
+			case 1:
+				numFound += MyAgenda.listOngoing(OCCURRENCES_LIST_SIZE, occurrenceList, dt);
+				break;
+			default:
+				numFound += MyAgenda.nextDateTimeOfInterest(dt, next);
+				break;
+			}
+		}
+		secs[q] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	printf("%8lu events  %10.0f  %10.0f  %10.0f   (%lu found)\n", (unsigned long)numEvents,
+			secs[0] * 1e9 / numQueries, secs[1] * 1e9 / numQueries, secs[2] * 1e9 / numQueries,
+			(unsigned long)numFound);
+}
+
+int main()
+{
+	printf("ColumnScan kernels: %s\n", Chronos::ColumnScan::implementation());
+	printf("%15s  %10s  %10s  %10s\n", "ns/query:", "listNext", "listOngoing", "nextDTOI");
+	run(1000);
+	run(100000);
+	run(MAX_NUM_EVENTS);
+	return 0;
+}
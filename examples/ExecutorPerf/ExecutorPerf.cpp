@@ -0,0 +1,121 @@
+/*
+ * ExecutorPerf.cpp -- 10k occurrences all starting at once (e.g. the top of the hour),
+ * dispatched one after the other from a single thread, then by a CallbackExecutor with
+ * 1, 2, 4... workers, for callbacks of a few costs.
+ *
+ * Built with the CMake (host) build, see the top-level CMakeLists.txt, and run as
+ *   ./build/examples/ExecutorPerf
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+#define NUM_STARTS			10000
+#define NUM_EVENTS			100
+// as many as a calendar would list per listNext() call
+#define BATCH_SIZE			250
+#define NUM_RUNS			5
+
+static Chronos::Event::Occurrence starts[NUM_STARTS];
+static std::atomic<uint32_t> numCalled(0);
+static volatile uint32_t sink;
+
+// stand-in for the work a callback does: spins rounds times
+static void work(unsigned rounds)
+{
+	uint32_t x = 0;
+	for (unsigned i=0; i<rounds; i++)
+		x = x * 1664525 + 1013904223;
+	sink = x;
+}
+
+static double callbacksPerSec(std::chrono::steady_clock::time_point start)
+{
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return (double)NUM_STARTS * NUM_RUNS / secs;
+}
+
+static double dispatchInline(unsigned rounds)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int run=0; run<NUM_RUNS; run++)
+	{
+		for (uint32_t i=0; i<NUM_STARTS; i++)
+		{
+			work(rounds);
+			numCalled.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	return callbacksPerSec(start);
+}
+
+static double dispatchExecutor(unsigned rounds, unsigned numWorkers)
+{
+	Chronos::CallbackExecutor executor([rounds](const Chronos::Event::Occurrence &) {
+		work(rounds);
+		numCalled.fetch_add(1, std::memory_order_relaxed);
+	}, numWorkers);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int run=0; run<NUM_RUNS; run++)
+	{
+		for (uint32_t i=0; i<NUM_STARTS; i += BATCH_SIZE)
+			executor.submit(&(starts[i]), BATCH_SIZE);
+		executor.waitIdle();
+	}
+	return callbacksPerSec(start);
+}
+
+int main()
+{
+	// NUM_STARTS occurrences of NUM_EVENTS events, all starting at 9:00
+	Chronos::DateTime nine(2016, 3, 1, 9, 0, 0);
+	for (uint32_t i=0; i<NUM_STARTS; i++)
+	{
+		starts[i].id = 1 + (i % NUM_EVENTS);
+		starts[i].start = nine;
+		starts[i].finish = nine + Chronos::Span::Minutes(1 + (i / NUM_EVENTS));
+	}
+
+	unsigned cores = std::thread::hardware_concurrency();
+	printf("%u simultaneous starts of %u events, %u cores\n", NUM_STARTS, NUM_EVENTS, cores);
+	printf("%12s  %12s", "callbacks/s:", "inline");
+	for (unsigned w=1; w <= (cores > 4 ? cores : 4); w *= 2)
+		printf("  %6u workers", w);
+	printf("\n");
+
+	const unsigned costs[] = { 0, 100, 1000, 10000 };
+	for (unsigned c=0; c<sizeof(costs) / sizeof(costs[0]); c++)
+	{
+		printf("%6u spins  %12.0f", costs[c], dispatchInline(costs[c]));
+		for (unsigned w=1; w <= (cores > 4 ? cores : 4); w *= 2)
+			printf("  %14.0f", dispatchExecutor(costs[c], w));
+		printf("\n");
+	}
+
+	return 0;
+}
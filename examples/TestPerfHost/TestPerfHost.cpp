@@ -0,0 +1,131 @@
+/*
+ * TestPerfHost.cpp -- TestPerf's add/clear + query loop, run natively, timed and with
+ * a count of heap allocations -- plus the same loop with a user-defined mark, which
+ * events hold on the heap and share between copies.
+ *
+ * Built with the CMake (host) build, see the top-level CMakeLists.txt, and run as
+ *   ./build/examples/TestPerfHost [NUM_RUNS]
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_RUNS_DEFAULT	200000
+#define CALENDAR_MAX_NUM_EVENTS   8
+#define OCCURRENCES_LIST_SIZE   30
+
+// every heap allocation in the process (marks included) is counted here
+static unsigned long num_allocations = 0;
+void * operator new(size_t size) { num_allocations++; return malloc(size); }
+void operator delete(void * ptr) noexcept { free(ptr); }
+void operator delete(void * ptr, size_t) noexcept { free(ptr); }
+
+DefineCalendarType(Calendar, CALENDAR_MAX_NUM_EVENTS);
+Calendar MyCalendar;
+
+// the council of the elders, now on the first monday *and* thursday of the month:
+// a composite, so a user-defined mark from the Chronos::Event's point of view
+static const Chronos::Mark::Union CouncilMeetings(
+		Chronos::Mark::MonthlyNthWeekday(1, Chronos::Weekday::Monday, 19, 0, 0),
+		Chronos::Mark::MonthlyNthWeekday(1, Chronos::Weekday::Thursday, 19, 0, 0));
+static const Chronos::Event CouncilEvent(7, CouncilMeetings, Chronos::Span::Hours(2));
+
+// same as TestPerf's
+void setupCal(bool userDefinedMark) {
+	MyCalendar.clear();
+
+	MyCalendar.add(Chronos::Event(1, Chronos::DateTime(2015, 12, 21, 17, 00),
+			Chronos::Span::Minutes(33)));
+	MyCalendar.add(Chronos::Event(2, Chronos::Mark::Daily(9, 00, 00),
+			Chronos::Span::Minutes(45)));
+	MyCalendar.add(Chronos::Event(3, Chronos::DateTime(2015, 12, 21, 18, 00),
+			Chronos::DateTime(2015, 12, 22, 1, 00)));
+	MyCalendar.add(Chronos::Event(4,
+			Chronos::Mark::Weekly(Chronos::Weekday::Monday, 10, 30, 00),
+			Chronos::Span::Hours(1)));
+	MyCalendar.add(Chronos::Event(5, Chronos::DateTime(2015, 12, 31, 21, 00),
+			Chronos::Span::Days(2)));
+	MyCalendar.add(Chronos::Event(6, Chronos::DateTime(2015, 12, 28, 19, 15),
+			Chronos::Span::Minutes(90)));
+
+	if (userDefinedMark)
+	{
+		MyCalendar.add(CouncilEvent);
+	} else {
+		MyCalendar.add(Chronos::Event(7, Chronos::Mark::Monthly(2, 19, 0, 0),
+				Chronos::Span::Hours(2)));
+	}
+}
+
+uint32_t calendarTest() {
+	uint32_t numRet = 0;
+	Chronos::DateTime nowTime(Chronos::DateTime::now());
+	Chronos::Event::Occurrence occurrenceList[OCCURRENCES_LIST_SIZE];
+
+	numRet += MyCalendar.listOngoing(OCCURRENCES_LIST_SIZE, occurrenceList, nowTime);
+	numRet += MyCalendar.listNext(OCCURRENCES_LIST_SIZE, occurrenceList, nowTime);
+
+	Chronos::DateTime nextMonday = nowTime.next(Chronos::Weekday::Monday);
+	numRet += MyCalendar.listForDay(OCCURRENCES_LIST_SIZE, occurrenceList, nextMonday);
+	return numRet;
+}
+
+static void run(const char * name, bool userDefinedMark, bool withQueries, unsigned long numRuns)
+{
+	uint32_t numFound = 0;
+	unsigned long allocationsBefore = num_allocations;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned long i=0; i<numRuns; i++)
+	{
+		setupCal(userDefinedMark);
+		if (withQueries)
+			numFound += calendarTest();
+	}
+
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-34s %8.0f ns/run  %5.2f allocations/run  (%lu occurrences)\n", name,
+			secs * 1e9 / numRuns, (double)(num_allocations - allocationsBefore) / numRuns,
+			(unsigned long)numFound);
+}
+
+int main(int argc, char * argv[])
+{
+	unsigned long numRuns = (argc > 1) ? strtoul(argv[1], NULL, 10) : NUM_RUNS_DEFAULT;
+
+	// setting for monday, dec 21st 2015 @ 17:30:00
+	Chronos::DateTime::setTime(2015, 12, 21, 17, 30, 0);
+
+	// (warm up)
+	for (int i=0; i<10000; i++)
+		setupCal(i % 2);
+
+	run("add/clear, built-in marks", false, false, numRuns);
+	run("add/clear, user-defined mark", true, false, numRuns);
+	run("add/clear + queries, built-in marks", false, true, numRuns);
+	run("add/clear + queries, user-defined", true, true, numRuns);
+	return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * CachedClock.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/platform/timesource.h"
+
+#ifdef CHRONOS_CLOCK_CACHED
+
+namespace Chronos {
+
+#ifdef CACHEDCLOCK_ATOMIC
+std::atomic<EpochTime> CachedClock::cached(0);
+#else
+volatile EpochTime CachedClock::cached = 0;
+#endif
+
+EpochTime CachedClock::refresh()
+{
+	EpochTime t = DATETIME_READ_CLOCK_EPOCH();
+#ifdef CACHEDCLOCK_ATOMIC
+	cached.store(t, std::memory_order_relaxed);
+#else
+	cached = t;
+#endif
+	return t;
+}
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CLOCK_CACHED */
@@ -29,8 +29,14 @@
 namespace Chronos {
 
 
-Calendar::Calendar(uint8_t maxEvents) : num_events(0), max_events(maxEvents), num_recurring(0){
+Calendar::Calendar(uint8_t maxEvents) : num_events(0), max_events(maxEvents), num_recurring(0),
+		update_depth(0), index_stale(false) {
 
+	for (uint8_t t=0; t<CHRONOS_CALENDAR_INDEXED_TAGS; t++)
+	{
+		tag_first[t] = CALENDAR_SLOT_NONE;
+		tag_last[t] = CALENDAR_SLOT_NONE;
+	}
 
 }
 
@@ -52,6 +58,7 @@ void Calendar::clear() {
 	}
 	num_events = 0;
 	num_recurring = 0;
+	refreshIndex();
 
 }
 bool Calendar::remove(EventID evId)
@@ -92,26 +99,54 @@ bool Calendar::remove(EventID evId)
 	// no matter what, we now have one less...
 	num_events--;
 
+	// everything after pos moved down a slot
+	refreshIndex();
 
 	return foundIt;
 }
-bool Calendar::add(const Chronos::Event & event)
+bool Calendar::eventAt(uint32_t i, Chronos::Event & into)
 {
-	if (num_events >= max_events)
+	if (i >= num_events)
+		return false;
+
+	Chronos::Event * evt = this->eventSlot(i);
+	if (NULL == evt)
 		return false;
 
+	into = *evt;
+	return true;
+}
+
+Chronos::Event * Calendar::claimSlot(bool recurring)
+{
+	if (num_events >= max_events)
+		return NULL;
+
 	Chronos::Event * evt = this->eventSlot(num_events);
 
 	if (NULL == evt)
-		return false;
+		return NULL;
 
 	num_events++;
-	if (event.isRecurring())
+	if (recurring)
 	{
 		num_recurring++;
 
 	}
 
+	return evt;
+}
+
+bool Calendar::add(const Chronos::Event & event)
+{
+	if (! event.isValid())
+		return false;
+
+	Chronos::Event * evt = claimSlot(event.isRecurring());
+
+	if (NULL == evt)
+		return false;
+
 	CHRONOS_DEBUG_OUT("Assigning event ");
 	CHRONOS_DEBUG_OUTHEX(&event);
 	CHRONOS_DEBUG_OUT(" to slot ");
@@ -119,114 +154,142 @@ bool Calendar::add(const Chronos::Event & event)
 	CHRONOS_DEBUG_OUTLN("!");
 
 	*evt = event;
+	indexSlot(num_events - 1);
 
 	return true;
 
 
 }
 
+bool Calendar::emplace(EventID id, const DateTime & start, const DateTime & end)
+{
+	Chronos::Event * evt = claimSlot(false);
+
+	if (NULL == evt)
+		return false;
+
+	evt->set(id, start, end);
+	indexSlot(num_events - 1);
+
+	return true;
+}
+
 
 #ifdef PLATFORM_SUPPORTS_RVAL_MOVE
 bool Calendar::add(Chronos::Event&& event)
 {
-
-	if (num_events >= max_events)
+	if (! event.isValid())
 		return false;
 
-	Chronos::Event * evt = this->eventSlot(num_events);
+	Chronos::Event * evt = claimSlot(event.isRecurring());
 
 	if (NULL == evt)
 		return false;
 
-	num_events++;
-	if (event.isRecurring())
-	{
-		num_recurring++;
-
-	}
 	CHRONOS_DEBUG_OUT("Moving event ");
 	CHRONOS_DEBUG_OUTHEX(&event);
 	CHRONOS_DEBUG_OUT(" to slot ");
 	CHRONOS_DEBUG_OUTINT(num_events);
 	CHRONOS_DEBUG_OUTLN("!");
 
-
-	*evt = event;
+	// event is a named rvalue reference, an lvalue in here: std::move
+	// it along or we'd end up in the copy assignment
+	*evt = std::move(event);
+	indexSlot(num_events - 1);
 
 	return true;
 }
 #endif
 
-uint8_t Calendar::listNext(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+bool Calendar::insertOccurrence(const Event::Occurrence & occ, uint8_t number, Event::Occurrence into[])
 {
-	uint8_t ev=0;
-	uint8_t addedIdx = 0;
-
-	{
-		Chronos::DateTime farFuture(Chronos::DateTime::endOfTime());
-		Event::Occurrence dummy(EVENTID_NOTSET, farFuture, farFuture);
-		for (uint8_t i=0; i<number;i++)
-			into[i]=dummy;
-	}
-
-	while (ev < num_events)
-	{
+	// into is sorted, so if occ doesn't beat the last
+	// (latest) entry, it doesn't beat any of them
+	if (! number || ! (occ.start < into[number - 1].start))
+		return false;
 
-		Chronos::Event * evt = this->eventSlot(ev++);
+	// ok, this event bumps one from our return array,
+	// we place it at the end of the array, as we know
+	// that guy'll be bumped out
+	into[number-1] = occ;
 
-		if (NULL == evt)
-			continue;
 
-		if (! evt->hasNext(dt))
-		{
-			continue;
-		}
+	// now we have a mostly-sorted array where all elements
+	// are <= to the ones to their right, except (possibly)
+	// for our new guy, e.g.
+	// [1,1,2,3,4,4 ... 20, NEWGUY]
 
-		uint8_t maxNumToAdd = evt->isRecurring() ? number : 1;
-		bool didInsert = false;
+	// what we need is to move him left until we can't anymore
+	Chronos::Sort::leftSortLastElement(into, number);
 
-		DateTime recStartDt(dt);
-		for (uint8_t addNum=0; addNum<maxNumToAdd; addNum++ )
-		{
+	return true;
+}
 
-			Event::Occurrence occ(evt->nextOccurrence(recStartDt));
-			for (int16_t i=number; i>=0; i--)
-			{
+void Calendar::padList(uint8_t number, Event::Occurrence into[])
+{
+	Chronos::DateTime farFuture(Chronos::DateTime::endOfTime());
+	Event::Occurrence dummy(EVENTID_NOTSET, farFuture, farFuture);
+	for (uint8_t i=0; i<number;i++)
+		into[i]=dummy;
+}
 
-				if (occ.start < into[i].start)
-				{
-					// ok, this event bumps one from our return array,
-					// we place it at the end of the array, as we know
-					// that guy'll be bumped out
-					into[number-1] = occ;
+void Calendar::listNextOf(Chronos::Event * evt, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	if (NULL == evt)
+		return;
 
+	if (! evt->hasNext(dt))
+	{
+		return;
+	}
 
-					// now we have a mostly-sorted array where all elements
-					// are <= to the ones to their right, except (possibly)
-					// for our new guy, e.g.
-					// [1,1,2,3,4,4 ... 20, NEWGUY]
+	if (! evt->isRecurring())
+	{
+		insertOccurrence(evt->nextOccurrence(dt), number, into);
+		return;
+	}
 
-					// what we need is to move him left until we can't anymore
-					Chronos::Sort::leftSortLastElement(into, number);
+	// recurring events: walk the mark from dt, for as long as
+	// the occurrences still make it into the list
+	Chronos::Mark::Cursor cursor(evt->cursor(dt));
+	for (uint8_t addNum=0; addNum<number; addNum++ )
+	{
+		Event::Occurrence occ(evt->nextOccurrence(cursor));
+		if (occ.id == EVENTID_NOTSET || ! insertOccurrence(occ, number, into))
+		{
+			// series is over, or all future occurrences won't fit either
+			break;
+		}
+	}
+}
 
-					// Chronos::Sort::bubble(into, number);
-					didInsert = true;
-					break;
-				}
-			}
+uint8_t Calendar::listNext(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	padList(number, into);
 
-			if (! didInsert)
-			{
-				// all future occurrences won't fit either
-				break;
-			}
+	for (uint8_t ev=0; ev < num_events; ev++)
+	{
+		listNextOf(this->eventSlot(ev), number, into, dt);
+	}
 
-			recStartDt = occ.start + Chronos::Span::Seconds(1);
+	return numListed(number, into);
+}
 
-		}
+uint8_t Calendar::listNext(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	padList(number, into);
 
+	for (uint8_t ev=firstTagged(tag); ev != CALENDAR_SLOT_NONE; ev = nextTagged(tag, ev))
+	{
+		listNextOf(this->eventSlot(ev), number, into, dt);
 	}
 
+	return numListed(number, into);
+}
+
+uint8_t Calendar::numListed(uint8_t number, const Event::Occurrence into[])
+{
+	uint8_t addedIdx = 0;
 	while (addedIdx < number)
 	{
 		if (into[addedIdx].id == EVENTID_NOTSET)
@@ -242,6 +305,16 @@ uint8_t Calendar::listNext(uint8_t number, Event::Occurrence into[], const DateT
 
 }
 bool Calendar::nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT)
+{
+	return closestStartOrEnd(fromDT, returnDT, false);
+}
+
+bool Calendar::slotsDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT)
+{
+	return closestStartOrEnd(fromDT, returnDT, true);
+}
+
+bool Calendar::closestStartOrEnd(const DateTime & fromDT, DateTime & returnDT, bool slotsOnly)
 {
 
 	if (! num_events)
@@ -255,7 +328,8 @@ bool Calendar::nextDateTimeOfInterest(const DateTime & fromDT, DateTime & return
 	}
 
 	returnDT = DateTime::endOfTime(); // arbitrary far future date
-	uint8_t numOngoing = listOngoing(max_events, eventOccs, fromDT);
+	uint8_t numOngoing = slotsOnly ? Calendar::listOngoing(max_events, eventOccs, fromDT)
+			: listOngoing(max_events, eventOccs, fromDT);
 
 
 	bool foundSomething = false;
@@ -271,7 +345,8 @@ bool Calendar::nextDateTimeOfInterest(const DateTime & fromDT, DateTime & return
 	}
 
 
-	uint8_t numNext = listNext(max_events, eventOccs, fromDT);
+	uint8_t numNext = slotsOnly ? Calendar::listNext(max_events, eventOccs, fromDT)
+			: listNext(max_events, eventOccs, fromDT);
 
 
 	for (uint8_t i=0; i<numNext; i++)
@@ -383,6 +458,176 @@ uint8_t Calendar::listOngoing(uint8_t number, Event::Occurrence into[], const Da
 	return addedIdx;
 }
 
+uint8_t Calendar::listOngoing(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	uint8_t addedIdx = 0;
+	for (uint8_t ev=firstTagged(tag); ev != CALENDAR_SLOT_NONE && addedIdx < number; ev = nextTagged(tag, ev))
+	{
+		Chronos::Event * evt = this->eventSlot(ev);
+
+		if (NULL == evt)
+			continue;
+
+		Event::Occurrence occ = evt->closestOccurrence(dt);
+		if (occ.isOngoing)
+		{
+			into[addedIdx++] = occ;
+		}
+	}
+
+	Chronos::Sort::bubble(into, addedIdx);
+	return addedIdx;
+}
+
+bool Calendar::nextOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+{
+	bool foundIt = false;
+	for (uint8_t i=0; i<num_events; i++)
+	{
+		Chronos::Event * evt = this->eventSlot(i);
+		if (NULL == evt || evt->id() != evId || ! evt->hasNext(dt))
+			continue;
+
+		Event::Occurrence occ(evt->nextOccurrence(dt));
+		if (occ.id != EVENTID_NOTSET && (! foundIt || occ.start < into.start))
+		{
+			into = occ;
+			foundIt = true;
+		}
+	}
+
+	return foundIt;
+}
+
+bool Calendar::currentOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+{
+	for (uint8_t i=0; i<num_events; i++)
+	{
+		Chronos::Event * evt = this->eventSlot(i);
+		if (NULL == evt || evt->id() != evId)
+			continue;
+
+		Event::Occurrence occ(evt->closestOccurrence(dt));
+		if (occ.isOngoing)
+		{
+			into = occ;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Calendar::setTag(EventID evId, EventTag tag)
+{
+	bool foundIt = false;
+
+	if (evId <= EVENTID_NOTSET)
+		return false;
+
+	for (uint8_t i=0; i<num_events; i++)
+	{
+		Chronos::Event * evt = this->eventSlot(i);
+		if (evt && evt->id() == evId)
+		{
+			evt->setTag(tag);
+			foundIt = true;
+		}
+	}
+
+	if (foundIt)
+	{
+		refreshIndex();
+	}
+
+	return foundIt;
+}
+
+void Calendar::beginUpdate()
+{
+	update_depth++;
+}
+
+void Calendar::endUpdate()
+{
+	if (update_depth && ! --update_depth && index_stale)
+	{
+		reindex();
+	}
+}
+
+bool Calendar::tagIndexed(EventTag tag)
+{
+	return (! index_stale) && (tag < CHRONOS_CALENDAR_INDEXED_TAGS) && (NULL != this->tagLink(0));
+}
+
+void Calendar::indexSlot(uint8_t i)
+{
+	Chronos::Event * evt = this->eventSlot(i);
+	if (NULL == evt || ! tagIndexed(evt->tag()))
+		return;
+
+	EventTag tag = evt->tag();
+	*(this->tagLink(i)) = CALENDAR_SLOT_NONE;
+	if (tag_last[tag] == CALENDAR_SLOT_NONE)
+	{
+		tag_first[tag] = i;
+	} else {
+		*(this->tagLink(tag_last[tag])) = i;
+	}
+	tag_last[tag] = i;
+}
+
+void Calendar::refreshIndex()
+{
+	if (update_depth)
+	{
+		index_stale = true;
+		return;
+	}
+
+	reindex();
+}
+
+void Calendar::reindex()
+{
+	index_stale = false;
+	for (uint8_t t=0; t<CHRONOS_CALENDAR_INDEXED_TAGS; t++)
+	{
+		tag_first[t] = CALENDAR_SLOT_NONE;
+		tag_last[t] = CALENDAR_SLOT_NONE;
+	}
+
+	for (uint8_t i=0; i<num_events; i++)
+	{
+		indexSlot(i);
+	}
+}
+
+uint8_t Calendar::firstTagged(EventTag tag)
+{
+	if (tagIndexed(tag))
+		return tag_first[tag];
+
+	return nextTagged(tag, CALENDAR_SLOT_NONE);
+}
+
+uint8_t Calendar::nextTagged(EventTag tag, uint8_t slot)
+{
+	if (tagIndexed(tag))
+		return *(this->tagLink(slot));
+
+	// no index for this one, scan along (CALENDAR_SLOT_NONE + 1 wraps to 0)
+	for (uint8_t i=slot+1; i<num_events; i++)
+	{
+		Chronos::Event * evt = this->eventSlot(i);
+		if (evt && evt->tag() == tag)
+			return i;
+	}
+
+	return CALENDAR_SLOT_NONE;
+}
+
 uint8_t Calendar::listForDay(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
 {
 	DateTime startOfDay = dt.startOfDay();
@@ -0,0 +1,636 @@
+/*
+ * CalendarImage.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/CalendarImage.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CHRONOS_PLATFORM_POSIX
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define CALENDARIMAGE_MAGIC				"CHRI"
+#define CALENDARIMAGE_BYTE_ORDER		0x0102
+// recurring events are slots in the base Calendar, so stop short of CALENDAR_SLOT_NONE
+#define CALENDARIMAGE_MAX_RECURRING		(CALENDAR_SLOT_NONE - 1)
+// bytes per one-time event, over all its columns
+#define CALENDARIMAGE_ONETIME_BYTES		(2*sizeof(Chronos::EpochTime) + sizeof(uint32_t) + \
+											sizeof(Chronos::EventID) + sizeof(Chronos::EventTag))
+
+namespace Chronos {
+
+/*
+ * Where everything goes, given the counts in hdr -- the Builder writes images
+ * this way, and validate() only accepts images laid out so.
+ */
+static void layout(CalendarImage::Header & hdr)
+{
+	hdr.starts = sizeof(CalendarImage::Header);
+	hdr.ends = hdr.starts + hdr.num_onetime * sizeof(Chronos::EpochTime);
+	hdr.by_id = hdr.ends + hdr.num_onetime * sizeof(Chronos::EpochTime);
+	hdr.recurring = hdr.by_id + hdr.num_onetime * sizeof(uint32_t);
+	hdr.ids = hdr.recurring + hdr.num_recurring * sizeof(CalendarImage::Record);
+	hdr.tags = hdr.ids + hdr.num_onetime * sizeof(EventID);
+	// padded, so images can be laid end to end
+	hdr.size = (hdr.tags + hdr.num_onetime * sizeof(EventTag) + 3) & ~((uint32_t)3);
+}
+
+CalendarImage::CalendarImage() : Calendar(CALENDARIMAGE_MAX_RECURRING),
+		header(NULL),
+		starts(NULL),
+		ends(NULL),
+		by_id(NULL),
+		records(NULL),
+		ids(NULL),
+		tags(NULL),
+		num_onetime(0),
+		scratch_slot(CALENDAR_SLOT_NONE),
+		mapped(NULL),
+		mapped_size(0)
+{
+
+}
+
+CalendarImage::~CalendarImage()
+{
+	CalendarImage::clear();
+}
+
+bool CalendarImage::validate(const Header * hdr, uint32_t size)
+{
+	if (size < sizeof(Header))
+		return false;
+
+	if (memcmp(hdr->magic, CALENDARIMAGE_MAGIC, sizeof(hdr->magic)) != 0
+			|| hdr->version != CHRONOS_CALENDAR_IMAGE_VERSION
+			|| hdr->byte_order != CALENDARIMAGE_BYTE_ORDER)
+	{
+		CHRONOS_DEBUG_OUTLN("CalendarImage: not an image, or from another version/byte order");
+		return false;
+	}
+
+	// counts that fit in the image, so the layout can't overflow...
+	uint32_t available = hdr->size - sizeof(Header);
+	if (hdr->size > size || hdr->size < sizeof(Header)
+			|| hdr->num_recurring > CALENDARIMAGE_MAX_RECURRING
+			|| hdr->num_onetime > available / CALENDARIMAGE_ONETIME_BYTES
+			|| hdr->num_recurring * sizeof(Record) > available - hdr->num_onetime * CALENDARIMAGE_ONETIME_BYTES)
+	{
+		CHRONOS_DEBUG_OUTLN("CalendarImage: truncated image");
+		return false;
+	}
+
+	// ... and everything exactly where it should be
+	Header expected(*hdr);
+	layout(expected);
+	return expected.size == hdr->size
+			&& expected.starts == hdr->starts
+			&& expected.ends == hdr->ends
+			&& expected.by_id == hdr->by_id
+			&& expected.recurring == hdr->recurring
+			&& expected.ids == hdr->ids
+			&& expected.tags == hdr->tags;
+}
+
+bool CalendarImage::attach(const void * image, uint32_t size)
+{
+	clear();
+
+	const Header * hdr = reinterpret_cast<const Header *>(image);
+	if (NULL == image || (reinterpret_cast<uintptr_t>(image) & 3) || ! validate(hdr, size))
+		return false;
+
+	header = hdr;
+	starts = column<Chronos::EpochTime>(hdr->starts);
+	ends = column<Chronos::EpochTime>(hdr->ends);
+	by_id = column<uint32_t>(hdr->by_id);
+	records = column<Record>(hdr->recurring);
+	ids = column<EventID>(hdr->ids);
+	tags = column<EventTag>(hdr->tags);
+	num_onetime = hdr->num_onetime;
+
+	// recurring events take slots in the base Calendar, each one is
+	// rebuilt along the way, which checks its mark
+	for (uint32_t i=0; i<hdr->num_recurring; i++)
+	{
+		if (NULL == claimSlot(true))
+		{
+			CHRONOS_DEBUG_OUTLN("CalendarImage: bad recurring event");
+			clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#ifdef CHRONOS_PLATFORM_POSIX
+bool CalendarImage::map(const char * path)
+{
+	clear();
+
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	void * image = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= 0xffffffffULL)
+	{
+		image = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	// (the mapping outlives the descriptor)
+	close(fd);
+
+	if (MAP_FAILED == image)
+		return false;
+
+	if (! attach(image, st.st_size))
+	{
+		munmap(image, st.st_size);
+		return false;
+	}
+
+	mapped = image;
+	mapped_size = st.st_size;
+	return true;
+}
+#endif
+
+void CalendarImage::clear()
+{
+	Calendar::clear();
+	scratch.reset();
+	scratch_slot = CALENDAR_SLOT_NONE;
+
+	header = NULL;
+	starts = ends = NULL;
+	by_id = NULL;
+	records = NULL;
+	ids = NULL;
+	tags = NULL;
+	num_onetime = 0;
+
+#ifdef CHRONOS_PLATFORM_POSIX
+	if (mapped)
+	{
+		munmap(mapped, mapped_size);
+	}
+#endif
+	mapped = NULL;
+	mapped_size = 0;
+}
+
+Chronos::Event * CalendarImage::eventSlot(uint8_t i)
+{
+	if (NULL == header || i >= header->num_recurring)
+		return NULL;
+
+	if (i != scratch_slot)
+	{
+		const Record & rec = records[i];
+		if (! scratch.restoreFrom(rec.id, rec.tag, rec.mark, rec.length, rec.first, rec.last))
+		{
+			scratch_slot = CALENDAR_SLOT_NONE;
+			return NULL;
+		}
+		scratch_slot = i;
+	}
+
+	return &scratch;
+}
+
+uint32_t CalendarImage::firstStartAfter(Chronos::EpochTime epoch, uint32_t low) const
+{
+	uint32_t high = num_onetime;
+	while (low < high)
+	{
+		uint32_t mid = low + (high - low) / 2;
+		if (starts[mid] <= epoch)
+		{
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+uint32_t CalendarImage::firstMaybeOngoing(Chronos::EpochTime epoch) const
+{
+	// nothing lasts longer than max_length, so anything ongoing started after epoch - max_length
+	if (epoch < header->max_length)
+		return 0;
+
+	return firstStartAfter(epoch - header->max_length);
+}
+
+uint32_t CalendarImage::firstOfIdAfter(EventID evId, Chronos::EpochTime epoch) const
+{
+	uint32_t low = 0;
+	uint32_t high = num_onetime;
+	while (low < high)
+	{
+		uint32_t mid = low + (high - low) / 2;
+		uint32_t pos = position(mid);
+		if (ids[pos] < evId || (ids[pos] == evId && starts[pos] <= epoch))
+		{
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+uint8_t CalendarImage::listNext(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	if (! number)
+		return 0;
+
+	// recurring events first, this leaves the tail of into[] padded
+	// with end-of-time entries, ready for insertOccurrence()
+	Calendar::listNext(number, into, dt);
+	return listNextOneTime(NULL, number, into, dt);
+}
+
+uint8_t CalendarImage::listNext(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	if (! number)
+		return 0;
+
+	Calendar::listNext(tag, number, into, dt);
+	return listNextOneTime(&tag, number, into, dt);
+}
+
+uint8_t CalendarImage::listOngoing(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	return listOngoingOneTime(NULL, Calendar::listOngoing(number, into, dt), number, into, dt);
+}
+
+uint8_t CalendarImage::listOngoing(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+{
+	return listOngoingOneTime(&tag, Calendar::listOngoing(tag, number, into, dt), number, into, dt);
+}
+
+uint8_t CalendarImage::listNextOneTime(const EventTag * tag, uint8_t number, Event::Occurrence into[],
+		const DateTime & dt)
+{
+	// anything starting at or beyond the last entry won't make it in, and
+	// with starts sorted, neither will anything after it
+	Chronos::EpochTime cutoff = into[number - 1].start.asEpoch();
+	for (uint32_t i=firstStartAfter(dt.asEpoch()); i<num_onetime && starts[i] < cutoff; i++)
+	{
+		if (NULL != tag && tags[i] != *tag)
+			continue;
+
+		insertOccurrence(occurrenceAt(i), number, into);
+		cutoff = into[number - 1].start.asEpoch();
+	}
+
+	return numListed(number, into);
+}
+
+uint8_t CalendarImage::listOngoingOneTime(const EventTag * tag, uint8_t numFound, uint8_t number,
+		Event::Occurrence into[], const DateTime & dt)
+{
+	if (numFound >= number || NULL == header)
+		return numFound;
+
+	Chronos::EpochTime at = dt.asEpoch();
+	uint32_t low = firstMaybeOngoing(at);
+	uint32_t high = firstStartAfter(at, low);
+	uint16_t hits[CHRONOS_COLUMN_SCAN_BLOCK];
+	for (uint32_t block=low; block<high && numFound < number; block += CHRONOS_COLUMN_SCAN_BLOCK)
+	{
+		uint16_t blockSize = (high - block) < CHRONOS_COLUMN_SCAN_BLOCK ? (high - block) : CHRONOS_COLUMN_SCAN_BLOCK;
+		uint16_t numHits = ColumnScan::spanning(&(starts[block]), &(ends[block]), blockSize, at, hits);
+
+		for (uint16_t h=0; h<numHits && numFound < number; h++)
+		{
+			uint32_t i = block + hits[h];
+			if (NULL != tag && tags[i] != *tag)
+				continue;
+
+			into[numFound++] = occurrenceAt(i, true);
+		}
+	}
+
+	Chronos::Sort::bubble(into, numFound);
+	return numFound;
+}
+
+bool CalendarImage::nextOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+{
+	bool foundIt = Calendar::nextOccurrenceOf(evId, dt, into);
+
+	// the by_id index has each id's events in order of start
+	uint32_t k = firstOfIdAfter(evId, dt.asEpoch());
+	if (k < num_onetime)
+	{
+		uint32_t i = position(k);
+		if (ids[i] == evId && (! foundIt || starts[i] < into.start.asEpoch()))
+		{
+			into = occurrenceAt(i);
+			foundIt = true;
+		}
+	}
+
+	return foundIt;
+}
+
+bool CalendarImage::currentOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+{
+	Chronos::EpochTime at = dt.asEpoch();
+
+	// back from the first of evId starting after dt, through those that may still be going on
+	for (uint32_t k=firstOfIdAfter(evId, at); k > 0; k--)
+	{
+		uint32_t i = position(k - 1);
+		if (ids[i] != evId || at - starts[i] >= header->max_length)
+			break;
+
+		if (ends[i] > at)
+		{
+			into = occurrenceAt(i, true);
+			return true;
+		}
+	}
+
+	return Calendar::currentOccurrenceOf(evId, dt, into);
+}
+
+bool CalendarImage::nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT)
+{
+	// closest start or end amongst the recurring events...
+	bool foundSomething = slotsDateTimeOfInterest(fromDT, returnDT);
+	Chronos::EpochTime closest = foundSomething ? returnDT.asEpoch() : DateTime::endOfTime().asEpoch();
+
+	if (NULL != header)
+	{
+		// ... the next one-time start ...
+		Chronos::EpochTime at = fromDT.asEpoch();
+		uint32_t next = firstStartAfter(at);
+		if (next < num_onetime && starts[next] < closest)
+		{
+			closest = starts[next];
+			foundSomething = true;
+		}
+
+		// ... and the ends of those that may be ongoing
+		for (uint32_t i=firstMaybeOngoing(at); i<next; i++)
+		{
+			if (ends[i] > at && ends[i] < closest)
+			{
+				closest = ends[i];
+				foundSomething = true;
+			}
+		}
+	}
+
+	if (foundSomething)
+	{
+		returnDT = DateTime(closest);
+	}
+
+	return foundSomething;
+}
+
+bool CalendarImage::eventAt(uint32_t i, Chronos::Event & into)
+{
+	if (i < Calendar::numEvents())
+		return Calendar::eventAt(i, into);
+
+	i -= Calendar::numEvents();
+	if (i >= num_onetime)
+		return false;
+
+	into.set(ids[i], DateTime(starts[i]), DateTime(ends[i]));
+	into.setTag(tags[i]);
+	return true;
+}
+
+bool CalendarImage::save(const Chronos::Event & event, Record & into)
+{
+	into = Record();
+	into.id = event.id();
+	into.tag = event.tag();
+	return event.saveTo(into.mark, into.length, into.first, into.last);
+}
+
+CalendarImage::Builder::Builder() :
+		onetime(NULL),
+		num_onetime(0),
+		onetime_capacity(0),
+		recurring(NULL),
+		num_recurring(0),
+		recurring_capacity(0)
+{
+
+}
+
+CalendarImage::Builder::~Builder()
+{
+	delete [] onetime;
+	delete [] recurring;
+}
+
+bool CalendarImage::Builder::add(const Chronos::Event & event)
+{
+	if (event.isRecurring())
+	{
+		Record rec;
+		if (num_recurring >= CALENDARIMAGE_MAX_RECURRING || ! CalendarImage::save(event, rec))
+			return false;
+
+		if (num_recurring >= recurring_capacity)
+		{
+			uint8_t newCapacity = (recurring_capacity > CALENDARIMAGE_MAX_RECURRING / 2) ?
+					CALENDARIMAGE_MAX_RECURRING : (recurring_capacity ? recurring_capacity * 2 : 4);
+			Record * grown = new Record[newCapacity];
+			if (! grown)
+			{
+				CHRONOS_DEBUG_OUTLN("CalendarImage::Builder: Couldn't allocate space for events?");
+				return false;
+			}
+
+			for (uint8_t i=0; i<num_recurring; i++)
+			{
+				grown[i] = recurring[i];
+			}
+			delete [] recurring;
+			recurring = grown;
+			recurring_capacity = newCapacity;
+		}
+
+		recurring[num_recurring++] = rec;
+		return true;
+	}
+
+	if (num_onetime >= onetime_capacity)
+	{
+		uint32_t newCapacity = onetime_capacity ? onetime_capacity * 2 : 16;
+		OneTime * grown = new OneTime[newCapacity];
+		if (! grown)
+		{
+			CHRONOS_DEBUG_OUTLN("CalendarImage::Builder: Couldn't allocate space for events?");
+			return false;
+		}
+
+		if (num_onetime)
+		{
+			memcpy(grown, onetime, num_onetime * sizeof(OneTime));
+		}
+		delete [] onetime;
+		onetime = grown;
+		onetime_capacity = newCapacity;
+	}
+
+	OneTime & entry = onetime[num_onetime++];
+	entry.start = event.start().asEpoch();
+	entry.finish = event.finish().asEpoch();
+	entry.id = event.id();
+	entry.tag = event.tag();
+	return true;
+}
+
+uint32_t CalendarImage::Builder::size() const
+{
+	Header hdr;
+	hdr.num_onetime = num_onetime;
+	hdr.num_recurring = num_recurring;
+	layout(hdr);
+	return hdr.size;
+}
+
+int CalendarImage::Builder::byStart(const void * a, const void * b)
+{
+	const OneTime * lhs = reinterpret_cast<const OneTime *>(a);
+	const OneTime * rhs = reinterpret_cast<const OneTime *>(b);
+	if (lhs->start != rhs->start)
+		return (lhs->start < rhs->start) ? -1 : 1;
+	if (lhs->finish != rhs->finish)
+		return (lhs->finish < rhs->finish) ? -1 : 1;
+
+	return lhs->id - rhs->id;
+}
+
+uint32_t CalendarImage::Builder::write(void * into, uint32_t maxSize)
+{
+	Header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, CALENDARIMAGE_MAGIC, sizeof(hdr.magic));
+	hdr.version = CHRONOS_CALENDAR_IMAGE_VERSION;
+	hdr.byte_order = CALENDARIMAGE_BYTE_ORDER;
+	hdr.num_onetime = num_onetime;
+	hdr.num_recurring = num_recurring;
+	layout(hdr);
+
+	if (NULL == into || (reinterpret_cast<uintptr_t>(into) & 3) || maxSize < hdr.size)
+		return 0;
+
+	if (num_onetime > 1)
+	{
+		qsort(onetime, num_onetime, sizeof(OneTime), byStart);
+	}
+
+	uint8_t * image = reinterpret_cast<uint8_t *>(into);
+	memset(image, 0, hdr.size);
+
+	Chronos::EpochTime * startCol = reinterpret_cast<Chronos::EpochTime *>(image + hdr.starts);
+	Chronos::EpochTime * endCol = reinterpret_cast<Chronos::EpochTime *>(image + hdr.ends);
+	uint32_t * byIdCol = reinterpret_cast<uint32_t *>(image + hdr.by_id);
+	EventID * idCol = reinterpret_cast<EventID *>(image + hdr.ids);
+	EventTag * tagCol = reinterpret_cast<EventTag *>(image + hdr.tags);
+
+	// number of events with each id, by id + 128
+	uint32_t perId[256];
+	memset(perId, 0, sizeof(perId));
+	for (uint32_t i=0; i<num_onetime; i++)
+	{
+		startCol[i] = onetime[i].start;
+		endCol[i] = onetime[i].finish;
+		idCol[i] = onetime[i].id;
+		tagCol[i] = onetime[i].tag;
+		if (onetime[i].finish > onetime[i].start && onetime[i].finish - onetime[i].start > hdr.max_length)
+		{
+			hdr.max_length = onetime[i].finish - onetime[i].start;
+		}
+		perId[onetime[i].id + 128]++;
+	}
+
+	// by_id: a counting sort of the positions by id, which leaves each id's in order of start
+	uint32_t place = 0;
+	for (uint16_t id=0; id<256; id++)
+	{
+		uint32_t count = perId[id];
+		perId[id] = place;
+		place += count;
+	}
+	for (uint32_t i=0; i<num_onetime; i++)
+	{
+		byIdCol[perId[onetime[i].id + 128]++] = i;
+	}
+
+	for (uint8_t r=0; r<num_recurring; r++)
+	{
+		memcpy(image + hdr.recurring + r * sizeof(Record), &(recurring[r]), sizeof(Record));
+	}
+
+	memcpy(image, &hdr, sizeof(hdr));
+	return hdr.size;
+}
+
+#ifdef CHRONOS_PLATFORM_POSIX
+bool CalendarImage::Builder::writeFile(const char * path)
+{
+	uint32_t imageSize = size();
+	// (malloc()ed storage is suitably aligned)
+	void * buffer = malloc(imageSize);
+	if (NULL == buffer)
+		return false;
+
+	bool success = (write(buffer, imageSize) == imageSize);
+	if (success)
+	{
+		FILE * f = fopen(path, "wb");
+		success = (NULL != f) && fwrite(buffer, 1, imageSize, f) == imageSize;
+		if (f && fclose(f) != 0)
+			success = false;
+	}
+
+	free(buffer);
+	return success;
+}
+#endif
+
+} /* namespace Chronos */
@@ -0,0 +1,207 @@
+/*
+ * CallbackExecutor.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/CallbackExecutor.h"
+
+#ifdef CHRONOS_CALLBACK_EXECUTOR
+
+namespace Chronos {
+
+CallbackExecutor::CallbackExecutor(const Callback & cb, unsigned numWorkers) :
+		callback(cb), outstanding(0), queued(0), num_stolen(0), next_worker(0), stopping(false)
+{
+	if (! numWorkers)
+	{
+		numWorkers = std::thread::hardware_concurrency();
+		if (! numWorkers)
+			numWorkers = 1;
+	}
+
+	// all workers must exist before any of them goes looking for work to steal
+	for (unsigned i=0; i<numWorkers; i++)
+		workers.push_back(new Worker());
+
+	for (unsigned i=0; i<numWorkers; i++)
+		workers[i]->thread = std::thread(&CallbackExecutor::work, this, i);
+}
+
+CallbackExecutor::~CallbackExecutor()
+{
+	waitIdle();
+	{
+		std::lock_guard<std::mutex> lock(idle_lock);
+		stopping = true;
+	}
+	work_available.notify_all();
+
+	// (the others may look in any worker's deque until they're done)
+	for (size_t i=0; i<workers.size(); i++)
+		workers[i]->thread.join();
+
+	for (size_t i=0; i<workers.size(); i++)
+		delete workers[i];
+}
+
+void CallbackExecutor::submit(const Event::Occurrence occurrences[], uint16_t num)
+{
+	if (! num)
+		return;
+
+	outstanding.fetch_add(num);
+	unsigned target = next_worker.fetch_add(1);
+	for (uint16_t i=0; i<num; i++)
+	{
+		uint8_t s = strandFor(occurrences[i].id);
+		bool needsScheduling;
+		{
+			std::lock_guard<std::mutex> lock(strands[s].lock);
+			strands[s].pending.push_back(occurrences[i]);
+			needsScheduling = ! strands[s].scheduled;
+			strands[s].scheduled = true;
+		}
+
+		if (needsScheduling)
+		{
+			// spread newly active strands over the workers
+			schedule(s, (target++) % workers.size());
+		}
+	}
+}
+
+void CallbackExecutor::waitIdle()
+{
+	std::unique_lock<std::mutex> lock(idle_lock);
+	all_done.wait(lock, [this] { return outstanding.load() == 0; });
+}
+
+void CallbackExecutor::schedule(uint8_t strand, unsigned workerIdx)
+{
+	// counted before it's visible, so take()s never bring this below 0
+	queued.fetch_add(1);
+	{
+		std::lock_guard<std::mutex> lock(workers[workerIdx]->lock);
+		workers[workerIdx]->strands.push_back(strand);
+	}
+
+	{
+		// (so a worker can't miss this between its check and its wait)
+		std::lock_guard<std::mutex> lock(idle_lock);
+	}
+	work_available.notify_one();
+}
+
+bool CallbackExecutor::take(unsigned workerIdx, uint8_t & strand)
+{
+	{
+		Worker * own = workers[workerIdx];
+		std::lock_guard<std::mutex> lock(own->lock);
+		if (! own->strands.empty())
+		{
+			strand = own->strands.front();
+			own->strands.pop_front();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// nothing of our own: steal from the back of someone else's
+	for (size_t i=1; i<workers.size(); i++)
+	{
+		Worker * victim = workers[(workerIdx + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim->lock);
+		if (! victim->strands.empty())
+		{
+			strand = victim->strands.back();
+			victim->strands.pop_back();
+			queued.fetch_sub(1);
+			num_stolen.fetch_add(1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CallbackExecutor::runStrand(unsigned workerIdx, uint8_t s)
+{
+	Strand & strand = strands[s];
+	uint32_t numRun = 0;
+	for (uint8_t i=0; i<CHRONOS_EXECUTOR_STRAND_BATCH; i++)
+	{
+		Event::Occurrence occ;
+		{
+			std::lock_guard<std::mutex> lock(strand.lock);
+			if (strand.pending.empty())
+				break;
+
+			occ = strand.pending.front();
+			strand.pending.pop_front();
+		}
+
+		callback(occ);
+		numRun++;
+	}
+
+	bool more;
+	{
+		std::lock_guard<std::mutex> lock(strand.lock);
+		more = ! strand.pending.empty();
+		strand.scheduled = more;
+	}
+
+	if (more)
+	{
+		// back of the line, so others get their turn
+		schedule(s, workerIdx);
+	}
+
+	if (outstanding.fetch_sub(numRun) == numRun)
+	{
+		std::lock_guard<std::mutex> lock(idle_lock);
+		all_done.notify_all();
+	}
+}
+
+void CallbackExecutor::work(unsigned workerIdx)
+{
+	for (;;)
+	{
+		uint8_t strand;
+		if (take(workerIdx, strand))
+		{
+			runStrand(workerIdx, strand);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(idle_lock);
+		work_available.wait(lock, [this] { return stopping || queued.load() > 0; });
+		if (stopping && queued.load() == 0)
+			return;
+	}
+}
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CALLBACK_EXECUTOR */
@@ -80,6 +80,16 @@
 #include "chronosinc/marks/marks.h"
 #include "chronosinc/schedule/ScheduledEvent.h"
 #include "chronosinc/schedule/Calendar.h"
+#include "chronosinc/schedule/CalendarColumnar.h"
+#include "chronosinc/schedule/CalendarImage.h"
+#include "chronosinc/schedule/IcsImporter.h"
+#include "chronosinc/schedule/ConcurrentCalendar.h"
+#include "chronosinc/schedule/ShardedCalendar.h"
+#include "chronosinc/schedule/MutationQueue.h"
+#include "chronosinc/schedule/MutationLog.h"
+#include "chronosinc/schedule/CoScheduler.h"
+#include "chronosinc/schedule/CallbackExecutor.h"
+#include "chronosinc/schedule/ScheduleReplay.h"
 #include "chronosinc/test.h"
 
 
@@ -0,0 +1,186 @@
+/*
+ * CoScheduler.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/CoScheduler.h"
+
+#ifdef CHRONOS_COROUTINES
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace Chronos {
+
+bool CoScheduler::TimeAwaiter::await_ready() const
+{
+	// nothing to wait for, or already there
+	return (! is_valid) || at <= DateTime::now().asEpoch();
+}
+
+void CoScheduler::TimeAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+	scheduler.wait(at, handle);
+}
+
+CoScheduler::OccurrenceAwaiter::OccurrenceAwaiter(CoScheduler & sched, const Event::Occurrence & occ, bool atStart) :
+		TimeAwaiter(sched, (atStart ? occ.start : occ.finish).asEpoch(), occ.id != EVENTID_NOTSET),
+		occurrence(occ)
+{
+
+}
+
+CoScheduler::CoScheduler(Calendar & calendar) : cal(calendar), stopping(false)
+{
+	timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+	if (timer_fd >= 0 && epoll_fd >= 0)
+	{
+		struct epoll_event ev = {};
+		ev.events = EPOLLIN;
+		ev.data.fd = timer_fd;
+		epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+	}
+}
+
+CoScheduler::~CoScheduler()
+{
+	if (timer_fd >= 0)
+		close(timer_fd);
+	if (epoll_fd >= 0)
+		close(epoll_fd);
+
+	// coroutines still waiting will never be resumed
+	for (std::multimap<Chronos::EpochTime, std::coroutine_handle<> >::iterator it = waiters.begin();
+			it != waiters.end(); it++)
+	{
+		it->second.destroy();
+	}
+}
+
+CoScheduler::TimeAwaiter CoScheduler::until(const DateTime & dt)
+{
+	return TimeAwaiter(*this, dt.asEpoch(), true);
+}
+
+CoScheduler::TimeAwaiter CoScheduler::untilNext()
+{
+	DateTime next;
+	bool found = cal.nextDateTimeOfInterest(DateTime::now(), next);
+	return TimeAwaiter(*this, found ? next.asEpoch() : 0, found);
+}
+
+CoScheduler::OccurrenceAwaiter CoScheduler::untilStart(EventID evId)
+{
+	Event::Occurrence occ;
+	cal.nextOccurrenceOf(evId, DateTime::now(), occ);
+	return OccurrenceAwaiter(*this, occ, true);
+}
+
+CoScheduler::OccurrenceAwaiter CoScheduler::untilEnd(EventID evId)
+{
+	DateTime now(DateTime::now());
+	Event::Occurrence occ;
+	if (! cal.currentOccurrenceOf(evId, now, occ))
+	{
+		cal.nextOccurrenceOf(evId, now, occ);
+	}
+	return OccurrenceAwaiter(*this, occ, false);
+}
+
+void CoScheduler::wait(Chronos::EpochTime at, std::coroutine_handle<> handle)
+{
+	waiters.insert(std::make_pair(at, handle));
+}
+
+bool CoScheduler::armTimer(Chronos::EpochTime at)
+{
+	Chronos::EpochTime now = DateTime::now().asEpoch();
+	struct itimerspec spec = {};
+	if (at > now + 1)
+	{
+		// we're somewhere within second 'now', this wakes us during the one before 'at'...
+		spec.it_value.tv_sec = at - now - 1;
+	} else {
+		// ... from where we poll, until the clock's seconds get there
+		spec.it_value.tv_nsec = CHRONOS_COSCHEDULER_RETRY_MS * 1000000L;
+	}
+
+	return timerfd_settime(timer_fd, 0, &spec, NULL) == 0;
+}
+
+bool CoScheduler::run()
+{
+	if (timer_fd < 0 || epoll_fd < 0)
+		return false;
+
+	stopping = false;
+	while (! stopping && ! waiters.empty())
+	{
+		// resume everyone whose time has come...
+#ifdef CHRONOS_CLOCK_CACHED
+		CachedClock::refresh();
+#endif
+		Chronos::EpochTime now = DateTime::now().asEpoch();
+		while (! stopping && ! waiters.empty() && waiters.begin()->first <= now)
+		{
+			std::coroutine_handle<> handle = waiters.begin()->second;
+			waiters.erase(waiters.begin());
+			handle.resume(); // may well wait() again
+		}
+
+		if (stopping || waiters.empty())
+			break;
+
+		// ... and sleep until the next in line
+		Chronos::EpochTime next = waiters.begin()->first;
+#ifdef CHRONOS_CLOCK_SIMULATED
+		// (or, in simulated time, just go there)
+		SimulatedClock::set(next);
+		continue;
+#endif
+		if (! armTimer(next))
+			return false;
+
+		struct epoll_event ev;
+		int numReady = epoll_wait(epoll_fd, &ev, 1, -1);
+		if (numReady < 0 && errno != EINTR)
+			return false;
+
+		if (numReady > 0)
+		{
+			uint64_t expirations;
+			if (read(timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_COROUTINES */
@@ -0,0 +1,285 @@
+/*
+ * ColumnScan.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/ColumnScan.h"
+
+#if defined(__GNUC__) && !defined(ARDUINO) && \
+	(defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define CHRONOS_COLUMNSCAN_X86
+#include <immintrin.h>
+#endif
+
+#if defined(CHRONOS_COLUMN_SCAN_KERNELS) && CHRONOS_COLUMN_SCAN_KERNELS != CHRONOS_COLUMN_SCAN_SCALAR \
+	&& ! defined(CHRONOS_COLUMNSCAN_X86)
+#error "CHRONOS_COLUMN_SCAN_KERNELS: the SIMD kernels are only available on x86 hosts"
+#endif
+
+// only build the SIMD kernels that Kernels() below may actually select
+#if defined(CHRONOS_COLUMNSCAN_X86) && (! defined(CHRONOS_COLUMN_SCAN_KERNELS) \
+		|| CHRONOS_COLUMN_SCAN_KERNELS == CHRONOS_COLUMN_SCAN_SSE2)
+#define CHRONOS_COLUMNSCAN_SSE2_KERNELS
+#endif
+#if defined(CHRONOS_COLUMNSCAN_X86) && (! defined(CHRONOS_COLUMN_SCAN_KERNELS) \
+		|| CHRONOS_COLUMN_SCAN_KERNELS == CHRONOS_COLUMN_SCAN_AVX2)
+#define CHRONOS_COLUMNSCAN_AVX2_KERNELS
+#endif
+
+namespace Chronos {
+namespace ColumnScan {
+
+typedef uint16_t (*BetweenKernel)(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[]);
+typedef uint16_t (*SpanningKernel)(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[],
+		uint16_t num, Chronos::EpochTime at, uint16_t matches[]);
+
+
+static uint16_t betweenScalar(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[])
+{
+	uint16_t found = 0;
+	for (uint16_t i=0; i<num; i++)
+	{
+		if (values[i] > low && values[i] < high)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+static uint16_t spanningScalar(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[],
+		uint16_t num, Chronos::EpochTime at, uint16_t matches[])
+{
+	uint16_t found = 0;
+	for (uint16_t i=0; i<num; i++)
+	{
+		if (starts[i] <= at && ends[i] > at)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+#ifdef CHRONOS_COLUMNSCAN_X86
+
+// the SIMD compares are signed: flipping the top bit of both sides
+// maps the unsigned ordering of epochs onto the signed one.
+#define COLUMNSCAN_SIGN_BIAS	((int)0x80000000)
+
+// append base + (index of each bit set in mask)
+static inline uint16_t compactMask(unsigned mask, uint16_t base, uint16_t matches[], uint16_t found)
+{
+	while (mask)
+	{
+		matches[found++] = base + __builtin_ctz(mask);
+		mask &= mask - 1;
+	}
+	return found;
+}
+
+#ifdef CHRONOS_COLUMNSCAN_SSE2_KERNELS
+__attribute__((target("sse2")))
+static uint16_t betweenSSE2(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[])
+{
+	const __m128i bias = _mm_set1_epi32(COLUMNSCAN_SIGN_BIAS);
+	const __m128i lo = _mm_xor_si128(_mm_set1_epi32((int)low), bias);
+	const __m128i hi = _mm_xor_si128(_mm_set1_epi32((int)high), bias);
+
+	uint16_t found = 0;
+	uint16_t i = 0;
+	for ( ; (i + 4) <= num; i += 4)
+	{
+		__m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(values + i)), bias);
+		__m128i hits = _mm_and_si128(_mm_cmpgt_epi32(v, lo), _mm_cmpgt_epi32(hi, v));
+		found = compactMask(_mm_movemask_ps(_mm_castsi128_ps(hits)), i, matches, found);
+	}
+
+	for ( ; i<num; i++)
+	{
+		if (values[i] > low && values[i] < high)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+__attribute__((target("sse2")))
+static uint16_t spanningSSE2(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[],
+		uint16_t num, Chronos::EpochTime at, uint16_t matches[])
+{
+	const __m128i bias = _mm_set1_epi32(COLUMNSCAN_SIGN_BIAS);
+	const __m128i t = _mm_xor_si128(_mm_set1_epi32((int)at), bias);
+
+	uint16_t found = 0;
+	uint16_t i = 0;
+	for ( ; (i + 4) <= num; i += 4)
+	{
+		__m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(starts + i)), bias);
+		__m128i e = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(ends + i)), bias);
+		// !(start > at) && end > at
+		__m128i hits = _mm_andnot_si128(_mm_cmpgt_epi32(s, t), _mm_cmpgt_epi32(e, t));
+		found = compactMask(_mm_movemask_ps(_mm_castsi128_ps(hits)), i, matches, found);
+	}
+
+	for ( ; i<num; i++)
+	{
+		if (starts[i] <= at && ends[i] > at)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+#endif /* CHRONOS_COLUMNSCAN_SSE2_KERNELS */
+
+#ifdef CHRONOS_COLUMNSCAN_AVX2_KERNELS
+__attribute__((target("avx2")))
+static uint16_t betweenAVX2(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[])
+{
+	const __m256i bias = _mm256_set1_epi32(COLUMNSCAN_SIGN_BIAS);
+	const __m256i lo = _mm256_xor_si256(_mm256_set1_epi32((int)low), bias);
+	const __m256i hi = _mm256_xor_si256(_mm256_set1_epi32((int)high), bias);
+
+	uint16_t found = 0;
+	uint16_t i = 0;
+	for ( ; (i + 8) <= num; i += 8)
+	{
+		__m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(values + i)), bias);
+		__m256i hits = _mm256_and_si256(_mm256_cmpgt_epi32(v, lo), _mm256_cmpgt_epi32(hi, v));
+		found = compactMask(_mm256_movemask_ps(_mm256_castsi256_ps(hits)), i, matches, found);
+	}
+
+	for ( ; i<num; i++)
+	{
+		if (values[i] > low && values[i] < high)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+__attribute__((target("avx2")))
+static uint16_t spanningAVX2(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[],
+		uint16_t num, Chronos::EpochTime at, uint16_t matches[])
+{
+	const __m256i bias = _mm256_set1_epi32(COLUMNSCAN_SIGN_BIAS);
+	const __m256i t = _mm256_xor_si256(_mm256_set1_epi32((int)at), bias);
+
+	uint16_t found = 0;
+	uint16_t i = 0;
+	for ( ; (i + 8) <= num; i += 8)
+	{
+		__m256i s = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(starts + i)), bias);
+		__m256i e = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(ends + i)), bias);
+		__m256i hits = _mm256_andnot_si256(_mm256_cmpgt_epi32(s, t), _mm256_cmpgt_epi32(e, t));
+		found = compactMask(_mm256_movemask_ps(_mm256_castsi256_ps(hits)), i, matches, found);
+	}
+
+	for ( ; i<num; i++)
+	{
+		if (starts[i] <= at && ends[i] > at)
+		{
+			matches[found++] = i;
+		}
+	}
+	return found;
+}
+
+#endif /* CHRONOS_COLUMNSCAN_AVX2_KERNELS */
+
+#endif /* CHRONOS_COLUMNSCAN_X86 */
+
+
+/*
+ * The kernel set in use, picked once: kernels() returns a function-local static,
+ * which C++11 constructs exactly once, even if several threads make their first
+ * scans at the same time (and on Arduino, there's only the one thread anyway).
+ */
+class Kernels {
+public:
+	Kernels();
+
+	BetweenKernel between;
+	SpanningKernel spanning;
+	const char * name;
+};
+
+Kernels::Kernels() : between(betweenScalar), spanning(spanningScalar), name("scalar")
+{
+#if defined(CHRONOS_COLUMN_SCAN_KERNELS) && CHRONOS_COLUMN_SCAN_KERNELS == CHRONOS_COLUMN_SCAN_AVX2
+	between = betweenAVX2;
+	spanning = spanningAVX2;
+	name = "avx2";
+#elif defined(CHRONOS_COLUMN_SCAN_KERNELS) && CHRONOS_COLUMN_SCAN_KERNELS == CHRONOS_COLUMN_SCAN_SSE2
+	between = betweenSSE2;
+	spanning = spanningSSE2;
+	name = "sse2";
+#elif defined(CHRONOS_COLUMNSCAN_X86) && ! defined(CHRONOS_COLUMN_SCAN_KERNELS)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		between = betweenAVX2;
+		spanning = spanningAVX2;
+		name = "avx2";
+	} else if (__builtin_cpu_supports("sse2"))
+	{
+		between = betweenSSE2;
+		spanning = spanningSSE2;
+		name = "sse2";
+	}
+#endif
+}
+
+static const Kernels & kernels()
+{
+	static const Kernels selected;
+	return selected;
+}
+
+uint16_t between(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[])
+{
+	return kernels().between(values, num, low, high, matches);
+}
+
+uint16_t spanning(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[], uint16_t num,
+		Chronos::EpochTime at, uint16_t matches[])
+{
+	return kernels().spanning(starts, ends, num, at, matches);
+}
+
+const char * implementation()
+{
+	return kernels().name;
+}
+
+} /* namespace ColumnScan */
+} /* namespace Chronos */
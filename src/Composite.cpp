@@ -0,0 +1,303 @@
+/*
+ * Composite.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/marks/Composite.h"
+#include "chronosinc/Cursor.h"
+
+namespace Chronos {
+namespace Mark {
+
+Composite::Composite(const Event & a, const Event & b) :
+		Event(),
+		num_marks(0),
+		valid(true)
+{
+	hold(a.clone());
+	hold(b.clone());
+}
+
+Composite::Composite(const Event * const markList[], uint8_t num) :
+		Event(),
+		num_marks(0),
+		valid(num <= CHRONOS_MARK_COMPOSITE_MAX)
+{
+	if (! valid)
+		return;
+
+	for (uint8_t i=0; i<num; i++)
+	{
+		hold(markList[i] ? markList[i]->clone() : NULL);
+	}
+}
+
+Composite::Composite(const Composite & other) :
+		Event(),
+		num_marks(0),
+		valid(other.valid)
+{
+	for (uint8_t i=0; i<other.num_marks; i++)
+	{
+		hold(other.marks[i]->retain());
+	}
+}
+
+void Composite::hold(const Event * mark)
+{
+	if (! mark)
+	{
+		valid = false;
+		return;
+	}
+
+	marks[num_marks++] = mark;
+	if (! mark->isValid())
+		valid = false;
+}
+
+Composite::~Composite()
+{
+	for (uint8_t i=0; i<num_marks; i++)
+	{
+		marks[i]->release();
+	}
+}
+
+bool Composite::occursAt(const Event & mark, const DateTime & dt)
+{
+	if (! dt.asEpoch())
+	{
+		// can't search from before the start of time
+		return (mark.previous(dt + 1) == dt);
+	}
+
+	return (mark.next(dt - 1) == dt);
+}
+
+
+/* ****** Union ****** */
+
+Union::Union(const Event & a, const Event & b) : Composite(a, b)
+{
+
+}
+Union::Union(const Event * const markList[], uint8_t num) : Composite(markList, num)
+{
+
+}
+
+bool Union::hasFixedOccurrences() const
+{
+	// (intersections and exclusions may give up on a search, and so
+	// depend on where they started from -- they keep the default)
+	for (uint8_t i=0; i<num_marks; i++)
+	{
+		if (! marks[i]->hasFixedOccurrences())
+			return false;
+	}
+
+	return true;
+}
+
+Event * Union::clone()  const
+{
+	return new Union(*this);
+}
+
+DateTime Union::next(const DateTime & dt) const
+{
+	DateTime earliest(DateTime::endOfTime());
+	for (uint8_t i=0; i<num_marks; i++)
+	{
+		DateTime candidate(marks[i]->next(dt));
+		if (candidate < earliest)
+		{
+			earliest = candidate;
+		}
+	}
+
+	return earliest;
+}
+
+DateTime Union::previous(const DateTime & dt) const
+{
+	DateTime latest((Chronos::EpochTime)0);
+	for (uint8_t i=0; i<num_marks; i++)
+	{
+		DateTime candidate(marks[i]->previous(dt));
+		if (candidate > latest)
+		{
+			latest = candidate;
+		}
+	}
+
+	return latest;
+}
+
+
+/* ****** Intersect ****** */
+
+Intersect::Intersect(const Event & a, const Event & b) : Composite(a, b)
+{
+
+}
+
+Intersect::Intersect(const Event * const markList[], uint8_t num) : Composite(markList, num)
+{
+
+}
+
+Event * Intersect::clone()  const
+{
+	return new Intersect(*this);
+}
+
+DateTime Intersect::next(const DateTime & dt) const
+{
+	if (! num_marks)
+		return DateTime::endOfTime();
+
+	DateTime endOfTime(DateTime::endOfTime());
+	DateTime candidate(marks[0]->next(dt));
+
+	for (uint16_t leaps=0; leaps<CHRONOS_MARK_COMPOSITE_MAX_LEAPS; leaps++)
+	{
+		if (candidate >= endOfTime)
+			break;
+
+		// ask each mark for its first occurrence at or after the candidate:
+		// if any lands later, that's the earliest the intersection could be
+		// so we leap there and go around again.
+		bool allAgree = true;
+		for (uint8_t i=0; i<num_marks; i++)
+		{
+			DateTime atOrAfter(marks[i]->next(candidate - 1));
+			if (atOrAfter > candidate)
+			{
+				candidate = atOrAfter;
+				allAgree = false;
+			} else if (atOrAfter < candidate)
+			{
+				// (wrapped past the end of time: there's none left)
+				return endOfTime;
+			}
+		}
+
+		if (allAgree)
+			return candidate;
+	}
+
+	return endOfTime;
+}
+
+DateTime Intersect::previous(const DateTime & dt) const
+{
+	DateTime startOfTime((Chronos::EpochTime)0);
+	if (! num_marks)
+		return startOfTime;
+
+	DateTime candidate(marks[0]->previous(dt));
+
+	for (uint16_t leaps=0; leaps<CHRONOS_MARK_COMPOSITE_MAX_LEAPS; leaps++)
+	{
+		if (candidate <= startOfTime)
+			break;
+
+		// same as next(), backwards
+		bool allAgree = true;
+		for (uint8_t i=0; i<num_marks; i++)
+		{
+			DateTime atOrBefore(marks[i]->previous(candidate + 1));
+			if (atOrBefore < candidate)
+			{
+				candidate = atOrBefore;
+				allAgree = false;
+			} else if (atOrBefore > candidate)
+			{
+				return startOfTime;
+			}
+		}
+
+		if (allAgree)
+			return candidate;
+	}
+
+	return startOfTime;
+}
+
+
+/* ****** Except ****** */
+
+Except::Except(const Event & base, const Event & excluded) : Composite(base, excluded)
+{
+
+}
+
+Event * Except::clone()  const
+{
+	return new Except(*this);
+}
+
+DateTime Except::next(const DateTime & dt) const
+{
+	if (! valid)
+		return DateTime::endOfTime();
+
+	// step along the base mark, only skipping the
+	// occurrences the exclusion lands on
+	Cursor baseCursor(marks[0]->cursor(dt));
+	DateTime candidate(baseCursor.advance());
+
+	for (uint16_t leaps=0; leaps<CHRONOS_MARK_COMPOSITE_MAX_LEAPS; leaps++)
+	{
+		if (! occursAt(*(marks[1]), candidate))
+			return candidate;
+
+		candidate = baseCursor.advance();
+	}
+
+	return DateTime::endOfTime();
+}
+
+DateTime Except::previous(const DateTime & dt) const
+{
+	if (! valid)
+		return DateTime((Chronos::EpochTime)0);
+
+	Cursor baseCursor(marks[0]->reverseCursor(dt));
+	DateTime candidate(baseCursor.advance());
+
+	for (uint16_t leaps=0; leaps<CHRONOS_MARK_COMPOSITE_MAX_LEAPS; leaps++)
+	{
+		if (! occursAt(*(marks[1]), candidate))
+			return candidate;
+
+		candidate = baseCursor.advance();
+	}
+
+	return DateTime((Chronos::EpochTime)0);
+}
+
+} /* namespace Mark */
+} /* namespace Chronos */
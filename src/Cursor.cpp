@@ -0,0 +1,69 @@
+/*
+ * Cursor.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/Cursor.h"
+
+namespace Chronos {
+namespace Mark {
+
+Cursor::Cursor(const Event & m, const DateTime & dt, bool fwd) :
+		mark(&m),
+		position(dt),
+		forward(fwd),
+		started(false)
+{
+
+}
+
+Cursor::Cursor() :
+		mark(NULL),
+		position(DateTime::endOfTime()),
+		forward(true),
+		started(false)
+{
+
+}
+
+DateTime Cursor::advance()
+{
+	if (! mark)
+		return position;
+
+	if (! started)
+	{
+		// first call: we don't know where we stand relative to the
+		// mark, so we need a real search
+		started = true;
+		position = forward ? mark->next(position) : mark->previous(position);
+		return position;
+	}
+
+	// we are sitting on an occurrence, let the mark step from there
+	position = mark->step(position, forward ? Event::Next : Event::Previous);
+	return position;
+}
+
+} /* namespace Mark */
+} /* namespace Chronos */
@@ -42,6 +42,19 @@ Event * Daily::clone()  const
 	return new Daily(hour, minute, sec);
 
 }
+Event * Daily::cloneInto(void * storage)  const
+{
+	return new (storage) Daily(hour, minute, sec);
+}
+bool Daily::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.hour = hour;
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
 DateTime Daily::applyTo(const DateTime & dt) const
 {
 
@@ -81,5 +94,13 @@ DateTime Daily::previous(const DateTime & dt)  const {
 	return thePrev;
 }
 
+DateTime Daily::step(const DateTime & occurrence, Direction dir) const {
+	// occurrences are exactly a day apart
+	if (dir == Next)
+		return occurrence + SECS_PER_DAY;
+
+	return occurrence - SECS_PER_DAY;
+}
+
 } /* namespace Event */
 } /* namespace Chronos */
@@ -28,6 +28,8 @@
 #include "chronosinc/DateTime.h"
 
 #include "chronosinc/marks/marks.h"
+#include "chronosinc/Format.h"
+#include <string.h>
 
 #define DATETIME_TIMELEMENTS_LAZY_INIT
 
@@ -36,6 +38,10 @@
 
 #define DATETIME_TIMELEMENTS_UNINIT() 	_elements.Year = 0; _elements.Month = 0
 
+// elements -> epoch conversions ignore (and don't set) the weekday: it's derived
+// from the epoch, jan 1st 1970 being a thursday
+#define DATETIME_TIMELEMENTS_SET_WEEKDAY()	_elements.Wday = (((epoch / SECS_PER_DAY) + 4) % 7) + 1
+
 #ifdef DATETIME_TIMELEMENTS_LAZY_INIT
 #define DATETIME_INTERNAL_EPOCH_MODIFIED()	DATETIME_TIMELEMENTS_UNINIT()
 #else
@@ -45,7 +51,14 @@
 namespace Chronos {
 void DateTime::setTime(Year year, Month month, Day day, Hours hours, Minutes minutes, Seconds secs)
 {
-	DATETIME_SET_CURRENT_TIME(year, month, day, hours, minutes, seconds)
+#ifdef CHRONOS_CLOCK_SIMULATED
+	SimulatedClock::set(DateTime(year, month, day, hours, minutes, secs).asEpoch());
+#else
+	DATETIME_SET_CURRENT_TIME(year, month, day, hours, minutes, secs)
+#ifdef CHRONOS_CLOCK_CACHED
+	CachedClock::refresh();
+#endif
+#endif
 }
 
 
@@ -218,7 +231,7 @@ DateTime::DateTime(Year y, Month mo, Day d, Hours h, Minutes min, Seconds s)
 	_elements.Second = (s <= 59) ? s : 59;
 
 	epoch = DATETIME_CONVERT_TIMELEMENTS_TO_EPOCH(_elements);
-
+	DATETIME_TIMELEMENTS_SET_WEEKDAY();
 
 }
 
@@ -235,6 +248,7 @@ DateTime::DateTime() : epoch(DATETIME_GET_CURRENT_EPOCH()) {
 }
 DateTime::DateTime(const Chronos::TimeElements& atTime) : _elements(atTime) {
 	epoch = DATETIME_CONVERT_TIMELEMENTS_TO_EPOCH(_elements);
+	DATETIME_TIMELEMENTS_SET_WEEKDAY();
 }
 
 bool DateTime::isWithin(const DateTime::Bounds & bounds) const
@@ -342,6 +356,7 @@ void DateTime::reInitEpoch()
 {
 
 	epoch = DATETIME_CONVERT_TIMELEMENTS_TO_EPOCH(getElements());
+	DATETIME_TIMELEMENTS_SET_WEEKDAY();
 
 }
 void DateTime::setSecond(Seconds s) {
@@ -393,37 +408,124 @@ void DateTime::setYear(Year y) {
 	reInitEpoch();
 }
 
-void DateTime::printTo(Print & p, bool includeTime) const
+// a single %-directive, for formatTo()
+static void formatDateTimeField(const DateTime & dt, Format::Writer & w, char directive, bool pad)
 {
+	uint8_t two = pad ? 2 : 1;
+	switch (directive)
+	{
+	case 'Y':
+		w.putNumber(dt.year(), pad ? 4 : 1);
+		break;
+	case 'y':
+		w.putNumber(dt.year() % 100, two);
+		break;
+	case 'm':
+		w.putNumber(dt.month(), two);
+		break;
+	case 'd':
+		w.putNumber(dt.day(), two);
+		break;
+	case 'e':
+		w.putNumber(dt.day(), two, ' ');
+		break;
+	case 'H':
+		w.putNumber(dt.hour(), two);
+		break;
+	case 'I':
+		w.putNumber((dt.hour() % 12) ? (dt.hour() % 12) : 12, two);
+		break;
+	case 'M':
+		w.putNumber(dt.minute(), two);
+		break;
+	case 'S':
+		w.putNumber(dt.second(), two);
+		break;
+	case 'p':
+		w.put(dt.hour() < 12 ? "AM" : "PM", 2);
+		break;
+	case 'b':
+		w.put(Format::monthShortName(dt.month()), 3);
+		break;
+	case 'a':
+		w.put(Format::dayShortName(dt.weekday()), 3);
+		break;
+	case 's':
+		w.putNumber(dt.asEpoch());
+		break;
+	case 'F':
+		formatDateTimeField(dt, w, 'Y', pad);
+		w.put('-');
+		formatDateTimeField(dt, w, 'm', true);
+		w.put('-');
+		formatDateTimeField(dt, w, 'd', true);
+		break;
+	case 'T':
+	case 'R':
+		formatDateTimeField(dt, w, 'H', pad);
+		w.put(':');
+		formatDateTimeField(dt, w, 'M', true);
+		if (directive == 'T')
+		{
+			w.put(':');
+			formatDateTimeField(dt, w, 'S', true);
+		}
+		break;
+	case '%':
+		w.put('%');
+		break;
+	default:
+		// not ours, leave it be
+		w.put('%');
+		if (! pad)
+			w.put('-');
+		w.put(directive);
+		break;
+	}
+}
 
-	p.print(monthShortStr(month()));
-	p.print(" ");
-	p.print((int)getElements().Day);
-	p.print(", ");
-	p.print(year());
+size_t DateTime::formatTo(char * buf, size_t len, const char * pattern) const
+{
+	Format::Writer w(buf, len);
 
-	if (includeTime)
+	while (*pattern)
 	{
-		p.print(" @ ");
-		p.print((int)getElements().Hour);
-		p.print(':');
-		if (getElements().Minute < 10)
+		const char * pct = strchr(pattern, '%');
+		if (! pct)
 		{
-			p.print(0L);
+			w.put(pattern, strlen(pattern));
+			break;
 		}
-		p.print((int)getElements().Minute);
 
-		p.print(':');
+		w.put(pattern, pct - pattern);
+		pattern = pct + 1;
 
-		if (getElements().Second < 10)
+		bool pad = true;
+		if (*pattern == '-')
 		{
-			p.print(0L);
+			pad = false;
+			pattern++;
 		}
-		p.print((int)getElements().Second);
 
+		if (! *pattern)
+		{
+			// dangling '%' at the end
+			w.put('%');
+			break;
+		}
+
+		formatDateTimeField(*this, w, *pattern++, pad);
 	}
 
+	return w.finish();
+}
 
+void DateTime::printTo(Print & p, bool includeTime) const
+{
+	// formatted in one go, rather than as a dozen little print()s
+	char buf[32];
+	formatTo(buf, sizeof(buf), includeTime ? "%b %-d, %Y @ %-H:%M:%S" : "%b %-d, %Y");
+	p.print(buf);
 }
 
 void DateTime::setToStartOfDay() {
@@ -1,4 +1,6 @@
 #include "chronosinc/Delta.h"
+#include "chronosinc/Format.h"
+#include <string.h>
 
 /*
  * Delta.cpp
@@ -132,26 +134,106 @@ void Delta::initElements() const {
 }
 
 
-void Delta::printTo(Print & p) const
+// a single %-directive, for formatTo()
+static void formatDeltaField(const Delta::Elements & els, Chronos::EpochTime total, Format::Writer & w, char directive, bool pad)
+{
+	uint8_t two = pad ? 2 : 1;
+	switch (directive)
+	{
+	case 'd':
+		w.putNumber(els.days);
+		break;
+	case 'H':
+		w.putNumber(els.hours, two);
+		break;
+	case 'M':
+		w.putNumber(els.minutes, two);
+		break;
+	case 'S':
+		w.putNumber(els.seconds, two);
+		break;
+	case 's':
+		w.putNumber(total);
+		break;
+	case 'T':
+		w.putNumber(els.hours, two);
+		w.put(':');
+		w.putNumber(els.minutes, 2);
+		w.put(':');
+		w.putNumber(els.seconds, 2);
+		break;
+	case '%':
+		w.put('%');
+		break;
+	default:
+		w.put('%');
+		if (! pad)
+			w.put('-');
+		w.put(directive);
+		break;
+	}
+}
+
+size_t Delta::formatTo(char * buf, size_t len, const char * pattern) const
 {
 	initElements();
+	Format::Writer w(buf, len);
+
+	while (*pattern)
+	{
+		const char * pct = strchr(pattern, '%');
+		if (! pct)
+		{
+			w.put(pattern, strlen(pattern));
+			break;
+		}
+
+		w.put(pattern, pct - pattern);
+		pattern = pct + 1;
+
+		bool pad = true;
+		if (*pattern == '-')
+		{
+			pad = false;
+			pattern++;
+		}
+
+		if (! *pattern)
+		{
+			w.put('%');
+			break;
+		}
+
+		formatDeltaField(delta_elements, total_seconds, w, *pattern++, pad);
+	}
+
+	return w.finish();
+}
+
+void Delta::printTo(Print & p) const
+{
+	// formatted in one go, rather than as a dozen little print()s
+	char buf[64];
+	Format::Writer w(buf, sizeof(buf));
 
+	initElements();
 	if (delta_elements.days) {
-		p.print(delta_elements.days);
-		p.print(" days, ");
+		w.putNumber(delta_elements.days);
+		w.put(" days, ", 7);
 	}
 
 	if (delta_elements.hours) {
-		p.print(delta_elements.hours);
-		p.print(" hours, ");
+		w.putNumber(delta_elements.hours);
+		w.put(" hours, ", 8);
 	}
 
-	p.print(delta_elements.minutes);
-	p.print(" minutes and ");
-	p.print(delta_elements.seconds);
-	p.print(" seconds");
-
+	w.putNumber(delta_elements.minutes);
+	w.put(" minutes and ", 13);
+	w.putNumber(delta_elements.seconds);
+	w.put(" seconds", 8);
 
+	w.finish();
+	p.print(buf);
 }
 
 
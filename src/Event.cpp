@@ -25,31 +25,163 @@
 
 #include "chronosinc/Event.h"
 #include "chronosinc/DateTime.h"
+#include "chronosinc/Cursor.h"
+#include "chronosinc/marks/Allocator.h"
+#include "chronosinc/marks/marks.h"
 #include "chronosinc/platform/platform.h"
 namespace Chronos {
 
 
 namespace Mark {
 
+// (marks are cloned and released from any thread, on hosts)
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+static std::atomic<Allocator *> mark_allocator(NULL);
+#else
+static Allocator * mark_allocator = NULL;
+#endif
 
+void Event::setAllocator(Allocator * alloc)
+{
+	mark_allocator = alloc;
+}
+
+Allocator * Event::allocator()
+{
+	return mark_allocator;
+}
 
-Event::Event() {
+void * Event::operator new(size_t size)
+{
+	Allocator * alloc = mark_allocator;
+	if (alloc)
+	{
+		void * storage = alloc->allocate(size);
+		if (storage)
+			return storage;
+	}
+
+	return ::operator new(size);
+}
+
+void Event::operator delete(void * ptr, size_t size)
+{
+	if (! ptr)
+		return;
+
+	Allocator * alloc = mark_allocator;
+	if (alloc && alloc->owns(ptr))
+	{
+		alloc->deallocate(ptr, size);
+		return;
+	}
+
+	::operator delete(ptr);
+}
+
+Event::Event() : ref_count(1) {
 
 }
 Event::~Event()
 {
 }
 
+Event * Event::restoreInto(const Params & params, void * storage)
+{
+	switch (params.kind)
+	{
+	case HourlyKind:
+		return new (storage) Hourly(params.minute, params.second);
+	case DailyKind:
+		return new (storage) Daily(params.hour, params.minute, params.second);
+	case WeeklyKind:
+		if (params.strict_time)
+			return new (storage) Weekly((WeekDay)params.day, params.hour, params.minute, params.second);
+		return new (storage) Weekly((WeekDay)params.day);
+	case MonthlyKind:
+		if (params.strict_time)
+			return new (storage) Monthly(params.day, params.hour, params.minute, params.second);
+		return new (storage) Monthly(params.day);
+	case YearlyKind:
+		if (params.strict_time)
+			return new (storage) Yearly(params.month, params.day, params.hour, params.minute, params.second);
+		return new (storage) Yearly(params.month, params.day);
+	case EveryKind:
+		// anchored at its phase, which is already within the period
+		return new (storage) Every(DateTime(params.phase), Chronos::Span::Delta(params.period));
+	case MonthlyNthWeekdayKind:
+		return new (storage) MonthlyNthWeekday(params.nth, (Chronos::Weekday::Day)params.day,
+				params.hour, params.minute, params.second);
+	default:
+		break;
+	}
+
+	return NULL;
+}
+
+
+
+
+const Event * Event::retain() const
+{
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+	uint16_t count = ref_count.load(std::memory_order_relaxed);
+	do {
+		if (count == CHRONOS_MARK_MAX_REFERENCES)
+		{
+			// can't take another: the caller gets its own copy
+			return clone();
+		}
+	} while (! ref_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+#else
+	if (ref_count == CHRONOS_MARK_MAX_REFERENCES)
+	{
+		return clone();
+	}
+	ref_count++;
+#endif
+	return this;
+}
+
+void Event::release() const
+{
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+	// (acquire/release, so the last holder sees everyone else is done with it)
+	if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+#else
+	if (! --ref_count)
+#endif
+	{
+		delete this;
+	}
+}
+
+Cursor Event::cursor(const DateTime & dt) const
+{
+	return Cursor(*this, dt, true);
+}
 
+Cursor Event::reverseCursor(const DateTime & dt) const
+{
+	return Cursor(*this, dt, false);
+}
 
+DateTime Event::step(const DateTime & occurrence, Direction dir) const
+{
+	if (dir == Next)
+	{
+		return this->next(occurrence + 1);
+	}
+
+	return this->previous(occurrence - 1);
+}
 
 void Event::listNext(uint8_t number, DateTime into[], const DateTime & dt) const
 {
-	DateTime curDt = dt;
+	Cursor curs(*this, dt, true);
 	for (uint8_t i=0; i<number; i++)
 	{
-		into[i] = this->next(curDt);
-		curDt = into[i] + 1;
+		into[i] = curs.advance();
 	}
 }
 
@@ -57,11 +189,10 @@ void Event::listNext(uint8_t number, DateTime into[], const DateTime & dt) const
 void Event::listPrevious(uint8_t number, DateTime into[], const DateTime & dt) const
 {
 
-	DateTime curDt = dt;
+	Cursor curs(*this, dt, false);
 	for (uint8_t i=0; i<number; i++)
 	{
-		into[i] = this->previous(curDt);
-		curDt = into[i] - 1;
+		into[i] = curs.advance();
 	}
 }
 
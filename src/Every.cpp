@@ -0,0 +1,161 @@
+/*
+ * Every.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/marks/Every.h"
+
+// DateTime::endOfTime(), as an epoch: occurrences past it come out as endOfTime()
+#define EVERY_END_OF_TIME		4294967280UL
+
+namespace Chronos {
+namespace Mark {
+
+Every::Every(const Chronos::Span::Delta & p) :
+		Event(),
+		phase(0),
+		period(p.totalSeconds())
+{
+	if (! period)
+	{
+		period = 1;
+	}
+}
+
+Every::Every(const DateTime & anchor, const Chronos::Span::Delta & p) :
+		Event(),
+		phase(0),
+		period(p.totalSeconds())
+{
+	if (! period)
+	{
+		period = 1;
+	}
+	phase = anchor.asEpoch() % period;
+}
+
+Every::Every(Chronos::EpochTime phaseSecs, Chronos::EpochTime periodSecs) :
+		Event(),
+		phase(phaseSecs),
+		period(periodSecs)
+{
+
+}
+
+Event * Every::clone()  const
+{
+	return new Every(phase, period);
+}
+
+Event * Every::cloneInto(void * storage)  const
+{
+	return new (storage) Every(phase, period);
+}
+bool Every::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.phase = phase;
+	into.period = period;
+	return true;
+}
+
+DateTime Every::atIndex(Chronos::EpochTime index) const {
+
+	// (computed the other way around, so nothing overflows)
+	if (phase > EVERY_END_OF_TIME || index > (EVERY_END_OF_TIME - phase) / period)
+		return DateTime::endOfTime();
+
+	return DateTime(phase + index * period);
+}
+
+DateTime Every::next(const DateTime & dt) const {
+
+	Chronos::EpochTime epoch = dt.asEpoch();
+	if (epoch < phase)
+		return atIndex(0);
+
+	if (epoch >= EVERY_END_OF_TIME)
+		return DateTime::endOfTime();
+
+	return atIndex(indexAtOrBefore(epoch) + 1);
+}
+
+DateTime Every::previous(const DateTime & dt)  const {
+
+	Chronos::EpochTime epoch = dt.asEpoch();
+	if (epoch <= phase)
+	{
+		// nothing before, as far as the epoch goes
+		return DateTime((Chronos::EpochTime)0);
+	}
+
+	return DateTime(phase + indexAtOrBefore(epoch - 1) * period);
+}
+
+DateTime Every::step(const DateTime & occurrence, Direction dir) const {
+	Chronos::EpochTime epoch = occurrence.asEpoch();
+	if (dir == Next)
+	{
+		if (epoch >= EVERY_END_OF_TIME || period > EVERY_END_OF_TIME - epoch)
+			return DateTime::endOfTime();
+
+		return DateTime(epoch + period);
+	}
+
+	if (epoch < period)
+		return DateTime((Chronos::EpochTime)0);
+
+	return DateTime(epoch - period);
+}
+
+uint32_t Every::count(const DateTime & from, const DateTime & until) const
+{
+	if (until <= from || until.asEpoch() < phase)
+		return 0;
+
+	uint32_t upToUntil = indexAtOrBefore(until.asEpoch()) + 1;
+	if (from.asEpoch() < phase)
+		return upToUntil;
+
+	return upToUntil - (indexAtOrBefore(from.asEpoch()) + 1);
+}
+
+DateTime Every::nth(uint32_t n, const DateTime & dt) const
+{
+	if (! n)
+		return dt;
+
+	Chronos::EpochTime epoch = dt.asEpoch();
+	if (epoch >= EVERY_END_OF_TIME)
+		return DateTime::endOfTime();
+
+	Chronos::EpochTime first = (epoch < phase) ? 0 : indexAtOrBefore(epoch) + 1;
+	if (n - 1 > EVERY_END_OF_TIME - first)
+		return DateTime::endOfTime();
+
+	return atIndex(first + (n - 1));
+}
+
+} /* namespace Mark */
+} /* namespace Chronos */
@@ -0,0 +1,125 @@
+/*
+ * Format.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "chronosinc/Format.h"
+
+namespace Chronos {
+
+namespace Format {
+
+// "Err" for out of range, then 3 letters (and a NUL) each, in place: no
+// per-name pointers to keep around
+static const char month_names[][4] = { "Err", "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+		"Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+static const char day_names[][4] = { "Err", "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+
+#ifndef __AVR__
+// all pairs of digits "00".."99", so numbers come out two digits per division
+static const char digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+#endif
+
+const char * monthShortName(uint8_t month)
+{
+	return month_names[(month <= 12) ? month : 0];
+}
+
+const char * dayShortName(uint8_t weekday)
+{
+	return day_names[(weekday <= 7) ? weekday : 0];
+}
+
+void Writer::put(const char * str, size_t n)
+{
+	if (n > room - pos)
+		n = room - pos;
+
+	// (buf may be NULL, when there's no room at all)
+	if (! n)
+		return;
+
+	memcpy(out + pos, str, n);
+	pos += n;
+}
+
+void Writer::putNumber(uint32_t value, uint8_t minWidth, char pad)
+{
+	char digits[10];
+	uint8_t start = sizeof(digits);
+
+	// filled in from the end
+#ifndef __AVR__
+	while (value >= 100)
+	{
+		uint8_t pair = (value % 100) * 2;
+		value /= 100;
+		digits[--start] = digit_pairs[pair + 1];
+		digits[--start] = digit_pairs[pair];
+	}
+	if (value >= 10)
+	{
+		digits[--start] = digit_pairs[value * 2 + 1];
+		digits[--start] = digit_pairs[value * 2];
+	} else {
+		digits[--start] = '0' + value;
+	}
+#else
+	// (spare the RAM on small AVRs)
+	do {
+		digits[--start] = '0' + (value % 10);
+		value /= 10;
+	} while (value);
+#endif
+
+	if (minWidth > sizeof(digits))
+		minWidth = sizeof(digits);
+
+	while (start > sizeof(digits) - minWidth)
+		digits[--start] = pad;
+
+	put(digits + start, sizeof(digits) - start);
+}
+
+size_t Writer::finish()
+{
+	if (room)
+		out[pos] = '\0';
+
+	return pos;
+}
+
+} /* namespace Format */
+
+} /* namespace Chronos */
@@ -42,6 +42,18 @@ Event * Hourly::clone()  const
 	return new Hourly(minute, sec);
 
 }
+Event * Hourly::cloneInto(void * storage)  const
+{
+	return new (storage) Hourly(minute, sec);
+}
+bool Hourly::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
 DateTime Hourly::applyTo(const DateTime & dt) const
 {
 
@@ -80,5 +92,13 @@ DateTime Hourly::previous(const DateTime & dt)  const {
 	return thePrev;
 }
 
+DateTime Hourly::step(const DateTime & occurrence, Direction dir) const {
+	// occurrences are exactly an hour apart
+	if (dir == Next)
+		return occurrence + SECS_PER_HOUR;
+
+	return occurrence - SECS_PER_HOUR;
+}
+
 } /* namespace Event */
 } /* namespace Chronos */
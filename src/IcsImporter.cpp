@@ -0,0 +1,795 @@
+/*
+ * IcsImporter.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/IcsImporter.h"
+#include "chronosinc/marks/marks.h"
+
+#include <string.h>
+
+#define ICS_IS_DIGIT(c)		((c) >= '0' && (c) <= '9')
+#define ICS_UPPER(c)		(((c) >= 'a' && (c) <= 'z') ? ((c) - 'a' + 'A') : (c))
+
+namespace Chronos {
+
+// case-insensitive match of str (len chars) against an upper case literal
+static bool matches(const char * str, uint16_t len, const char * literal)
+{
+	uint16_t i=0;
+	for ( ; i<len && literal[i]; i++)
+	{
+		if (ICS_UPPER(str[i]) != literal[i])
+			return false;
+	}
+
+	return i == len && ! literal[i];
+}
+
+// reads the digits at p, up to end, moving p past them
+static bool readNumber(const char * & p, const char * end, uint32_t & into)
+{
+	if (p >= end || ! ICS_IS_DIGIT(*p))
+		return false;
+
+	into = 0;
+	while (p < end && ICS_IS_DIGIT(*p))
+	{
+		if (into > 100000000UL)
+			return false;
+		into = (into * 10) + (*p++ - '0');
+	}
+
+	return true;
+}
+
+// fixed width run of digits
+static bool readDigits(const char * p, uint8_t num, uint16_t & into)
+{
+	into = 0;
+	for (uint8_t i=0; i<num; i++)
+	{
+		if (! ICS_IS_DIGIT(p[i]))
+			return false;
+		into = (into * 10) + (p[i] - '0');
+	}
+
+	return true;
+}
+
+// whether the ;NAME=VALUE... parameters at params include one named literal
+static bool hasParam(const char * params, uint16_t len, const char * literal)
+{
+	uint16_t i = 0;
+	while (i < len)
+	{
+		// past the ';', the name runs to the '='
+		uint16_t nameStart = ++i;
+		while (i < len && params[i] != '=')
+		{
+			i++;
+		}
+
+		if (matches(&(params[nameStart]), i - nameStart, literal))
+			return true;
+
+		// values may be quoted, semicolons and all
+		bool quoted = false;
+		while (i < len && (quoted || params[i] != ';'))
+		{
+			if (params[i] == '"')
+				quoted = ! quoted;
+			i++;
+		}
+	}
+
+	return false;
+}
+
+// SU, MO... to a Weekday::Day, or 0
+static uint8_t dayNamed(const char * p)
+{
+	static const char names[] = "SUMOTUWETHFRSA";
+	for (uint8_t d=0; d<7; d++)
+	{
+		if (ICS_UPPER(p[0]) == names[2*d] && ICS_UPPER(p[1]) == names[2*d + 1])
+			return d + Chronos::Weekday::Sunday;
+	}
+
+	return 0;
+}
+
+void IcsImporter::Pending::reset()
+{
+	start = end = length = until = 0;
+	interval = 1;
+	count = 0;
+	has_start = has_end = has_length = has_until = false;
+	all_day = invalid = cancelled = false;
+	freq = NoFreq;
+	by_day = 0;
+	nth = 0;
+	by_month_day = 0;
+	by_month = 0;
+	uid[0] = '\0';
+	summary[0] = '\0';
+}
+
+IcsImporter::IcsImporter(Calendar & calendar, EventID id, Listener * evListener) :
+		cal(calendar),
+		listener(evListener),
+		default_id(id),
+		utc_offset(0),
+		has_utc_offset(false),
+		line_len(0),
+		line_overflow(false),
+		line_complete(false),
+		in_event(false),
+		nested(0),
+		finished(false),
+		num_added(0),
+		num_skipped(0)
+{
+	cal.beginUpdate();
+}
+
+IcsImporter::~IcsImporter()
+{
+	finish();
+}
+
+void IcsImporter::setUtcOffset(int32_t seconds)
+{
+	utc_offset = seconds;
+	has_utc_offset = true;
+}
+
+void IcsImporter::feed(const char * data, uint32_t len)
+{
+	if (finished)
+	{
+		// more, after all
+		cal.beginUpdate();
+		finished = false;
+	}
+
+	while (len)
+	{
+		if (line_complete)
+		{
+			line_complete = false;
+			if (*data == ' ' || *data == '\t')
+			{
+				// folded: the line goes on, minus this whitespace
+				data++;
+				len--;
+				continue;
+			}
+
+			processLine();
+		}
+
+		const char * eol = reinterpret_cast<const char *>(memchr(data, '\n', len));
+		uint32_t segment = eol ? (eol - data) : len;
+		append(data, segment);
+		if (! eol)
+			return;
+
+		// lines end with CRLF, though bare LFs are common enough
+		if (line_len && line[line_len - 1] == '\r')
+		{
+			line_len--;
+		}
+		line_complete = true;
+		data = eol + 1;
+		len -= segment + 1;
+	}
+}
+
+uint32_t IcsImporter::finish()
+{
+	if (finished)
+		return num_added;
+
+	if (line_complete || line_len)
+	{
+		processLine();
+		line_complete = false;
+	}
+
+	if (in_event)
+	{
+		// truncated input
+		in_event = false;
+		num_skipped++;
+	}
+
+	finished = true;
+	cal.endUpdate();
+	return num_added;
+}
+
+void IcsImporter::append(const char * data, uint32_t len)
+{
+	// (one spot kept for the nul)
+	uint32_t room = (CHRONOS_ICS_LINE_MAX - 1) - line_len;
+	if (len > room)
+	{
+		len = room;
+		line_overflow = true;
+	}
+
+	memcpy(&(line[line_len]), data, len);
+	line_len += len;
+}
+
+void IcsImporter::processLine()
+{
+	uint16_t len = line_len;
+	bool overflowed = line_overflow;
+	line_len = 0;
+	line_overflow = false;
+	if (overflowed || ! len)
+		return;
+
+	line[len] = '\0';
+
+	// NAME *(;PARAM=VALUE) :VALUE -- parameter values may be quoted, colons and all
+	uint16_t nameLen = 0;
+	while (nameLen < len && line[nameLen] != ';' && line[nameLen] != ':')
+	{
+		nameLen++;
+	}
+
+	uint16_t colon = nameLen;
+	bool quoted = false;
+	while (colon < len && (quoted || line[colon] != ':'))
+	{
+		if (line[colon] == '"')
+			quoted = ! quoted;
+		colon++;
+	}
+
+	if (colon >= len)
+		return;
+
+	property(line, nameLen, &(line[nameLen]), colon - nameLen, &(line[colon + 1]), len - colon - 1);
+}
+
+void IcsImporter::property(const char * name, uint16_t nameLen, const char * params, uint16_t paramsLen,
+		const char * value, uint16_t valueLen)
+{
+	if (matches(name, nameLen, "BEGIN"))
+	{
+		if (in_event)
+		{
+			nested++;
+		} else if (matches(value, valueLen, "VEVENT"))
+		{
+			in_event = true;
+			nested = 0;
+			pending.reset();
+		}
+		return;
+	}
+
+	if (matches(name, nameLen, "END"))
+	{
+		if (! in_event)
+			return;
+
+		if (nested)
+		{
+			nested--;
+		} else if (matches(value, valueLen, "VEVENT"))
+		{
+			endEvent();
+		}
+		return;
+	}
+
+	if (! in_event || nested)
+		return;
+
+	if (matches(name, nameLen, "DTSTART"))
+	{
+		pending.has_start = readDateTime(value, valueLen, pending.start, pending.all_day);
+		pending.invalid |= ! pending.has_start || hasParam(params, paramsLen, "TZID");
+	} else if (matches(name, nameLen, "DTEND"))
+	{
+		bool isDate;
+		pending.has_end = readDateTime(value, valueLen, pending.end, isDate);
+		pending.invalid |= ! pending.has_end || hasParam(params, paramsLen, "TZID");
+	} else if (matches(name, nameLen, "DURATION"))
+	{
+		pending.has_length = parseDuration(value, valueLen, pending.length);
+		pending.invalid |= ! pending.has_length;
+	} else if (matches(name, nameLen, "RRULE"))
+	{
+		pending.invalid |= ! parseRule(value, valueLen);
+	} else if (matches(name, nameLen, "EXDATE") || matches(name, nameLen, "RDATE")
+			|| matches(name, nameLen, "EXRULE") || matches(name, nameLen, "RECURRENCE-ID"))
+	{
+		// occurrences we'd have wrong (see IcsImporter.h)
+		pending.invalid = true;
+	} else if (matches(name, nameLen, "STATUS"))
+	{
+		pending.cancelled = matches(value, valueLen, "CANCELLED");
+	} else if (matches(name, nameLen, "UID"))
+	{
+		copyText(pending.uid, value, valueLen);
+	} else if (matches(name, nameLen, "SUMMARY"))
+	{
+		copyText(pending.summary, value, valueLen);
+	}
+}
+
+void IcsImporter::endEvent()
+{
+	in_event = false;
+	if (pending.invalid || pending.cancelled || ! pending.has_start)
+	{
+		num_skipped++;
+		return;
+	}
+
+	Chronos::EpochTime length;
+	if (pending.has_end)
+	{
+		if (pending.end < pending.start)
+		{
+			num_skipped++;
+			return;
+		}
+		length = pending.end - pending.start;
+	} else if (pending.has_length)
+	{
+		length = pending.length;
+	} else {
+		// a day, for a date, or nothing at all for a date-time
+		length = pending.all_day ? SECS_PER_DAY : 0;
+	}
+
+	if (pending.freq != NoFreq)
+	{
+		addRecurring(length);
+		return;
+	}
+
+	Chronos::Event event(default_id, DateTime(pending.start), DateTime(pending.start + length));
+	add(event);
+}
+
+void IcsImporter::addRecurring(Chronos::EpochTime length)
+{
+	DateTime from(pending.start);
+	const Chronos::TimeElements & els = from.asElements();
+	Chronos::Span::Delta duration(length);
+	uint8_t startDayBit = 1 << (els.Wday - Chronos::Weekday::Sunday);
+
+	Chronos::EpochTime unit = 0; // for rules with a fixed period
+	switch (pending.freq)
+	{
+	case Secondly:
+		unit = 1;
+		break;
+	case Minutely:
+		unit = SECS_PER_MIN;
+		break;
+	case Hourly:
+		unit = SECS_PER_HOUR;
+		break;
+	case Daily:
+		unit = SECS_PER_DAY;
+		break;
+	case Weekly:
+		unit = SECS_PER_WEEK;
+		break;
+	default:
+		break;
+	}
+
+	bool anyByDay = pending.by_day && pending.by_day != startDayBit;
+	if (pending.interval > 1 || pending.freq == Secondly || pending.freq == Minutely)
+	{
+		// a plain period, anchored at DTSTART
+		if (! unit || anyByDay || pending.by_month_day || pending.by_month)
+		{
+			num_skipped++;
+			return;
+		}
+
+		Chronos::Event event(default_id, Chronos::Mark::Every(from, Chronos::Span::Delta(unit * pending.interval)), duration);
+		bound(event, from);
+		add(event);
+		return;
+	}
+
+	switch (pending.freq)
+	{
+	case Hourly:
+		if (! (pending.by_day || pending.by_month_day || pending.by_month))
+		{
+			Chronos::Event event(default_id, Chronos::Mark::Hourly(els.Minute, els.Second), duration);
+			bound(event, from);
+			add(event);
+			return;
+		}
+		break;
+
+	case Daily:
+	case Weekly:
+		if (pending.by_month_day || pending.by_month || pending.nth)
+			break;
+
+		if (pending.freq == Daily && (! pending.by_day || pending.by_day == 0x7f))
+		{
+			Chronos::Event event(default_id, Chronos::Mark::Daily(els.Hour, els.Minute, els.Second), duration);
+			bound(event, from);
+			add(event);
+			return;
+		} else {
+			uint8_t days = pending.by_day ? pending.by_day : startDayBit;
+			// one event per day -- but a COUNT would have to be shared out amongst them
+			if (pending.count && (days & (days - 1)))
+				break;
+
+			for (uint8_t d=0; d<7; d++)
+			{
+				if (days & (1 << d))
+				{
+					Chronos::Event event(default_id, Chronos::Mark::Weekly(
+							(Chronos::Weekday::Day)(Chronos::Weekday::Sunday + d), els.Hour, els.Minute, els.Second),
+							duration);
+					bound(event, from);
+					add(event);
+				}
+			}
+			return;
+		}
+		break;
+
+	case Monthly:
+		if (pending.by_month)
+			break;
+
+		if (pending.by_day)
+		{
+			// the nth of one weekday
+			if (! pending.nth || pending.by_month_day || (pending.by_day & (pending.by_day - 1)))
+				break;
+
+			uint8_t d = 0;
+			while (! (pending.by_day & (1 << d)))
+			{
+				d++;
+			}
+
+			Chronos::Event event(default_id, Chronos::Mark::MonthlyNthWeekday(pending.nth,
+					(Chronos::Weekday::Day)(Chronos::Weekday::Sunday + d), els.Hour, els.Minute, els.Second),
+					duration);
+			bound(event, from);
+			add(event);
+			return;
+		} else {
+			Chronos::Event event(default_id, Chronos::Mark::Monthly(
+					pending.by_month_day ? pending.by_month_day : els.Day, els.Hour, els.Minute, els.Second),
+					duration);
+			bound(event, from);
+			add(event);
+			return;
+		}
+		break;
+
+	case Yearly:
+		if (pending.by_day || pending.nth)
+			break;
+
+		{
+			Chronos::Event event(default_id, Chronos::Mark::Yearly(
+					pending.by_month ? pending.by_month : els.Month,
+					pending.by_month_day ? pending.by_month_day : els.Day,
+					els.Hour, els.Minute, els.Second),
+					duration);
+			bound(event, from);
+			add(event);
+		}
+		return;
+
+	default:
+		break;
+	}
+
+	// nothing for that rule
+	num_skipped++;
+}
+
+void IcsImporter::bound(Chronos::Event & event, const DateTime & from)
+{
+	event.setFrom(from);
+	if (pending.count)
+	{
+		event.setCount(pending.count, from);
+	}
+
+	if (pending.has_until)
+	{
+		event.setUntil(DateTime(pending.until));
+	}
+}
+
+void IcsImporter::add(Chronos::Event & event)
+{
+	if (listener && ! listener->imported(event, pending.uid, pending.summary))
+		return;
+
+	if (cal.add(event))
+	{
+		num_added++;
+	} else {
+		num_skipped++;
+	}
+}
+
+bool IcsImporter::parseRule(const char * value, uint16_t len)
+{
+	if (pending.freq != NoFreq)
+		return false; // one RRULE per event
+
+	const char * end = value + len;
+	bool hasSetPos = false;
+	int8_t setPosValue = 0;
+	while (value < end)
+	{
+		// NAME=VALUE;...
+		const char * partEnd = reinterpret_cast<const char *>(memchr(value, ';', end - value));
+		if (! partEnd)
+			partEnd = end;
+		const char * equals = reinterpret_cast<const char *>(memchr(value, '=', partEnd - value));
+		if (! equals)
+			return false;
+
+		uint16_t nameLen = equals - value;
+		const char * p = equals + 1;
+		uint16_t partLen = partEnd - p;
+		uint32_t number;
+
+		if (matches(value, nameLen, "FREQ"))
+		{
+			static const char * const freqs[] = { "SECONDLY", "MINUTELY", "HOURLY", "DAILY", "WEEKLY",
+					"MONTHLY", "YEARLY" };
+			for (uint8_t f=0; f<7; f++)
+			{
+				if (matches(p, partLen, freqs[f]))
+					pending.freq = Secondly + f;
+			}
+			if (pending.freq == NoFreq)
+				return false;
+		} else if (matches(value, nameLen, "INTERVAL"))
+		{
+			if (! readNumber(p, partEnd, number) || p != partEnd || ! number)
+				return false;
+			pending.interval = number;
+		} else if (matches(value, nameLen, "COUNT"))
+		{
+			if (! readNumber(p, partEnd, number) || p != partEnd || ! number || number > 0xffff)
+				return false;
+			pending.count = number;
+		} else if (matches(value, nameLen, "UNTIL"))
+		{
+			bool isDate;
+			if (! readDateTime(p, partLen, pending.until, isDate))
+				return false;
+			if (isDate)
+			{
+				// the whole of that day
+				pending.until += SECS_PER_DAY - 1;
+			}
+			pending.has_until = true;
+		} else if (matches(value, nameLen, "BYDAY"))
+		{
+			// [+/-][n]DD,...
+			while (p < partEnd)
+			{
+				bool negative = (*p == '-');
+				if (*p == '-' || *p == '+')
+					p++;
+
+				int8_t n = 0;
+				if (readNumber(p, partEnd, number))
+				{
+					if (number > 5)
+						return false;
+					n = negative ? -((int8_t)number) : number;
+				}
+
+				uint8_t day = (partEnd - p >= 2) ? dayNamed(p) : 0;
+				if (! day || (n && pending.by_day))
+					return false; // only a single nth weekday is supported
+				p += 2;
+				pending.by_day |= 1 << (day - Chronos::Weekday::Sunday);
+				pending.nth = n;
+
+				if (p < partEnd && *p++ != ',')
+					return false;
+			}
+		} else if (matches(value, nameLen, "BYMONTHDAY"))
+		{
+			if (! readNumber(p, partEnd, number) || p != partEnd || ! number || number > 31)
+				return false;
+			pending.by_month_day = number;
+		} else if (matches(value, nameLen, "BYMONTH"))
+		{
+			if (! readNumber(p, partEnd, number) || p != partEnd || ! number || number > 12)
+				return false;
+			pending.by_month = number;
+		} else if (matches(value, nameLen, "BYSETPOS"))
+		{
+			bool negative = (*p == '-');
+			if (*p == '-' || *p == '+')
+				p++;
+			if (! readNumber(p, partEnd, number) || p != partEnd || ! number || number > 5)
+				return false;
+			setPosValue = negative ? -((int8_t)number) : number;
+			hasSetPos = true;
+		} else if (! matches(value, nameLen, "WKST"))
+		{
+			// BYHOUR, BYWEEKNO and the like: not something a mark can do
+			return false;
+		}
+
+		value = (partEnd < end) ? partEnd + 1 : end;
+	}
+
+	if (hasSetPos)
+	{
+		// BYDAY=FR;BYSETPOS=-1 is BYDAY=-1FR
+		if (pending.nth)
+			return false;
+		pending.nth = setPosValue;
+	}
+
+	return pending.freq != NoFreq;
+}
+
+bool IcsImporter::readDateTime(const char * value, uint16_t len, Chronos::EpochTime & into, bool & isDate)
+{
+	bool isUtc;
+	if (! parseDateTime(value, len, into, isDate, isUtc))
+		return false;
+
+	if (! isUtc)
+		return true;
+
+	// (and within the epochs Chronos can hold)
+	if (! has_utc_offset || (utc_offset < 0 && into < (Chronos::EpochTime)(-(int64_t)utc_offset))
+			|| (utc_offset > 0 && into > 0xffffffffUL - (Chronos::EpochTime)utc_offset))
+		return false;
+
+	into += utc_offset;
+	return true;
+}
+
+bool IcsImporter::parseDateTime(const char * value, uint16_t len, Chronos::EpochTime & into, bool & isDate,
+		bool & isUtc)
+{
+	// YYYYMMDD, or YYYYMMDDTHHMMSS with an optional Z
+	uint16_t year, month, day, hour=0, minute=0, second=0;
+	isDate = (len == 8);
+	isUtc = (len == 16);
+	if (! (isDate || ((len == 15 || (len == 16 && ICS_UPPER(value[15]) == 'Z')) && ICS_UPPER(value[8]) == 'T')))
+		return false;
+
+	if (! (readDigits(value, 4, year) && readDigits(&(value[4]), 2, month) && readDigits(&(value[6]), 2, day)))
+		return false;
+
+	if (! isDate && ! (readDigits(&(value[9]), 2, hour) && readDigits(&(value[11]), 2, minute)
+			&& readDigits(&(value[13]), 2, second)))
+		return false;
+
+	if (year < 1970 || year > 2105 || ! month || month > 12 || ! day || day > 31
+			|| hour > 23 || minute > 59 || second > 60)
+		return false;
+
+	into = DateTime(year, month, day, hour, minute, second).asEpoch();
+	return true;
+}
+
+bool IcsImporter::parseDuration(const char * value, uint16_t len, Chronos::EpochTime & into)
+{
+	// [+]P[nW] or [+]P[nD][T[nH][nM][nS]] -- negative ones make no sense here
+	const char * p = value;
+	const char * end = value + len;
+	if (p < end && *p == '+')
+		p++;
+	if (p >= end || ICS_UPPER(*p) != 'P')
+		return false;
+	p++;
+
+	into = 0;
+	bool inTime = false;
+	bool any = false;
+	while (p < end)
+	{
+		if (ICS_UPPER(*p) == 'T')
+		{
+			inTime = true;
+			p++;
+			continue;
+		}
+
+		uint32_t number;
+		if (! readNumber(p, end, number) || p >= end)
+			return false;
+
+		switch (ICS_UPPER(*p))
+		{
+		case 'W':
+			into += number * SECS_PER_WEEK;
+			break;
+		case 'D':
+			into += number * SECS_PER_DAY;
+			break;
+		case 'H':
+			into += number * SECS_PER_HOUR;
+			break;
+		case 'M':
+			into += number * SECS_PER_MIN;
+			break;
+		case 'S':
+			into += number;
+			break;
+		default:
+			return false;
+		}
+
+		// days and weeks before the T, the rest after
+		if (inTime != (ICS_UPPER(*p) == 'H' || ICS_UPPER(*p) == 'M' || ICS_UPPER(*p) == 'S'))
+			return false;
+
+		any = true;
+		p++;
+	}
+
+	return any;
+}
+
+void IcsImporter::copyText(char * into, const char * value, uint16_t len)
+{
+	// TEXT values escape commas, semicolons, backslashes and newlines
+	uint16_t out = 0;
+	for (uint16_t i=0; i<len && out < (CHRONOS_ICS_TEXT_MAX - 1); i++)
+	{
+		char c = value[i];
+		if (c == '\\' && (i + 1) < len)
+		{
+			c = value[++i];
+			if (c == 'n' || c == 'N')
+				c = '\n';
+		}
+		into[out++] = c;
+	}
+	into[out] = '\0';
+}
+
+} /* namespace Chronos */
@@ -28,6 +28,42 @@
 namespace Chronos {
 namespace Mark {
 
+uint8_t Monthly::daysInMonth(uint8_t tmYear, Month month)
+{
+	static const uint8_t monthLengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+	if (month == 2)
+	{
+		Year y = tmYearToCalendar(tmYear);
+		if ((y % 4 == 0) && ((y % 100) || (y % 400 == 0)))
+			return 29;
+	}
+
+	return monthLengths[month - 1];
+}
+
+void Monthly::shiftMonth(Chronos::TimeElements & els, bool forward)
+{
+	if (forward)
+	{
+		if (els.Month < 12)
+		{
+			els.Month++;
+		} else {
+			els.Month = 1;
+			els.Year++;
+		}
+	} else {
+		if (els.Month > 1)
+		{
+			els.Month--;
+		} else {
+			els.Month = 12;
+			els.Year--;
+		}
+	}
+}
+
 
 Monthly::Monthly(Day d) :
 		Event(),
@@ -67,12 +103,48 @@ DateTime Monthly::previous(const DateTime& dt) const {
 	return applyTo(dt, Previous);
 }
 
+DateTime Monthly::step(const DateTime& occurrence, Direction dir) const {
+
+	if (! strict_time)
+	{
+		return Event::step(occurrence, dir);
+	}
+
+	Chronos::TimeElements els(occurrence.asElements());
+
+	// move month by month until we land on one that
+	// actually has our target day (e.g. skip feb for the 30th)
+	do {
+		shiftMonth(els, dir == Next);
+	} while (day > daysInMonth(els.Year, els.Month));
+
+	els.Day = day;
+	return DateTime(els);
+}
+
 Event* Monthly::clone() const {
 	Monthly * theClone = new Monthly(day, hour, minute, sec);
 	theClone->strict_time = strict_time;
 	return theClone;
 }
 
+Event* Monthly::cloneInto(void * storage) const {
+	Monthly * theClone = new (storage) Monthly(day, hour, minute, sec);
+	theClone->strict_time = strict_time;
+	return theClone;
+}
+bool Monthly::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.strict_time = strict_time;
+	into.day = day;
+	into.hour = hour;
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
+
 DateTime Monthly::applyTo(const DateTime& dt,
 		Direction dir) const
 {
@@ -160,27 +232,15 @@ DateTime Monthly::applyTo(const DateTime& dt,
 	els.Day = day;
 
 
-	DateTime mod(els);
-	if (mod.day() != day)
+	// say we're feb 3rd and we're looking for the 31st
+	// then the target doesn't exist this month... well that sucks, so we KISS it and
+	// move to the next month that actually has the right date
+	while (day > daysInMonth(els.Year, els.Month))
 	{
-		// well that didn't workout...
-		// say we're feb 3rd and we're looking for the 31st
-		// then we just landed in march... well that sucks, so we KISS it and
-		// move to the next time we hit the right date
-		Chronos::Span::Days aDay(1);
-		while (mod.day() != day)
-		{
-			if (dir == Next)
-			{
-				mod += aDay;
-			} else {
-				mod -= aDay;
-			}
-		}
-
+		shiftMonth(els, dir == Next);
 	}
 
-	return mod;
+	return DateTime(els);
 }
 
 
@@ -0,0 +1,141 @@
+/*
+ * MonthlyNthWeekday.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/marks/MonthlyNthWeekday.h"
+#include "chronosinc/marks/Monthly.h"
+
+namespace Chronos {
+namespace Mark {
+
+MonthlyNthWeekday::MonthlyNthWeekday(int8_t n, Chronos::Weekday::Day d, Hours h, Minutes m, Seconds s) :
+		Event(),
+		nth(n),
+		wday((WeekDay)d),
+		hour(h),
+		minute(m),
+		sec(s)
+{
+	if (nth > 5)
+	{
+		nth = 5;
+	} else if (nth < -5)
+	{
+		nth = -5;
+	} else if (! nth)
+	{
+		nth = 1;
+	}
+}
+
+Event * MonthlyNthWeekday::clone()  const
+{
+	return new MonthlyNthWeekday(nth, (Chronos::Weekday::Day)wday, hour, minute, sec);
+}
+
+Event * MonthlyNthWeekday::cloneInto(void * storage)  const
+{
+	return new (storage) MonthlyNthWeekday(nth, (Chronos::Weekday::Day)wday, hour, minute, sec);
+}
+bool MonthlyNthWeekday::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.nth = nth;
+	into.day = wday;
+	into.hour = hour;
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
+
+DateTime MonthlyNthWeekday::next(const DateTime & dt) const {
+	return applyTo(dt, Next);
+}
+
+DateTime MonthlyNthWeekday::previous(const DateTime & dt)  const {
+	return applyTo(dt, Previous);
+}
+
+bool MonthlyNthWeekday::occurrenceIn(const Chronos::TimeElements & els, DateTime & into) const
+{
+	Chronos::TimeElements first(els);
+	first.Day = 1;
+	first.Hour = 0;
+	first.Minute = 0;
+	first.Second = 0;
+
+	Chronos::EpochTime monthStart = DateTime(first).asEpoch();
+	uint8_t monthLength = Monthly::daysInMonth(els.Year, els.Month);
+
+	// 1970-01-01 was a thursday (5)
+	uint8_t firstWday = ((monthStart / SECS_PER_DAY) + 4) % 7 + 1;
+
+	int8_t day;
+	if (nth > 0)
+	{
+		day = 1 + ((wday + 7 - firstWday) % 7) + (7 * (nth - 1));
+	} else {
+		uint8_t lastWday = ((firstWday - 1) + (monthLength - 1)) % 7 + 1;
+		day = monthLength - ((lastWday + 7 - wday) % 7) - (7 * (-nth - 1));
+	}
+
+	if (day < 1 || day > monthLength)
+		return false;
+
+	into = DateTime(monthStart + ((day - 1) * SECS_PER_DAY)
+			+ (hour * SECS_PER_HOUR) + (minute * SECS_PER_MIN) + sec);
+	return true;
+}
+
+DateTime MonthlyNthWeekday::applyTo(const DateTime & dt, Direction dir) const
+{
+	Chronos::TimeElements els(dt.asElements());
+	DateTime candidate(dt);
+
+	// this month's occurrence may already be behind us (or ahead, going backward)
+	// or the month may not have one at all -- in which case, try the next.
+	while (! (occurrenceIn(els, candidate) &&
+			((dir == Next) ? (candidate > dt) : (candidate < dt))))
+	{
+		Monthly::shiftMonth(els, dir == Next);
+	}
+
+	return candidate;
+}
+
+DateTime MonthlyNthWeekday::step(const DateTime & occurrence, Direction dir) const {
+
+	Chronos::TimeElements els(occurrence.asElements());
+	DateTime candidate(occurrence);
+
+	do {
+		Monthly::shiftMonth(els, dir == Next);
+	} while (! occurrenceIn(els, candidate));
+
+	return candidate;
+}
+
+} /* namespace Mark */
+} /* namespace Chronos */
@@ -0,0 +1,616 @@
+/*
+ * MutationLog.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/MutationLog.h"
+
+#ifdef CHRONOS_MUTATION_LOG
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MUTATIONLOG_LOG_MAGIC		"CHRL"
+#define MUTATIONLOG_SNAPSHOT_MAGIC	"CHRS"
+#define MUTATIONLOG_VERSION			1
+#define MUTATIONLOG_BYTE_ORDER		0x0102
+
+namespace Chronos {
+
+namespace {
+
+/*
+ * Both files are a FileHeader followed by frames: a FrameHeader, and that many
+ * bytes of records, which the crc covers.
+ */
+class FileHeader {
+public:
+	char magic[4];
+	uint16_t version;
+	uint16_t byte_order;
+	uint32_t generation;
+	uint32_t reserved;
+};
+
+class FrameHeader {
+public:
+	uint32_t length;
+	uint32_t crc;
+};
+
+// CRC-32 (IEEE 802.3)
+class Crc32 {
+public:
+	Crc32()
+	{
+		for (uint32_t i=0; i<256; i++)
+		{
+			uint32_t c = i;
+			for (uint8_t b=0; b<8; b++)
+			{
+				c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+			}
+			table[i] = c;
+		}
+	}
+
+	uint32_t of(const uint8_t * data, uint32_t len) const
+	{
+		uint32_t c = 0xffffffffUL;
+		for (uint32_t i=0; i<len; i++)
+		{
+			c = table[(c ^ data[i]) & 0xff] ^ (c >> 8);
+		}
+		return c ^ 0xffffffffUL;
+	}
+
+private:
+	uint32_t table[256];
+};
+
+uint32_t crc32(const uint8_t * data, uint32_t len)
+{
+	static const Crc32 crc;
+	return crc.of(data, len);
+}
+
+// records are packed, their fields copied in and out
+inline void put32(uint8_t * into, uint32_t value) { memcpy(into, &value, sizeof(value)); }
+inline uint32_t get32(const uint8_t * from) { uint32_t value; memcpy(&value, from, sizeof(value)); return value; }
+
+bool writeAll(int fd, const uint8_t * data, size_t len)
+{
+	while (len)
+	{
+		ssize_t numWritten = write(fd, data, len);
+		if (numWritten < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		data += numWritten;
+		len -= numWritten;
+	}
+	return true;
+}
+
+bool syncData(int fd)
+{
+#ifdef __linux__
+	return fdatasync(fd) == 0;
+#else
+	return fsync(fd) == 0;
+#endif
+}
+
+// so a rename() survives a crash too
+bool syncDirectoryOf(const std::string & path)
+{
+	std::string::size_type slash = path.rfind('/');
+	std::string dir = (slash == std::string::npos) ? "." : (slash ? path.substr(0, slash) : "/");
+	int fd = ::open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	bool success = (fsync(fd) == 0);
+	::close(fd);
+	return success;
+}
+
+FileHeader headerFor(const char * magic, uint32_t generation)
+{
+	FileHeader hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, magic, sizeof(hdr.magic));
+	hdr.version = MUTATIONLOG_VERSION;
+	hdr.byte_order = MUTATIONLOG_BYTE_ORDER;
+	hdr.generation = generation;
+	return hdr;
+}
+
+/*
+ * A whole file, mapped read-only.
+ */
+class MappedFile {
+public:
+	MappedFile() : data(NULL), size(0), missing(false) {}
+	~MappedFile() { if (data) munmap(const_cast<uint8_t *>(data), size); }
+
+	bool map(const std::string & path)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			missing = (errno == ENOENT);
+			return false;
+		}
+
+		struct stat st;
+		void * mapped = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && (uint64_t)st.st_size <= 0xffffffffULL)
+		{
+			size = st.st_size;
+			// (an empty file can't be mapped, but it's just as useless)
+			if (size)
+				mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		::close(fd);
+
+		if (MAP_FAILED == mapped)
+		{
+			size = 0;
+			return false;
+		}
+
+		data = reinterpret_cast<const uint8_t *>(mapped);
+		return true;
+	}
+
+	const uint8_t * data;
+	uint32_t size;
+	bool missing;
+};
+
+} /* anonymous namespace */
+
+MutationLog::MutationLog(Calendar & calendar) :
+		cal(calendar),
+		log_fd(-1),
+		log_size(0),
+		log_generation(0),
+		snapshot_at(CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES),
+		snapshotting(false),
+		num_replayed(0),
+		num_commits(0)
+{
+	pending.reserve(CHRONOS_MUTATION_LOG_BUFFER);
+	pending.resize(sizeof(FrameHeader));
+}
+
+MutationLog::~MutationLog()
+{
+	close();
+}
+
+bool MutationLog::open(const char * path)
+{
+	close();
+	log_path = std::string(path) + ".log";
+	snapshot_path = std::string(path) + ".snap";
+	log_generation = 0;
+	num_replayed = 0;
+
+	cal.beginUpdate();
+	cal.clear();
+
+	// the snapshot only ever appears whole (by rename()), so it must be all there...
+	bool success = true;
+	MappedFile snap;
+	if (snap.map(snapshot_path))
+	{
+		uint32_t goodSize;
+		success = replay(snap.data, snap.size, MUTATIONLOG_SNAPSHOT_MAGIC, log_generation, goodSize)
+				&& goodSize == snap.size;
+	} else if (! snap.missing)
+	{
+		success = false;
+	}
+
+	// ... while the log may end with a torn frame
+	uint32_t logGoodSize = 0;
+	MappedFile log;
+	if (success && log.map(log_path))
+	{
+		uint32_t logGeneration = 0;
+		FileHeader hdr;
+		if (log.size >= sizeof(hdr))
+		{
+			memcpy(&hdr, log.data, sizeof(hdr));
+			logGeneration = hdr.generation;
+		}
+
+		if (logGeneration > log_generation)
+		{
+			CHRONOS_DEBUG_OUTLN("MutationLog: log is newer than the snapshot?");
+			success = false;
+		} else if (logGeneration == log_generation
+				&& ! replay(log.data, log.size, MUTATIONLOG_LOG_MAGIC, logGeneration, logGoodSize))
+		{
+			// not a log at all, start over (an older one is already in the snapshot)
+			logGoodSize = 0;
+		}
+	} else if (success && ! log.missing)
+	{
+		success = false;
+	}
+
+	cal.endUpdate();
+	if (! success)
+		return false;
+
+	if (! logGoodSize)
+		return startLog(log_generation);
+
+	// carry on after the last whole frame
+	log_fd = ::open(log_path.c_str(), O_WRONLY | O_CLOEXEC);
+	if (log_fd < 0)
+		return false;
+
+	if ((logGoodSize < log.size && ftruncate(log_fd, logGoodSize) != 0)
+			|| lseek(log_fd, logGoodSize, SEEK_SET) < 0)
+	{
+		close();
+		return false;
+	}
+
+	log_size = logGoodSize;
+	snapshot_at = CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES;
+	return true;
+}
+
+void MutationLog::close()
+{
+	if (log_fd < 0)
+		return;
+
+	commit();
+	::close(log_fd);
+	log_fd = -1;
+	log_size = 0;
+	pending.resize(sizeof(FrameHeader));
+}
+
+bool MutationLog::startLog(uint32_t generation)
+{
+	if (log_fd >= 0)
+	{
+		::close(log_fd);
+		log_fd = -1;
+	}
+
+	// written aside and renamed into place, so the log is never without its header
+	std::string tmpPath(log_path + ".tmp");
+	int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return false;
+
+	FileHeader hdr(headerFor(MUTATIONLOG_LOG_MAGIC, generation));
+	if (! (writeAll(fd, reinterpret_cast<const uint8_t *>(&hdr), sizeof(hdr)) && syncData(fd))
+			|| rename(tmpPath.c_str(), log_path.c_str()) != 0
+			|| ! syncDirectoryOf(log_path))
+	{
+		::close(fd);
+		return false;
+	}
+
+	log_fd = fd;
+	log_size = sizeof(hdr);
+	log_generation = generation;
+	snapshot_at = CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES;
+	return true;
+}
+
+uint8_t MutationLog::encode(const Chronos::Event & event, Record & into)
+{
+	into[1] = event.id();
+	into[2] = event.tag();
+	if (! event.isRecurring())
+	{
+		into[0] = AddOneTime;
+		put32(&(into[3]), event.start().asEpoch());
+		put32(&(into[7]), event.finish().asEpoch());
+		return 11;
+	}
+
+	Chronos::Mark::Event::Params params;
+	Chronos::EpochTime length, first, last;
+	if (! event.saveTo(params, length, first, last))
+		return 0;
+
+	into[0] = AddRecurring;
+	memcpy(&(into[3]), &params, sizeof(params));
+	put32(&(into[3 + sizeof(params)]), length);
+	put32(&(into[7 + sizeof(params)]), first);
+	put32(&(into[11 + sizeof(params)]), last);
+	return 15 + sizeof(params);
+}
+
+bool MutationLog::reserve(uint8_t len)
+{
+	if (log_fd < 0)
+		return false;
+
+	return (pending.size() + len <= CHRONOS_MUTATION_LOG_BUFFER) || commit();
+}
+
+bool MutationLog::add(const Chronos::Event & event)
+{
+	Record rec;
+	uint8_t len = encode(event, rec);
+	if (! (len && reserve(len) && cal.add(event)))
+		return false;
+
+	append(rec, len);
+	return true;
+}
+
+bool MutationLog::remove(EventID evId)
+{
+	uint8_t rec[2] = { Remove, (uint8_t)evId };
+	if (! (reserve(sizeof(rec)) && cal.remove(evId)))
+		return false;
+
+	append(rec, sizeof(rec));
+	return true;
+}
+
+bool MutationLog::setTag(EventID evId, EventTag tag)
+{
+	uint8_t rec[3] = { SetTag, (uint8_t)evId, tag };
+	if (! (reserve(sizeof(rec)) && cal.setTag(evId, tag)))
+		return false;
+
+	append(rec, sizeof(rec));
+	return true;
+}
+
+bool MutationLog::clear()
+{
+	uint8_t rec[1] = { Clear };
+	if (! reserve(sizeof(rec)))
+		return false;
+
+	cal.clear();
+	append(rec, sizeof(rec));
+	return true;
+}
+
+bool MutationLog::commit()
+{
+	if (log_fd < 0)
+		return false;
+
+	if (pending.size() == sizeof(FrameHeader))
+		return true; // nothing to do
+
+	FrameHeader frame;
+	frame.length = pending.size() - sizeof(frame);
+	frame.crc = crc32(&(pending[sizeof(frame)]), frame.length);
+	memcpy(&(pending[0]), &frame, sizeof(frame));
+
+	// one write and one sync, for the whole group
+	if (! (writeAll(log_fd, &(pending[0]), pending.size()) && syncData(log_fd)))
+	{
+		// don't leave part of a frame for the next one to follow
+		if (ftruncate(log_fd, log_size) != 0 || lseek(log_fd, log_size, SEEK_SET) < 0)
+		{
+			CHRONOS_DEBUG_OUTLN("MutationLog: couldn't undo partial write");
+		}
+		return false;
+	}
+
+	log_size += pending.size();
+	pending.resize(sizeof(FrameHeader));
+	num_commits++;
+
+	if (log_size >= snapshot_at && ! snapshotting && ! snapshot())
+	{
+		// (the changes are safe in the log) -- rather than retrying on every
+		// commit, wait for the log to grow some more
+		snapshot_at = (log_size < 0xffffffffUL - CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES) ?
+				log_size + CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES : 0xffffffffUL;
+	}
+
+	return true;
+}
+
+bool MutationLog::snapshot()
+{
+	// a snapshot taken by this commit would come first, and this one would then
+	// belong to the generation after it
+	snapshotting = true;
+	bool committed = commit();
+	snapshotting = false;
+	if (! committed)
+		return false;
+
+	std::string tmpPath(snapshot_path + ".tmp");
+	int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return false;
+
+	// the calendar as a series of adds, framed just like the log, but for the next generation
+	FileHeader hdr(headerFor(MUTATIONLOG_SNAPSHOT_MAGIC, log_generation + 1));
+	bool success = writeAll(fd, reinterpret_cast<const uint8_t *>(&hdr), sizeof(hdr));
+
+	std::vector<uint8_t> frame(sizeof(FrameHeader));
+	frame.reserve(CHRONOS_MUTATION_LOG_BUFFER);
+	Chronos::Event evt;
+	for (uint32_t i=0; success; i++)
+	{
+		Record rec;
+		uint8_t len = 0;
+		bool more = cal.eventAt(i, evt);
+		if (more && ! (len = encode(evt, rec)))
+		{
+			// added to the calendar directly -- and not something we can keep
+			CHRONOS_DEBUG_OUTLN("MutationLog: event can't be saved");
+			success = false;
+			break;
+		}
+
+		if (frame.size() > sizeof(FrameHeader) && (! more || frame.size() + len > CHRONOS_MUTATION_LOG_BUFFER))
+		{
+			FrameHeader head;
+			head.length = frame.size() - sizeof(head);
+			head.crc = crc32(&(frame[sizeof(head)]), head.length);
+			memcpy(&(frame[0]), &head, sizeof(head));
+			success = writeAll(fd, &(frame[0]), frame.size());
+			frame.resize(sizeof(FrameHeader));
+		}
+
+		if (! more)
+			break;
+
+		frame.insert(frame.end(), rec, rec + len);
+	}
+
+	success = success && syncData(fd);
+	::close(fd);
+	if (! success || rename(tmpPath.c_str(), snapshot_path.c_str()) != 0 || ! syncDirectoryOf(snapshot_path))
+	{
+		unlink(tmpPath.c_str());
+		return false;
+	}
+
+	// from here, a crash leaves the old log behind, which open() knows to skip
+	return startLog(log_generation + 1);
+}
+
+bool MutationLog::replay(const uint8_t * data, uint32_t size, const char * magic,
+		uint32_t & generation, uint32_t & goodSize)
+{
+	FileHeader hdr;
+	if (size < sizeof(hdr))
+		return false;
+
+	memcpy(&hdr, data, sizeof(hdr));
+	if (memcmp(hdr.magic, magic, sizeof(hdr.magic)) != 0 || hdr.version != MUTATIONLOG_VERSION
+			|| hdr.byte_order != MUTATIONLOG_BYTE_ORDER)
+	{
+		CHRONOS_DEBUG_OUTLN("MutationLog: not a log, or from another version/byte order");
+		return false;
+	}
+
+	generation = hdr.generation;
+	uint32_t pos = sizeof(hdr);
+	while (size - pos >= sizeof(FrameHeader))
+	{
+		FrameHeader frame;
+		memcpy(&frame, &(data[pos]), sizeof(frame));
+		const uint8_t * records = &(data[pos + sizeof(frame)]);
+		if (frame.length > size - pos - sizeof(frame) || crc32(records, frame.length) != frame.crc)
+			break; // torn
+
+		if (! applyRecords(records, frame.length))
+			break;
+
+		pos += sizeof(frame) + frame.length;
+	}
+
+	goodSize = pos;
+	return true;
+}
+
+bool MutationLog::applyRecords(const uint8_t * records, uint32_t len)
+{
+	Chronos::Event evt;
+	uint32_t pos = 0;
+	while (pos < len)
+	{
+		const uint8_t * rec = &(records[pos]);
+		uint32_t left = len - pos;
+		uint8_t recLen;
+		switch (rec[0])
+		{
+		case AddOneTime:
+			recLen = 11;
+			if (left < recLen)
+				return false;
+			evt.set((EventID)rec[1], DateTime(get32(&(rec[3]))), DateTime(get32(&(rec[7]))));
+			evt.setTag(rec[2]);
+			cal.add(evt);
+			break;
+
+		case AddRecurring:
+			{
+				Chronos::Mark::Event::Params params;
+				recLen = 15 + sizeof(params);
+				if (left < recLen)
+					return false;
+				memcpy(&params, &(rec[3]), sizeof(params));
+				if (! evt.restoreFrom((EventID)rec[1], rec[2], params, get32(&(rec[3 + sizeof(params)])),
+						get32(&(rec[7 + sizeof(params)])), get32(&(rec[11 + sizeof(params)]))))
+					return false;
+				cal.add(evt);
+			}
+			break;
+
+		case Remove:
+			recLen = 2;
+			if (left < recLen)
+				return false;
+			cal.remove((EventID)rec[1]);
+			break;
+
+		case SetTag:
+			recLen = 3;
+			if (left < recLen)
+				return false;
+			cal.setTag((EventID)rec[1], rec[2]);
+			break;
+
+		case Clear:
+			recLen = 1;
+			cal.clear();
+			break;
+
+		default:
+			return false;
+		}
+
+		pos += recLen;
+		num_replayed++;
+	}
+
+	return true;
+}
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_MUTATION_LOG */
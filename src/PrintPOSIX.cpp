@@ -0,0 +1,127 @@
+/*
+ * PrintPOSIX.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/platform/printPOSIX.h"
+
+#ifdef CHRONOS_PLATFORM_POSIX
+
+#include <string.h>
+
+size_t Print::write(const uint8_t * buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--)
+	{
+		if (! write(*buffer++))
+			break;
+		n++;
+	}
+	return n;
+}
+
+size_t Print::write(const char * str)
+{
+	if (! str)
+		return 0;
+
+	return write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::print(const char str[]) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char v, int base) { return print((unsigned long)v, base); }
+size_t Print::print(int v, int base) { return print((long)v, base); }
+size_t Print::print(unsigned int v, int base) { return print((unsigned long)v, base); }
+
+size_t Print::print(long v, int base)
+{
+	if (base == DEC && v < 0)
+	{
+		size_t n = print('-');
+		return n + printNumber(0UL - (unsigned long)v, DEC);
+	}
+
+	// other bases: the bits, as is
+	return printNumber((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) { return printNumber(v, base); }
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const char str[]) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char v, int base) { return print(v, base) + println(); }
+size_t Print::println(int v, int base) { return print(v, base) + println(); }
+size_t Print::println(unsigned int v, int base) { return print(v, base) + println(); }
+size_t Print::println(long v, int base) { return print(v, base) + println(); }
+size_t Print::println(unsigned long v, int base) { return print(v, base) + println(); }
+
+size_t Print::printNumber(unsigned long v, uint8_t base)
+{
+	char buf[8 * sizeof(long) + 1];
+	char * str = &buf[sizeof(buf)];
+
+	if (base < 2)
+		base = DEC;
+
+	// filled from the end
+	do {
+		char digit = v % base;
+		v /= base;
+		*--str = (digit < 10) ? digit + '0' : digit + 'A' - 10;
+	} while (v);
+
+	return write((const uint8_t *)str, &buf[sizeof(buf)] - str);
+}
+
+namespace Chronos {
+namespace Platform {
+
+size_t StdioPrint::write(uint8_t c)
+{
+	return (fputc(c, file) == EOF) ? 0 : 1;
+}
+
+size_t StdioPrint::write(const uint8_t * buffer, size_t size)
+{
+	return fwrite(buffer, 1, size, file);
+}
+
+StdioPrint & StdioPrint::out()
+{
+	static StdioPrint printer(stdout);
+	return printer;
+}
+
+StdioPrint & StdioPrint::err()
+{
+	static StdioPrint printer(stderr);
+	return printer;
+}
+
+} /* namespace Platform */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_PLATFORM_POSIX */
@@ -0,0 +1,170 @@
+/*
+ * ScheduleReplay.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/schedule/ScheduleReplay.h"
+
+namespace Chronos {
+
+ScheduleReplay::ScheduleReplay(Calendar & calendar) :
+		cal(calendar), ongoing(NULL), previous(NULL), starting(NULL), changed(NULL), capacity(0),
+		num_started(0), num_ended(0)
+{
+
+}
+
+ScheduleReplay::~ScheduleReplay()
+{
+	delete [] ongoing;
+	delete [] previous;
+	delete [] starting;
+	delete [] changed;
+}
+
+bool ScheduleReplay::reserve(uint16_t num, uint8_t numPrevious)
+{
+	if (num > 0xff)
+		num = 0xff;
+
+	if (num <= capacity)
+		return true;
+
+	Event::Occurrence * newOngoing = new Event::Occurrence[num];
+	Event::Occurrence * newPrevious = new Event::Occurrence[num];
+	Event::Occurrence * newStarting = new Event::Occurrence[num];
+	Event::Occurrence * newChanged = new Event::Occurrence[num];
+	if (! (newOngoing && newPrevious && newStarting && newChanged))
+	{
+		CHRONOS_DEBUG_OUTLN("ScheduleReplay: Couldn't allocate space for occurrences?");
+		delete [] newOngoing;
+		delete [] newPrevious;
+		delete [] newStarting;
+		delete [] newChanged;
+		return false;
+	}
+
+	for (uint8_t i=0; i<numPrevious; i++)
+	{
+		newPrevious[i] = previous[i];
+	}
+
+	delete [] ongoing;
+	delete [] previous;
+	delete [] starting;
+	delete [] changed;
+	ongoing = newOngoing;
+	previous = newPrevious;
+	starting = newStarting;
+	changed = newChanged;
+	capacity = num;
+	return true;
+}
+
+uint32_t ScheduleReplay::run(const DateTime & from, const DateTime & until, Listener & listener)
+{
+	num_started = 0;
+	num_ended = 0;
+
+	uint32_t numSteps = 0;
+	uint8_t numPrevious = 0;
+	DateTime at(from);
+	DateTime next(from);
+	while (at <= until)
+	{
+#ifdef CHRONOS_CLOCK_SIMULATED
+		SimulatedClock::set(at.asEpoch());
+#endif
+		// the listener may have added events since the last step
+		if (! reserve(cal.numEvents(), numPrevious))
+			break;
+
+		// what's on-going, and what starts here: the latter from the occurrences
+		// next after the second before, as zero-length ones are never on-going
+		DateTime justBefore(at - Span::Seconds(1));
+		uint8_t numOngoing;
+		uint8_t numStarting;
+		for (;;)
+		{
+			numOngoing = cal.listOngoing(capacity, ongoing, at);
+			numStarting = cal.listNext(capacity, starting, justBefore);
+			while (numStarting && starting[numStarting - 1].start != at)
+				numStarting--;
+
+			// more of either than numEvents() let on (e.g. a CalendarColumnar's one-time
+			// events, through a Calendar reference)?
+			if (! ((numOngoing == capacity || numStarting == capacity) && capacity < 0xff
+					&& reserve(2 * (uint16_t)capacity + 1, numPrevious)))
+				break;
+		}
+
+		uint8_t numChanged = 0;
+		for (uint8_t i=0; i<numPrevious; i++)
+		{
+			if (previous[i].finish <= at)
+				changed[numChanged++] = previous[i];
+		}
+
+		if (numChanged)
+		{
+			num_ended += numChanged;
+			listener.ended(at, changed, numChanged);
+		}
+
+		if (numStarting)
+		{
+			num_started += numStarting;
+			listener.started(at, starting, numStarting);
+		}
+
+		// zero-length occurrences end right where they started
+		numChanged = 0;
+		for (uint8_t i=0; i<numStarting; i++)
+		{
+			if (starting[i].finish == at)
+				changed[numChanged++] = starting[i];
+		}
+
+		if (numChanged)
+		{
+			num_ended += numChanged;
+			listener.ended(at, changed, numChanged);
+		}
+
+		// what's on-going now is what may end next
+		Event::Occurrence * swap = previous;
+		previous = ongoing;
+		ongoing = swap;
+		numPrevious = numOngoing;
+
+		numSteps++;
+		if (! cal.nextDateTimeOfInterest(at, next))
+			break;
+
+		at = next;
+	}
+
+	return numSteps;
+}
+
+} /* namespace Chronos */
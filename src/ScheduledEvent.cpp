@@ -34,7 +34,8 @@ namespace Chronos {
 // int Event::schedev_counter = 0;
 Event::Event() : event_id(EVENTID_NOTSET),
 is_recurring(false),
-t_event(NULL),
+mark_kind(EVENT_MARK_NOTSET),
+event_tag(EVENTTAG_NONE),
 duration(0)
 {
 
@@ -43,11 +44,14 @@ duration(0)
 Event::Event(EventID evId, const Chronos::Mark::Event & timeEvent, const Chronos::Span::Delta & evtDuration):
 		event_id(evId),
 		is_recurring(true),
-		t_event(NULL),
-		duration(evtDuration)
+		mark_kind(EVENT_MARK_NOTSET),
+		event_tag(EVENTTAG_NONE),
+		duration(evtDuration),
+		dt_start((Chronos::EpochTime)0),
+		dt_end((Chronos::EpochTime)EVENT_SERIES_FOREVER)
 {
 
-	t_event = timeEvent.clone();
+	setMark(timeEvent);
 }
 
 
@@ -55,7 +59,8 @@ Event::Event(EventID evId, const Chronos::Mark::Event & timeEvent, const Chronos
 Event::Event(EventID evId, const DateTime& start, const DateTime& end) :
 		event_id(evId),
 		is_recurring(false),
-		t_event(NULL),
+		mark_kind(EVENT_MARK_NOTSET),
+		event_tag(EVENTTAG_NONE),
 		duration(0),
 		dt_start(start),
 		dt_end(end)
@@ -67,7 +72,8 @@ Event::Event(EventID evId, const DateTime& start,
 		const Chronos::Span::Delta& evtDuration) :
 		event_id(evId),
 		is_recurring(false),
-		t_event(NULL),
+		mark_kind(EVENT_MARK_NOTSET),
+		event_tag(EVENTTAG_NONE),
 		duration(evtDuration),
 		dt_start(start),
 		dt_end(start + evtDuration)
@@ -79,14 +85,19 @@ Event::Event(EventID evId, const DateTime& start,
 Event::Event(EventID evId, const Chronos::Mark::Event & timeEvent, Chronos::Span::Delta && evtDuration) :
 				event_id(evId),
 				is_recurring(true),
-				duration(std::move(evtDuration))
+				mark_kind(EVENT_MARK_NOTSET),
+				event_tag(EVENTTAG_NONE),
+				duration(std::move(evtDuration)),
+				dt_start((Chronos::EpochTime)0),
+				dt_end((Chronos::EpochTime)EVENT_SERIES_FOREVER)
 {
-		t_event = timeEvent.clone();
+		setMark(timeEvent);
 }
 Event::Event(Chronos::EventID evId, DateTime && start, DateTime && end) :
 	event_id(evId),
 	is_recurring(false),
-	t_event(NULL),
+	mark_kind(EVENT_MARK_NOTSET),
+	event_tag(EVENTTAG_NONE),
 	duration(0),
 	dt_start(std::move(start)),
 	dt_end(std::move(end))
@@ -95,7 +106,8 @@ Event::Event(Chronos::EventID evId, DateTime && start, DateTime && end) :
 Event::Event(EventID evId, DateTime && start, Chronos::Span::Delta && evtDuration) :
 	event_id(evId),
 	is_recurring(false),
-	t_event(NULL),
+	mark_kind(EVENT_MARK_NOTSET),
+	event_tag(EVENTTAG_NONE),
 	duration(std::move(evtDuration)),
 	dt_start(std::move(start)),
 	dt_end(std::move(start + duration))
@@ -108,36 +120,50 @@ Event::Event(EventID evId, DateTime && start, Chronos::Span::Delta && evtDuratio
 Event::Event(Event&& other) :
 		event_id(other.event_id),
 		is_recurring(other.is_recurring),
-		t_event(other.t_event),
+		mark_kind(EVENT_MARK_NOTSET),
+		event_tag(other.event_tag),
 		duration(std::move(other.duration)),
 		dt_start(std::move(other.dt_start)),
-		dt_end(std::move(other.dt_end))
+		dt_end(std::move(other.dt_end)),
+		exceptions(other.exceptions)
 {
-	// we've taken ownership of the rvalue's event pointer
-	other.t_event = NULL;  // prevent it from being released in rvalue's d'tor
-
+	if (other.mark_kind == Chronos::Mark::Event::UserDefinedKind)
+	{
+		// we take ownership of the rvalue's heap mark
+		mark_kind = other.mark_kind;
+		mark_store.heap = other.mark_store.heap;
+		other.mark_kind = EVENT_MARK_NOTSET; // prevent it from being released in rvalue's d'tor
+	} else if (other.mark_kind != EVENT_MARK_NOTSET)
+	{
+		// in-place marks are cheap to copy
+		setMark(*(other.mark()));
+	}
 
 }
 Event & Event::operator=(Event&& other)
 {
+	if (this == &other)
+		return *this;
+
 	event_id = other.event_id;
 	is_recurring = other.is_recurring;
+	event_tag = other.event_tag;
 	duration = std::move(other.duration);
 	dt_start = std::move(other.dt_start);
 	dt_end = std::move(other.dt_end);
+	exceptions = other.exceptions;
 
-	if (t_event)
+	releaseMark();
+	if (other.mark_kind == Chronos::Mark::Event::UserDefinedKind)
 	{
-		delete t_event;
-	}
-	if (other.t_event)
-	{
-		// take ownership of the rvalue's event pointer
-		t_event = other.t_event;
-		other.t_event = NULL; // prevent it from being released in d'tor
+		// take ownership of the rvalue's heap mark
+		mark_kind = other.mark_kind;
+		mark_store.heap = other.mark_store.heap;
+		other.mark_kind = EVENT_MARK_NOTSET; // prevent it from being released in d'tor
 
-	} else {
-		t_event = NULL;
+	} else if (other.mark_kind != EVENT_MARK_NOTSET)
+	{
+		setMark(*(other.mark()));
 	}
 
 	return *this;
@@ -149,66 +175,390 @@ Event & Event::operator=(Event&& other)
 Event::Event(const Event & other) :
 		event_id(other.event_id),
 		is_recurring(other.is_recurring),
-		t_event(NULL),
+		mark_kind(EVENT_MARK_NOTSET),
+		event_tag(other.event_tag),
 		duration(other.duration),
 		dt_start(other.dt_start),
-		dt_end(other.dt_end)
+		dt_end(other.dt_end),
+		exceptions(other.exceptions)
 {
-	if (NULL != other.t_event)
-	{
-		t_event = other.t_event->clone();
-	}
+	copyMark(other);
 }
 
 
 Event & Event::operator=(const Event & other)
 {
+	if (this == &other)
+		return *this;
+
 	event_id = other.event_id;
 	is_recurring = other.is_recurring;
+	event_tag = other.event_tag;
 	duration = other.duration;
 	dt_start = other.dt_start;
 	dt_end = other.dt_end;
+	exceptions = other.exceptions;
+
+	copyMark(other);
+
+	return *this;
+}
+Event::~Event()
+{
+	// schedev_counter--;
+	reset();
+
+}
+
+void Event::reset()
+{
+
+	event_id = EVENTID_NOTSET;
+	event_tag = EVENTTAG_NONE;
+	exceptions = Exceptions();
+	releaseMark();
+
+
+}
+
+void Event::set(EventID id, const DateTime & start, const DateTime & end)
+{
+	event_id = id;
+	event_tag = EVENTTAG_NONE;
+	is_recurring = false;
+	duration = Chronos::Span::Delta(0);
+	dt_start = start;
+	dt_end = end;
+	exceptions = Exceptions();
+	releaseMark();
+}
+
+void Event::setFrom(const DateTime & first)
+{
+	if (is_recurring)
+		setSeries(first.asEpoch(), seriesLast());
+}
+
+void Event::setUntil(const DateTime & last)
+{
+	if (! (is_recurring && mark()))
+		return;
 
-	/* ???
-	if (NULL != t_event)
+	Chronos::EpochTime until = last.asEpoch();
+	if (until == EVENT_SERIES_FOREVER)
 	{
+		setSeries(seriesFirst(), until);
+		return;
+	}
 
+	// as setCount() does, keep the last actual start, so hasNext() turns false
+	// once it's passed rather than at UNTIL
+	Chronos::EpochTime lastStart = markPrevious(DateTime(until + 1)).asEpoch();
+	if (lastStart > until || lastStart < seriesFirst())
+	{
+		// nothing, ever
+		lastStart = 0;
 	}
-	*/
+	setSeries(seriesFirst(), lastStart);
+}
 
-	if (t_event)
+void Event::setCount(uint16_t count, const DateTime & from)
+{
+	if (! (is_recurring && mark()))
+		return;
+
+	if (! count)
 	{
-		delete t_event;
+		// nothing, ever
+		setSeries(from.asEpoch(), 0);
+		return;
 	}
 
-	if (other.t_event)
+	// as in iCalendar, exceptions don't change which occurrence is the last
+	Chronos::Mark::Cursor cursor(mark()->cursor(DateTime(from.asEpoch() ? from.asEpoch() - 1 : 0)));
+	DateTime nth(from);
+	for (uint16_t i=0; i<count; i++)
 	{
-		t_event = other.t_event->clone();
+		nth = cursor.advance();
+	}
+	setSeries(from.asEpoch(), nth.asEpoch());
+}
 
-	} else {
-		t_event = NULL;
+void Event::setExceptions(const DateTime sortedExceptions[], uint8_t num)
+{
+	exceptions.list = sortedExceptions;
+	exceptions.num = sortedExceptions ? num : 0;
+}
+
+void Event::clearBounds()
+{
+	if (is_recurring)
+		setSeries(0, EVENT_SERIES_FOREVER);
+	exceptions = Exceptions();
+}
+
+bool Event::isException(const DateTime & start) const
+{
+	// binary search for the first exception >= start
+	uint16_t low = 0;
+	uint16_t high = exceptions.num;
+	while (low < high)
+	{
+		uint16_t mid = (low + high) / 2;
+		if (exceptions.list[mid] < start)
+		{
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
 	}
 
-	return *this;
+	return (low < exceptions.num && exceptions.list[low] == start);
 }
-Event::~Event()
+
+bool Event::validNext(const DateTime & dt, DateTime & into)
+{
+	DateTime candidate(occurrenceAfter(
+			(dt.asEpoch() < seriesFirst()) ? DateTime(seriesFirst() - 1) : dt));
+
+	while (candidate.asEpoch() <= seriesLast() && isException(candidate))
+	{
+		candidate = occurrenceAfter(candidate);
+	}
+
+	if (candidate.asEpoch() > seriesLast())
+		return false;
+
+	into = candidate;
+	return true;
+}
+
+bool Event::validPrevious(const DateTime & dt, DateTime & into)
+{
+	DateTime candidate(occurrenceBefore(
+			(dt.asEpoch() > seriesLast()) ? DateTime(seriesLast() + 1) : dt));
+
+	while (candidate.asEpoch() > seriesFirst() && isException(candidate))
+	{
+		candidate = occurrenceBefore(candidate);
+	}
+
+	if (candidate.asEpoch() < seriesFirst() || isException(candidate))
+		return false;
+
+	into = candidate;
+	return true;
+}
+
+bool Event::isValid() const
+{
+	if (! is_recurring)
+		return true;
+
+	const Chronos::Mark::Event * m = mark();
+	return m && m->isValid();
+}
+
+const Chronos::Mark::Event * Event::mark() const
+{
+	if (mark_kind == EVENT_MARK_NOTSET)
+		return NULL;
+
+	if (mark_kind == Chronos::Mark::Event::UserDefinedKind)
+		return mark_store.heap;
+
+	return reinterpret_cast<const Chronos::Mark::Event *>(mark_store.bytes);
+}
+
+void Event::setMark(const Chronos::Mark::Event & timeEvent)
+{
+	releaseMark();
+
+	if (timeEvent.cloneInto(mark_store.bytes))
+	{
+		// a built-in, now living in our mark_store
+		mark_kind = timeEvent.kind();
+		return;
+	}
+
+	mark_store.heap = timeEvent.clone();
+	if (mark_store.heap)
+	{
+		mark_kind = Chronos::Mark::Event::UserDefinedKind;
+	}
+}
+
+bool Event::saveTo(Chronos::Mark::Event::Params & markParams, Chronos::EpochTime & length,
+		Chronos::EpochTime & first, Chronos::EpochTime & last) const
+{
+	// the exceptions are the caller's array, which we can't take along
+	if (! is_recurring || exceptions.num || NULL == mark() || ! mark()->params(markParams))
+		return false;
+
+	length = duration.totalSeconds();
+	first = seriesFirst();
+	last = seriesLast();
+	return true;
+}
+
+bool Event::restoreFrom(EventID id, EventTag tag, const Chronos::Mark::Event::Params & markParams,
+		Chronos::EpochTime length, Chronos::EpochTime first, Chronos::EpochTime last)
 {
-	// schedev_counter--;
 	reset();
+	if (NULL == Chronos::Mark::Event::restoreInto(markParams, mark_store.bytes))
+		return false;
+
+	mark_kind = markParams.kind;
+	event_id = id;
+	event_tag = tag;
+	is_recurring = true;
+	duration = Chronos::Span::Delta(length);
+	setSeries(first, last);
+	return true;
+}
+
+void Event::copyMark(const Event & other)
+{
+	if (other.mark_kind == Chronos::Mark::Event::UserDefinedKind)
+	{
+		// retain before releasing, in case we already share it
+		const Chronos::Mark::Event * shared = other.mark_store.heap->retain();
+		releaseMark();
+		if (shared)
+		{
+			// (NULL only if a saturated mark couldn't be copied)
+			mark_store.heap = shared;
+			mark_kind = Chronos::Mark::Event::UserDefinedKind;
+		}
+		return;
+	}
+
+	if (other.mark_kind == EVENT_MARK_NOTSET)
+	{
+		releaseMark();
+		return;
+	}
 
+	setMark(*(other.mark()));
 }
 
-void Event::reset()
+void Event::releaseMark()
 {
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+	occ_cache.state = OccurrenceCache::Empty;
+#endif
 
-	event_id = EVENTID_NOTSET;
-	if (NULL != t_event)
+	if (mark_kind == EVENT_MARK_NOTSET)
+		return;
+
+	if (mark_kind == Chronos::Mark::Event::UserDefinedKind)
+	{
+		mark_store.heap->release();
+	} else {
+		// in place, only needs destruction
+		reinterpret_cast<Chronos::Mark::Event *>(mark_store.bytes)->~Event();
+	}
+
+	mark_kind = EVENT_MARK_NOTSET;
+}
+
+// calls through the concrete type, rather than the vtable, for built-ins
+#define EVENT_MARK_DISPATCH(kindId, cls, method, dt) \
+	case Chronos::Mark::Event::kindId: \
+		return reinterpret_cast<const Chronos::Mark::cls *>(mark_store.bytes)->cls::method(dt)
+
+DateTime Event::markNext(const DateTime & dt) const
+{
+	switch (mark_kind)
+	{
+	EVENT_MARK_DISPATCH(HourlyKind, Hourly, next, dt);
+	EVENT_MARK_DISPATCH(DailyKind, Daily, next, dt);
+	EVENT_MARK_DISPATCH(WeeklyKind, Weekly, next, dt);
+	EVENT_MARK_DISPATCH(MonthlyKind, Monthly, next, dt);
+	EVENT_MARK_DISPATCH(YearlyKind, Yearly, next, dt);
+	EVENT_MARK_DISPATCH(EveryKind, Every, next, dt);
+	EVENT_MARK_DISPATCH(MonthlyNthWeekdayKind, MonthlyNthWeekday, next, dt);
+	default:
+		break;
+	}
+
+	return mark()->next(dt);
+}
+
+DateTime Event::markPrevious(const DateTime & dt) const
+{
+	switch (mark_kind)
+	{
+	EVENT_MARK_DISPATCH(HourlyKind, Hourly, previous, dt);
+	EVENT_MARK_DISPATCH(DailyKind, Daily, previous, dt);
+	EVENT_MARK_DISPATCH(WeeklyKind, Weekly, previous, dt);
+	EVENT_MARK_DISPATCH(MonthlyKind, Monthly, previous, dt);
+	EVENT_MARK_DISPATCH(YearlyKind, Yearly, previous, dt);
+	EVENT_MARK_DISPATCH(EveryKind, Every, previous, dt);
+	EVENT_MARK_DISPATCH(MonthlyNthWeekdayKind, MonthlyNthWeekday, previous, dt);
+	default:
+		break;
+	}
+
+	return mark()->previous(dt);
+}
+
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+bool Event::occurrenceWindow(const DateTime & dt, Chronos::Mark::Event::Direction dir)
+{
+	if (occ_cache.state == OccurrenceCache::Unusable)
+		return false;
+
+	Chronos::EpochTime t = dt.asEpoch();
+	if (occ_cache.state == OccurrenceCache::Valid)
+	{
+		if (dir == Chronos::Mark::Event::Next)
+		{
+			if (occ_cache.prev <= t && t < occ_cache.next)
+				return true;
+		} else if (occ_cache.prev < t && t <= occ_cache.next)
+		{
+			return true;
+		}
+	}
+
+	if (occ_cache.state == OccurrenceCache::Empty && ! mark()->hasFixedOccurrences())
+	{
+		// occurrences drift with the query, never mind.
+		occ_cache.state = OccurrenceCache::Unusable;
+		return false;
+	}
+
+	// refill with the consecutive pair that has dt on the proper side
+	if (dir == Chronos::Mark::Event::Next)
 	{
-		delete t_event;
-		t_event = NULL;
+		occ_cache.next = markNext(dt).asEpoch();
+		occ_cache.prev = markPrevious(DateTime(occ_cache.next)).asEpoch();
+	} else {
+		occ_cache.prev = markPrevious(dt).asEpoch();
+		occ_cache.next = markNext(DateTime(occ_cache.prev)).asEpoch();
 	}
+	occ_cache.state = OccurrenceCache::Valid;
+	return true;
+}
+#endif
 
+DateTime Event::occurrenceAfter(const DateTime & dt)
+{
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+	if (occurrenceWindow(dt, Chronos::Mark::Event::Next))
+		return DateTime(occ_cache.next);
+#endif
+	return markNext(dt);
+}
 
+DateTime Event::occurrenceBefore(const DateTime & dt)
+{
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+	if (occurrenceWindow(dt, Chronos::Mark::Event::Previous))
+		return DateTime(occ_cache.prev);
+#endif
+	return markPrevious(dt);
 }
 
 bool Event::hasNext(const DateTime & fromDateTime) {
@@ -227,8 +577,8 @@ bool Event::hasNext(const DateTime & fromDateTime) {
 
 	}
 
-	// it is a recurring event... it must therefore have a next
-	return true;
+	// it is a recurring event... it has a next unless the series is over
+	return (fromDateTime.asEpoch() < seriesLast());
 
 }
 Event::Occurrence Event::nextOccurrence(const DateTime & fromDateTime) {
@@ -248,11 +598,14 @@ Event::Occurrence Event::nextOccurrence(const DateTime & fromDateTime) {
 
 	}
 
-	if (! t_event)
+	if (mark_kind == EVENT_MARK_NOTSET)
 		return Event::Occurrence();
 
 	// it is a recurring event...
-	DateTime nextStart(t_event->next(fromDateTime));
+	DateTime nextStart(fromDateTime);
+	if (! validNext(fromDateTime, nextStart))
+		return Event::Occurrence();
+
 	DateTime nextEnd(nextStart + duration);
 
 
@@ -274,24 +627,34 @@ Event::Occurrence Event::closestOccurrence(const DateTime & fromDateTime)
 
 	}
 
-	if (! t_event)
+	if (mark_kind == EVENT_MARK_NOTSET)
 		return Event::Occurrence();
 
-	DateTime prevStart(t_event->previous(fromDateTime));
-	DateTime prevEnd(prevStart + duration);
+	// by default, look for the next from just before dt, so one
+	// starting right at dt is included
+	DateTime searchFrom(fromDateTime - Chronos::Span::Seconds(1));
 
-	// maybe we're *in* prev occurrence
-	if (prevEnd > fromDateTime)
+	DateTime prevStart(fromDateTime);
+	if (validPrevious(fromDateTime, prevStart))
 	{
-		// yep
-		return  Event::Occurrence(event_id, prevStart, prevEnd, true);
-	}
+		DateTime prevEnd(prevStart + duration);
+
+		// maybe we're *in* prev occurrence
+		if (prevEnd > fromDateTime)
+		{
+			// yep
+			return  Event::Occurrence(event_id, prevStart, prevEnd, true);
+		}
 
-	DateTime justAfterPrevEnd(prevEnd + Chronos::Span::Seconds(1));
+		searchFrom = prevEnd + Chronos::Span::Seconds(1);
+	}
 
 
 	// nope... see the next one
-	DateTime nextStart(t_event->next(justAfterPrevEnd));
+	DateTime nextStart(searchFrom);
+	if (! validNext(searchFrom, nextStart))
+		return Event::Occurrence();
+
 	DateTime nextEnd(nextStart + duration);
 
 	return Event::Occurrence(event_id, nextStart, nextEnd, (nextStart <= fromDateTime));
@@ -299,6 +662,43 @@ Event::Occurrence Event::closestOccurrence(const DateTime & fromDateTime)
 
 }
 
+Chronos::Mark::Cursor Event::cursor(const DateTime & fromDateTime) const
+{
+	if (! (is_recurring && mark()))
+		return Chronos::Mark::Cursor();
+
+	if (fromDateTime.asEpoch() < seriesFirst())
+	{
+		// nothing before the series start
+		return mark()->cursor(DateTime(seriesFirst() - 1));
+	}
+
+	return mark()->cursor(fromDateTime);
+}
+
+Event::Occurrence Event::nextOccurrence(Chronos::Mark::Cursor & cursor) const
+{
+	if (! cursor.isValid())
+		return Event::Occurrence();
+
+	DateTime nextStart(cursor.advance());
+	while (nextStart.asEpoch() <= seriesLast() && isException(nextStart))
+	{
+		nextStart = cursor.advance();
+	}
+
+	if (nextStart.asEpoch() > seriesLast())
+	{
+		// series is over
+		return Event::Occurrence();
+	}
+
+	DateTime nextEnd(nextStart + duration);
+
+	// cursor only moves forward, strictly after its start
+	return Event::Occurrence(event_id, nextStart, nextEnd, false);
+}
+
 
 } /* namespace Chronos */
 
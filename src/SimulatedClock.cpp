@@ -0,0 +1,62 @@
+/*
+ * SimulatedClock.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/platform/timesource.h"
+
+#ifdef CHRONOS_CLOCK_SIMULATED
+
+namespace Chronos {
+
+#ifdef SIMULATEDCLOCK_ATOMIC
+std::atomic<EpochTime> SimulatedClock::current(0);
+
+void SimulatedClock::set(EpochTime epoch)
+{
+	current.store(epoch, std::memory_order_relaxed);
+}
+
+EpochTime SimulatedClock::advance(EpochTime secs)
+{
+	return current.fetch_add(secs, std::memory_order_relaxed) + secs;
+}
+
+#else
+volatile EpochTime SimulatedClock::current = 0;
+
+void SimulatedClock::set(EpochTime epoch)
+{
+	current = epoch;
+}
+
+EpochTime SimulatedClock::advance(EpochTime secs)
+{
+	current = current + secs;
+	return current;
+}
+#endif
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CLOCK_SIMULATED */
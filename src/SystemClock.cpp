@@ -0,0 +1,129 @@
+/*
+ * SystemClock.cpp
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chronosinc/platform/timesource.h"
+
+#ifdef CHRONOS_CLOCKSOURCE_POSIX
+
+#include <time.h>
+
+namespace Chronos {
+
+int64_t SystemClock::offset = 0;
+
+// day of the year each month starts on (non-leap), and the total
+static const uint16_t days_before_month[13] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};
+
+static inline bool isLeap(uint32_t year)
+{
+	return (! (year % 4)) && ((year % 100) || ! (year % 400));
+}
+
+static inline uint32_t leapsBefore(uint32_t year)
+{
+	year--;
+	return year / 4 - year / 100 + year / 400;
+}
+
+#if defined(CHRONOS_CLOCK_COARSE) && defined(CLOCK_REALTIME_COARSE)
+#define SYSTEMCLOCK_NOW_ID	CLOCK_REALTIME_COARSE
+#else
+#define SYSTEMCLOCK_NOW_ID	CLOCK_REALTIME
+#endif
+
+EpochTime SystemClock::now()
+{
+	struct timespec ts;
+	clock_gettime(SYSTEMCLOCK_NOW_ID, &ts);
+	return (EpochTime)(ts.tv_sec + offset);
+}
+
+void SystemClock::setTime(Year year, Month month, Day day, Hours hours, Minutes minutes, Seconds secs)
+{
+	TimeElements els;
+	els.Year = CalendarYrToTm(year);
+	els.Month = month;
+	els.Day = day;
+	els.Hour = hours;
+	els.Minute = minutes;
+	els.Second = secs;
+	els.Wday = 0;
+
+	struct timespec ts;
+	clock_gettime(SYSTEMCLOCK_NOW_ID, &ts);
+	offset = (int64_t)makeTime(els) - ts.tv_sec;
+}
+
+void SystemClock::breakTime(EpochTime epoch, TimeElements & elements)
+{
+	elements.Second = epoch % 60;
+	epoch /= 60;
+	elements.Minute = epoch % 60;
+	epoch /= 60;
+	elements.Hour = epoch % 24;
+	uint32_t days = epoch / 24;
+
+	elements.Wday = ((days + 4) % 7) + 1; // jan 1st 1970 was a thursday
+
+	// H. Hinnant's civil_from_days(): years counted from March 1st, so
+	// february (and its leap day) comes last
+	uint32_t z = days + 719468; // days since 0000-03-01
+	uint32_t era = z / 146097;
+	uint32_t dayOfEra = z - era * 146097;
+	uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	uint32_t mp = (5 * dayOfYear + 2) / 153;
+
+	elements.Day = dayOfYear - (153 * mp + 2) / 5 + 1;
+	elements.Month = (mp < 10) ? mp + 3 : mp - 9;
+	elements.Year = yearOfEra + era * 400 + (elements.Month <= 2) - 1970;
+}
+
+EpochTime SystemClock::makeTime(const TimeElements & elements)
+{
+	uint32_t year = tmYearToCalendar(elements.Year);
+	uint32_t days = 365UL * elements.Year + leapsBefore(year) - leapsBefore(1970);
+
+	// like the Time library: month 0 counts as january, days/hours etc past
+	// their range just carry over
+	if (elements.Month > 1)
+	{
+		uint8_t m = (elements.Month <= 13) ? elements.Month : 13;
+		days += days_before_month[m - 1];
+		if (m > 2 && isLeap(year))
+			days++;
+	}
+
+	EpochTime secs = days * SECS_PER_DAY;
+	secs += (EpochTime)(elements.Day - 1) * SECS_PER_DAY;
+	secs += elements.Hour * SECS_PER_HOUR;
+	secs += elements.Minute * SECS_PER_MIN;
+	secs += elements.Second;
+	return secs;
+}
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CLOCKSOURCE_POSIX */
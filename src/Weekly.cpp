@@ -60,6 +60,23 @@ Event * Weekly::clone()  const
 	theClone->strict_time = strict_time;
 	return theClone;
 }
+Event * Weekly::cloneInto(void * storage)  const
+{
+	Weekly * theClone = new (storage) Weekly(wday, hour, minute, sec);
+	theClone->strict_time = strict_time;
+	return theClone;
+}
+bool Weekly::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.strict_time = strict_time;
+	into.day = wday;
+	into.hour = hour;
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
 
 
 
@@ -92,6 +109,22 @@ DateTime Weekly::previous(const DateTime & dt) const {
 	return thePrev;
 
 }
+DateTime Weekly::step(const DateTime & occurrence, Direction dir) const {
+
+	if (! strict_time)
+	{
+		// no fixed time of day, occurrences follow
+		// the time of the search point: go the long way
+		return Event::step(occurrence, dir);
+	}
+
+	if (dir == Next)
+		return occurrence + SECS_PER_WEEK;
+
+	return occurrence - SECS_PER_WEEK;
+
+}
+
 DateTime Weekly::applyTo(const DateTime & dt, Direction dir) const {
 	Chronos::TimeElements els(dt.asElements());
 
@@ -44,6 +44,24 @@ Event * Yearly::clone()  const
 	return theClone;
 
 }
+Event * Yearly::cloneInto(void * storage)  const
+{
+	Yearly * theClone = new (storage) Yearly(month, day, hour, minute, sec);
+	theClone->strict_time = strict_time;
+	return theClone;
+}
+bool Yearly::params(Params & into) const
+{
+	into = Params();
+	into.kind = kind();
+	into.strict_time = strict_time;
+	into.month = month;
+	into.day = day;
+	into.hour = hour;
+	into.minute = minute;
+	into.second = sec;
+	return true;
+}
 DateTime Yearly::next(const DateTime& dt) const {
 	DateTime theNext(applyTo(dt, Next));
 
@@ -66,6 +84,29 @@ DateTime Yearly::previous(const DateTime& dt) const {
 	return thePrev;
 }
 
+DateTime Yearly::step(const DateTime& occurrence, Direction dir) const {
+
+	if (! strict_time)
+	{
+		return Event::step(occurrence, dir);
+	}
+
+	// re-apply our month/day to the adjacent year, rather than
+	// keeping the occurrence's date, which may have rolled over
+	// from feb 29th
+	Chronos::TimeElements els(occurrence.asElements());
+	if (dir == Next)
+	{
+		els.Year++;
+	} else {
+		els.Year--;
+	}
+	els.Month = month;
+	els.Day = day;
+
+	return DateTime(els);
+}
+
 DateTime Yearly::applyTo(const DateTime& dt, Direction dir) const {
 	Chronos::TimeElements els(dt.asElements());
 
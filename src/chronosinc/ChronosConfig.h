@@ -28,12 +28,26 @@
 #ifndef CHRONOS_INTINCLUDES_CHRONOSCONFIG_H_
 #define CHRONOS_INTINCLUDES_CHRONOSCONFIG_H_
 
+#if !defined(CHRONOS_PLATFORM_ARDUINO) && !defined(CHRONOS_PLATFORM_POSIX)
+#ifdef ARDUINO
+
 // CHRONOS_PLATFORM_ARDUINO -- built for Arduino SDK
 #define CHRONOS_PLATFORM_ARDUINO
 
 // CHRONOS_CLOCKSOURCE_TIMELIB -- time-keeper is Arduino Time library
 #define CHRONOS_CLOCKSOURCE_TIMELIB
 
+#else
+
+// CHRONOS_PLATFORM_POSIX -- built natively, for a Linux/BSD/macOS host
+#define CHRONOS_PLATFORM_POSIX
+
+// CHRONOS_CLOCKSOURCE_POSIX -- time-keeper is the system clock (clock_gettime)
+#define CHRONOS_CLOCKSOURCE_POSIX
+
+#endif
+#endif
+
 
 // CHRONOS_DEBUG_ENABLE -- only enable this on system's with lotsa ram.
 //define CHRONOS_DEBUG_ENABLE
@@ -42,6 +56,62 @@
 // seems to be missing for 'duino...
 //define ENABLE_UTILITY_INCLUDE
 
+// CHRONOS_EVENT_OCCURRENCE_CACHE -- have each recurring Chronos::Event remember the
+// last occurrence window it computed, so repeated queries (e.g. the Calendar polled
+// at steadily increasing times) that fall within it skip the mark search.
+// Costs 9 bytes or so per event.
+//define CHRONOS_EVENT_OCCURRENCE_CACHE
+
+// CHRONOS_CALENDAR_INDEXED_TAGS -- calendars keep a list of the events for each
+// EventTag below this value, so filtered queries (listNext(tag, ...) etc) only visit
+// those.  Costs 2 bytes per tag per calendar, and one per event slot.  Events with
+// larger tags can still be queried, through a full scan.
+#ifndef CHRONOS_CALENDAR_INDEXED_TAGS
+#define CHRONOS_CALENDAR_INDEXED_TAGS	8
+#endif
+
+// CHRONOS_CONCURRENT_CALENDAR -- make the ConcurrentCalendar available, for
+// lock-free queries from multiple threads.  Only for hosts with threads and
+// C++11 (so, with ENABLE_UTILITY_INCLUDE too).
+//define CHRONOS_CONCURRENT_CALENDAR
+
+// CHRONOS_SHARDED_CALENDAR -- make the ShardedCalendar available, to spread
+// very large calendars over a number of shards queried in parallel.  Hosts with
+// threads and C++11 only, like the ConcurrentCalendar.
+//define CHRONOS_SHARDED_CALENDAR
+
+// CHRONOS_MUTATION_QUEUE -- make the MutationQueue available, so other threads
+// can post calendar changes without locking.  Hosts with threads and C++11 only.
+//define CHRONOS_MUTATION_QUEUE
+
+// CHRONOS_COROUTINES -- make the CoScheduler available, to co_await event starts
+// and ends.  Linux hosts with C++20 only.
+//define CHRONOS_COROUTINES
+
+// CHRONOS_CALLBACK_EXECUTOR -- make the CallbackExecutor available, to run callbacks
+// for bursts of occurrences in parallel.  Hosts with threads and C++11 only.
+//define CHRONOS_CALLBACK_EXECUTOR
+
+// CHRONOS_MUTATION_LOG -- make the MutationLog available, to keep calendar changes
+// in a write-ahead log (with snapshots) and get them back after a restart.  POSIX
+// hosts only.
+//define CHRONOS_MUTATION_LOG
+
+// CHRONOS_CLOCK_CACHED -- DateTime::now() (and DateTime()) return a cached epoch,
+// instead of reading the clock each time: a plain memory load.  The cache is
+// refreshed by Chronos::CachedClock::refresh(), say once per tick of your main/
+// dispatch loop (the CoScheduler does it on each wake-up).
+//define CHRONOS_CLOCK_CACHED
+
+// CHRONOS_CLOCK_COARSE -- POSIX hosts: read CLOCK_REALTIME_COARSE, where available,
+// which is cheaper than CLOCK_REALTIME and plenty precise for whole seconds.
+//define CHRONOS_CLOCK_COARSE
+
+// CHRONOS_CLOCK_SIMULATED -- DateTime::now() (and DateTime()) return the time of the
+// Chronos::SimulatedClock, which only moves when told to (set(), advance(),
+// DateTime::setTime()...).  For tests and accelerated replays (see ScheduleReplay).
+//define CHRONOS_CLOCK_SIMULATED
+
 
 #define CHRONOS_VERSION			1
 #define CHRONOS_SUBVERSION		2
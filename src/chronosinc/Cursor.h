@@ -0,0 +1,96 @@
+/*
+ * Cursor.h
+ * Generator for successive occurrences of a time mark, obtained through
+ * Mark::Event::cursor() -- stepping along the mark is cheaper than
+ * repeatedly searching with next()/previous().
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_CURSOR_H_
+#define CHRONOS_INTINCLUDES_CURSOR_H_
+
+#include "../chronosinc/DateTime.h"
+#include "../chronosinc/Event.h"
+
+namespace Chronos {
+namespace Mark {
+
+/*
+ * Chronos::Mark::Cursor
+ *
+ * Walks a mark, one occurrence at a time:
+ *
+ *  Chronos::Mark::Daily workout(9, 0, 0);
+ *  Chronos::Mark::Cursor cursor(workout.cursor(Chronos::DateTime::now()));
+ *  for (uint8_t i=0; i<7; i++)
+ *  {
+ *  	Chronos::DateTime nextWorkout(cursor.advance());
+ *  	// ...
+ *  }
+ *
+ * The first advance() locates the first occurrence using the mark's next() (or
+ * previous()), and every following call steps from there.
+ */
+class Cursor {
+public:
+	/*
+	 * Cursor(mark, dt, forward)
+	 *
+	 * @param mark: the time mark to walk -- only a reference is kept
+	 * @param dt: the starting point, occurrences returned are strictly after (or before) it
+	 * @param forward: true to walk into the future
+	 */
+	Cursor(const Event & mark, const DateTime & dt, bool forward=true);
+
+	/*
+	 * Default constructor: a cursor with no mark, which never advances
+	 * (always returns DateTime::endOfTime()).
+	 */
+	Cursor();
+
+	/*
+	 * advance()
+	 * @return: the next occurrence of the mark along the cursor's direction.
+	 */
+	DateTime advance();
+
+	/*
+	 * current()
+	 * @return: last value returned by advance(), or the starting point if
+	 * it hasn't been called yet.
+	 */
+	inline const DateTime & current() const { return position;}
+
+	inline bool isValid() const { return mark != NULL;}
+
+private:
+	const Event * mark;
+	DateTime position;
+	bool forward;
+	bool started;
+};
+
+} /* namespace Mark */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_CURSOR_H_ */
@@ -363,6 +363,26 @@ public:
 	 */
 	void printTo(Print & p, bool includeTime=true) const;
 
+	/*
+	 * formatTo(buf, len, pattern)
+	 *
+	 * Writes the date/time into buf, according to pattern -- a subset of strftime():
+	 * 	%Y (4-digit year), %y, %m, %d, %e (space-padded day), %H, %I (12-hour),
+	 * 	%M, %S, %p (AM/PM), %b (month, e.g. "Jan"), %a (weekday, e.g. "Sun"),
+	 * 	%s (epoch seconds), %F (%Y-%m-%d), %T (%H:%M:%S), %R (%H:%M) and %%.
+	 * A '-' between the '%' and the letter drops the padding (e.g. %-d).  Anything
+	 * else is copied as is.
+	 *
+	 * Nothing is allocated and no Print is involved, so it's fit for formatting lots
+	 * of timestamps, e.g. into logs.
+	 *
+	 * @param buf: destination, always NUL-terminated (if len > 0)
+	 * @param len: size of buf -- output that doesn't fit is cut off
+	 * @param pattern: format, defaults to "2026-01-31 15:00:00" style.
+	 * @return: the number of chars written to buf, not counting the NUL.
+	 */
+	size_t formatTo(char * buf, size_t len, const char * pattern="%Y-%m-%d %H:%M:%S") const;
+
 
 	DateTime();
 
@@ -155,6 +155,18 @@ public:
 	 * @param p: the "printer" (e.g. Serial with Arduino)
 	 */
 	void printTo(Print & p) const ;
+
+	/*
+	 * formatTo(buf, len, pattern)
+	 *
+	 * Like DateTime::formatTo(), writes the span into buf according to pattern:
+	 * 	%d (days), %H, %M, %S (hours, minutes and seconds, 2 digits),
+	 * 	%s (total seconds), %T (%H:%M:%S) and %%, with the same '-' flag
+	 * 	to drop the padding.
+	 *
+	 * @return: the number of chars written to buf, not counting the NUL.
+	 */
+	size_t formatTo(char * buf, size_t len, const char * pattern="%dd %H:%M:%S") const;
 	//const Elements & elements() const ;
 private:
 	// private, I say!
@@ -32,6 +32,17 @@
 
 #include "../chronosinc/timeExtInc.h"
 #include "../chronosinc/timeTypes.h"
+#include "../chronosinc/platform/platform.h"
+
+// on hosts, marks may be shared by events on different threads (e.g. through
+// ConcurrentCalendar), so their reference counts are atomic there
+#if defined(CHRONOS_PLATFORM_POSIX) && defined(PLATFORM_SUPPORTS_RVAL_MOVE)
+#define CHRONOS_MARK_ATOMIC_REFCOUNT
+#include <atomic>
+#endif
+
+// a mark retain()ed this many times is copied instead, rather than wrap its count
+#define CHRONOS_MARK_MAX_REFERENCES		0xffff
 
 namespace Chronos {
 
@@ -39,6 +50,9 @@ class DateTime; // forward decl
 
 namespace Mark {
 
+class Cursor; // forward decl
+class Allocator; // forward decl
+
 class Event {
 public:
 	Event();
@@ -49,15 +63,163 @@ public:
 
 	virtual Event * clone() const = 0;
 
+	typedef enum {Previous=0, Next} Direction;
+
+	/*
+	 * Kind -- identifies the built-in marks, which Chronos::Events
+	 * store in place and dispatch to directly.  Anything
+	 * else is a UserDefinedKind, held through clone().
+	 */
+	typedef enum {
+		UserDefinedKind=0,
+		HourlyKind,
+		DailyKind,
+		WeeklyKind,
+		MonthlyKind,
+		YearlyKind,
+		EveryKind,
+		MonthlyNthWeekdayKind
+	} Kind;
+
+	/*
+	 * kind()
+	 * @return: the Kind of this mark -- only overridden by the built-in marks.
+	 */
+	virtual Kind kind() const { return UserDefinedKind; }
+
+	/*
+	 * hasFixedOccurrences()
+	 *
+	 * @return: true if the occurrences are fixed points on the timeline, the same no matter
+	 * which DateTime they're queried from -- e.g. Daily(9, 0, 0), but not Weekly(Weekday::Monday)
+	 * which keeps the time of day of the query.  Defaults to false, to be safe.
+	 */
+	virtual bool hasFixedOccurrences() const { return false; }
+
+	/*
+	 * isValid()
+	 *
+	 * @return: false if the mark couldn't be built as asked (e.g. a Composite given
+	 * more marks than it can hold), in which case calendars won't take events using it.
+	 */
+	virtual bool isValid() const { return true; }
+
+	/*
+	 * cloneInto(storage)
+	 *
+	 * Used internally: like clone(), but constructs the copy in the (suitably
+	 * sized and aligned) storage provided, rather than on the heap.  Only
+	 * supported by the built-in marks, returns NULL otherwise.
+	 */
+	virtual Event * cloneInto(void * storage) const { return NULL; }
+
+	/*
+	 * Params -- a built-in mark's settings, as plain data, so it can be kept
+	 * outside of any object (e.g. in a CalendarImage) and rebuilt with restoreInto().
+	 * Only the fields its kind uses are set, the rest are 0.
+	 */
+	class Params {
+	public:
+		Params() : kind(UserDefinedKind), strict_time(0), nth(0), month(0), day(0),
+				hour(0), minute(0), second(0), phase(0), period(0) {}
+
+		uint8_t kind;
+		uint8_t strict_time; // Weekly/Monthly/Yearly with a set time of day
+		int8_t nth; // MonthlyNthWeekday
+		uint8_t month;
+		uint8_t day; // of the month, or of the week
+		uint8_t hour;
+		uint8_t minute;
+		uint8_t second;
+		uint32_t phase; // Every
+		uint32_t period;
+	};
+
+	/*
+	 * params(into)
+	 * @return: true if this mark's settings were loaded into into -- only the
+	 * built-in marks support this.
+	 */
+	virtual bool params(Params & into) const { return false; }
+
+	/*
+	 * restoreInto(params, storage)
+	 *
+	 * Construct the built-in mark described by params in storage, as cloneInto() would.
+	 * @return: the mark, or NULL if params isn't for a built-in.
+	 */
+	static Event * restoreInto(const Params & params, void * storage);
+
+
+	/*
+	 * setAllocator(alloc)
+	 *
+	 * @param alloc: a Mark::Allocator (see marks/Allocator.h) to use for all subsequent
+	 * clone()s, or NULL to go back to plain heap allocations.
+	 */
+	static void setAllocator(Allocator * alloc);
+	static Allocator * allocator();
+
+	// marks get their storage from the allocator, when set
+	static void * operator new(size_t size);
+	static void operator delete(void * ptr, size_t size);
+	static inline void * operator new(size_t size, void * storage) { return storage; }
+	static inline void operator delete(void * ptr, void * storage) {}
+
+	/*
+	 * retain()/release()
+	 *
+	 * Marks are immutable once constructed, so copies of a clone() can simply
+	 * share it: each additional holder retain()s the mark, and every holder
+	 * release()s it when done -- the last release deletes it.  A new mark
+	 * starts out with a single reference, belonging to whoever created it.
+	 *
+	 * retain() returns the reference to hold, which is normally this mark, but
+	 * a fresh clone() once it already has CHRONOS_MARK_MAX_REFERENCES (or NULL,
+	 * if that clone couldn't be allocated).  The count is atomic on POSIX hosts.
+	 */
+	const Event * retain() const;
+	void release() const;
+	inline uint16_t references() const { return ref_count; }
+
 
 	void listNext(uint8_t number, DateTime into[], const DateTime & dt) const ;
 	void listPrevious(uint8_t number, DateTime into[], const DateTime & dt) const;
 
+	/*
+	 * cursor(dt)/reverseCursor(dt)
+	 *
+	 * @param dt: DateTime from which to start walking along the mark
+	 * @return: a Mark::Cursor, each call to advance() on which returns the
+	 * following (or, for reverseCursor, preceding) occurrence of the mark.
+	 *
+	 * The cursor only holds a reference to the mark, which must outlive it.
+	 */
+	Cursor cursor(const DateTime & dt) const;
+	Cursor reverseCursor(const DateTime & dt) const;
+
 protected:
-	typedef enum {Previous=0, Next} Direction;
+
+	/*
+	 * step(occurrence, dir)
+	 *
+	 * Given an actual occurrence of this mark, return the adjacent occurrence
+	 * in the direction specified.  The default just searches from one second
+	 * beyond the occurrence, marks with a known stride may override this to
+	 * skip the search.
+	 */
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
+
+	friend class Cursor;
 private:
 	Event(const Event & other);
 
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+	mutable std::atomic<uint16_t> ref_count;
+#else
+	mutable uint16_t ref_count;
+#endif
+
 
 
 
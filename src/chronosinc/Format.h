@@ -0,0 +1,83 @@
+/*
+ * Format.h
+ * Minimal, allocation-free formatting into char buffers, used internally
+ * by DateTime::formatTo() and Span::Delta::formatTo().
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_FORMAT_H_
+#define CHRONOS_INTINCLUDES_FORMAT_H_
+#include "../chronosinc/timeExtInc.h"
+
+namespace Chronos {
+
+namespace Format {
+
+/*
+ * monthShortName(month)/dayShortName(weekday)
+ * @return: 3-letter English names ("Jan", "Sun"...), NUL-terminated, "Err" when
+ * out of range.
+ */
+const char * monthShortName(uint8_t month);
+const char * dayShortName(uint8_t weekday);
+
+/*
+ * Writer -- appends to a caller's buffer of len bytes, silently dropping
+ * whatever doesn't fit, and keeps it NUL-terminated.
+ */
+class Writer {
+public:
+	Writer(char * buf, size_t len) : out(buf), room(len ? len - 1 : 0), pos(0)
+	{
+		if (len)
+			out[0] = '\0';
+	}
+
+	inline void put(char c) { if (pos < room) out[pos++] = c; }
+	void put(const char * str, size_t n);
+
+	/*
+	 * putNumber(value, minWidth, pad)
+	 * Decimal value, left-padded with pad to at least minWidth (max 10) characters.
+	 */
+	void putNumber(uint32_t value, uint8_t minWidth=1, char pad='0');
+
+	/*
+	 * finish()
+	 * @return: the number of characters in the buffer (not counting the NUL).
+	 */
+	size_t finish();
+
+	inline size_t length() const { return pos; }
+
+private:
+	char * out;
+	size_t room;
+	size_t pos;
+};
+
+} /* namespace Format */
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_FORMAT_H_ */
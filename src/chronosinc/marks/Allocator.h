@@ -0,0 +1,173 @@
+/*
+ * Allocator.h
+ *  Pluggable storage for cloned marks, and a fixed-size slab implementation.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_EVENTS_ALLOCATOR_H_
+#define CHRONOS_INTINCLUDES_EVENTS_ALLOCATOR_H_
+
+#include "../timeExtInc.h"
+#include "../Event.h"
+
+namespace Chronos {
+namespace Mark {
+
+/*
+ * Chronos::Mark::Allocator
+ *
+ * Marks that can't be stored in place in a Chronos::Event (user-defined marks,
+ * composites and their members) are copied with clone(), which allocates through
+ * the allocator set with Mark::Event::setAllocator(), if any.
+ *
+ * Whenever an allocator can't satisfy a request (returns NULL), the mark
+ * is simply created on the heap instead.
+ *
+ * On POSIX hosts, marks are cloned and released by whichever thread copies or
+ * drops an event (e.g. through a ConcurrentCalendar, ShardedCalendar or
+ * MutationQueue), so allocators must be thread-safe there.
+ */
+class Allocator {
+public:
+	virtual ~Allocator() {}
+
+	/*
+	 * allocate(size)
+	 * @return: storage for a mark of size bytes, or NULL.
+	 */
+	virtual void * allocate(size_t size) = 0;
+
+	/*
+	 * owns(ptr)
+	 * @return: true if ptr was handed out by this allocator.
+	 */
+	virtual bool owns(const void * ptr) const = 0;
+
+	/*
+	 * deallocate(ptr, size)
+	 * Return storage handed out by allocate().
+	 */
+	virtual void deallocate(void * ptr, size_t size) = 0;
+};
+
+/*
+ * Chronos::Mark::SlabAllocator<SLOTSIZE, NUMSLOTS>
+ *
+ * NUMSLOTS fixed slots of (at least) SLOTSIZE bytes, kept on a free list
+ * so allocations and releases are a couple of pointer moves.
+ *
+ * 	Chronos::Mark::SlabAllocator<sizeof(MyMark), 10> markSlab;
+ *
+ * 	void setup() {
+ * 		Chronos::Mark::Event::setAllocator(&markSlab);
+ * 		...
+ * 	}
+ *
+ * The slab must outlive any mark it holds, so set it up before populating calendars
+ * and don't switch allocators while they still hold marks.  On POSIX hosts, the
+ * free list is behind a spinlock (held for a couple of pointer moves), so marks
+ * may come and go from any thread.
+ */
+template<size_t SLOTSIZE, uint8_t NUMSLOTS>
+class SlabAllocator : public Allocator {
+public:
+	SlabAllocator() : free_list(NULL), num_used(0)
+	{
+		for (uint8_t i=NUMSLOTS; i > 0; i--)
+		{
+			slots[i - 1].next = free_list;
+			free_list = &(slots[i - 1]);
+		}
+	}
+
+	virtual void * allocate(size_t size)
+	{
+		if (size > sizeof(Slot))
+			return NULL;
+
+		Lock lock(*this);
+		Slot * slot = free_list;
+		if (! slot)
+			return NULL;
+
+		free_list = slot->next;
+		num_used++;
+		return slot;
+	}
+
+	virtual bool owns(const void * ptr) const
+	{
+		return (ptr >= (const void*)slots && ptr < (const void*)(slots + NUMSLOTS));
+	}
+
+	virtual void deallocate(void * ptr, size_t size)
+	{
+		Slot * slot = (Slot*)ptr;
+		Lock lock(*this);
+		slot->next = free_list;
+		free_list = slot;
+		num_used--;
+	}
+
+	inline uint8_t used() const { Lock lock(*this); return num_used;}
+	inline uint8_t available() const { Lock lock(*this); return NUMSLOTS - num_used;}
+
+private:
+	class Lock {
+	public:
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+		Lock(const SlabAllocator & slab) : flag(slab.lock_flag)
+		{
+			while (flag.test_and_set(std::memory_order_acquire))
+			{
+			}
+		}
+		~Lock() { flag.clear(std::memory_order_release); }
+	private:
+		std::atomic_flag & flag;
+#else
+		Lock(const SlabAllocator & slab) {}
+#endif
+	};
+
+	union Slot {
+		Slot * next;
+		uint8_t bytes[SLOTSIZE];
+		// alignment
+		void * p_align;
+		long l_align;
+		double d_align;
+	};
+
+	Slot slots[NUMSLOTS];
+	Slot * free_list;
+	uint8_t num_used;
+#ifdef CHRONOS_MARK_ATOMIC_REFCOUNT
+	mutable std::atomic_flag lock_flag = ATOMIC_FLAG_INIT;
+#endif
+};
+
+} /* namespace Mark */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_EVENTS_ALLOCATOR_H_ */
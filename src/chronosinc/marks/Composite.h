@@ -0,0 +1,162 @@
+/*
+ * Composite.h
+ *  Time marks built out of other marks: the union, intersection or
+ *  exclusion of their sets of occurrences.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_EVENTS_COMPOSITE_H_
+#define CHRONOS_INTINCLUDES_EVENTS_COMPOSITE_H_
+
+#include "../DateTime.h"
+#include "../Event.h"
+
+// CHRONOS_MARK_COMPOSITE_MAX -- max number of marks a composite may combine
+// (composites may be nested, if you need more).
+#ifndef CHRONOS_MARK_COMPOSITE_MAX
+#define CHRONOS_MARK_COMPOSITE_MAX		7
+#endif
+
+// CHRONOS_MARK_COMPOSITE_MAX_LEAPS -- how far searches through an intersection
+// or exclusion may go before giving up (e.g. when intersecting disjoint marks).
+#ifndef CHRONOS_MARK_COMPOSITE_MAX_LEAPS
+#define CHRONOS_MARK_COMPOSITE_MAX_LEAPS	1000
+#endif
+
+namespace Chronos {
+namespace Mark {
+
+/*
+ * Chronos::Mark::Composite
+ *
+ * Base class for the combinators below.  A composite holds its own clone()s of
+ * the marks it combines, so the originals need not stay around.  Copies of a
+ * composite share those clones.
+ *
+ * A composite that couldn't keep every mark it was given -- more than
+ * CHRONOS_MARK_COMPOSITE_MAX, a NULL entry, or a clone that failed -- isn't
+ * isValid(), and calendars refuse events using it rather than follow a
+ * different rule than the one asked for.
+ *
+ * Occurrences are points in time, so they are combined exactly: a Daily(9,0,0) and
+ * a Weekly(Chronos::Weekday::Monday, 9, 0, 0) intersect on mondays, but a
+ * Weekly(Chronos::Weekday::Monday) -- which has no fixed time of day -- won't
+ * reliably intersect with anything.
+ */
+class Composite : public Event {
+public:
+	virtual ~Composite();
+
+	inline uint8_t numMarks() const { return num_marks;}
+	virtual bool isValid() const { return valid; }
+
+protected:
+	Composite(const Event & a, const Event & b);
+	Composite(const Event * const markList[], uint8_t num);
+	Composite(const Composite & other);
+
+	// does the mark have an occurrence exactly at dt?
+	static bool occursAt(const Event & mark, const DateTime & dt);
+
+	// keep a clone (or shared reference) of mark, if it's all there
+	void hold(const Event * mark);
+
+	const Event * marks[CHRONOS_MARK_COMPOSITE_MAX];
+	uint8_t num_marks;
+	bool valid;
+
+private:
+	Composite & operator=(const Composite & other);
+};
+
+/*
+ * Chronos::Mark::Union
+ *
+ * Occurs whenever any of its marks does, e.g. the 1st and 15th of each month:
+ *
+ * 	Chronos::Mark::Union(Chronos::Mark::Monthly(1, 8, 0, 0), Chronos::Mark::Monthly(15, 8, 0, 0))
+ *
+ * or, for more than two marks, from a list:
+ *
+ * 	Chronos::Mark::Weekly mon(Chronos::Weekday::Monday, 9, 0, 0);
+ * 	...
+ * 	const Chronos::Mark::Event * weekdays[] = {&mon, &tue, &wed, &thu, &fri};
+ * 	Chronos::Mark::Union weekdaysAtNine(weekdays, 5);
+ */
+class Union : public Composite {
+public:
+	Union(const Event & a, const Event & b);
+	Union(const Event * const markList[], uint8_t num);
+
+	virtual DateTime next(const DateTime & dt) const;
+	virtual DateTime previous(const DateTime & dt)  const;
+	virtual Event * clone()  const;
+	virtual bool hasFixedOccurrences() const;
+};
+
+/*
+ * Chronos::Mark::Intersect
+ *
+ * Occurs only when all of its marks do, e.g. friday the 13th, at noon:
+ *
+ * 	Chronos::Mark::Intersect(Chronos::Mark::Monthly(13, 12, 0, 0),
+ * 				Chronos::Mark::Weekly(Chronos::Weekday::Friday, 12, 0, 0))
+ *
+ * Searches leapfrog from one mark's occurrence to the next, and give up
+ * (returning DateTime::endOfTime() for next(), the epoch for previous())
+ * after CHRONOS_MARK_COMPOSITE_MAX_LEAPS unsuccessful jumps.
+ */
+class Intersect : public Composite {
+public:
+	Intersect(const Event & a, const Event & b);
+	Intersect(const Event * const markList[], uint8_t num);
+
+	virtual DateTime next(const DateTime & dt) const;
+	virtual DateTime previous(const DateTime & dt)  const;
+	virtual Event * clone()  const;
+};
+
+/*
+ * Chronos::Mark::Except
+ *
+ * Occurs whenever the base mark does, unless the excluded mark occurs
+ * at the same time, e.g. every day at 09h00, except on Christmas:
+ *
+ * 	Chronos::Mark::Except(Chronos::Mark::Daily(9, 0, 0),
+ * 				Chronos::Mark::Yearly(12, 25, 9, 0, 0))
+ *
+ * The excluded mark will often be a Union (of holidays, say).
+ */
+class Except : public Composite {
+public:
+	Except(const Event & base, const Event & excluded);
+
+	virtual DateTime next(const DateTime & dt) const;
+	virtual DateTime previous(const DateTime & dt)  const;
+	virtual Event * clone()  const;
+};
+
+} /* namespace Mark */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_EVENTS_COMPOSITE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Every.h
+ *  A time mark recurring at a fixed interval, e.g. every 90 seconds,
+ *  or every 5 minutes from 00:02.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_EVENTS_EVERY_H_
+#define CHRONOS_INTINCLUDES_EVENTS_EVERY_H_
+
+#include "../DateTime.h"
+#include "../Delta.h"
+#include "../Event.h"
+
+namespace Chronos {
+namespace Mark {
+
+/*
+ * Chronos::Mark::Every
+ *
+ * Occurs every period, in step with the anchor -- the anchor only sets the phase, so
+ * there are occurrences before it as well as after:
+ *
+ * 	// every 90 seconds
+ * 	Chronos::Mark::Every(Chronos::Span::Seconds(90))
+ * 	// every 5 minutes, at 00:02, 00:07, 00:12...
+ * 	Chronos::Mark::Every(Chronos::DateTime(2016, 1, 1, 0, 2), Chronos::Span::Minutes(5))
+ *
+ * Everything here is plain arithmetic on the epoch, no element breakdowns or searches.
+ * Past the last occurrence before DateTime::endOfTime(), next() and nth() return
+ * endOfTime(), like the other marks.
+ */
+class Every : public Event {
+public:
+	Every(const Chronos::Span::Delta & period);
+	Every(const DateTime & anchor, const Chronos::Span::Delta & period);
+
+	virtual DateTime next(const DateTime & dt) const;
+	virtual DateTime previous(const DateTime & dt)  const;
+	virtual Event * clone()  const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return EveryKind; }
+	virtual bool hasFixedOccurrences() const { return true; }
+
+	/*
+	 * count(from, until)
+	 *
+	 * @return: number of occurrences strictly after from, up to and including until.
+	 */
+	uint32_t count(const DateTime & from, const DateTime & until) const;
+
+	/*
+	 * nth(n, dt)
+	 *
+	 * @return: the nth occurrence after dt, so nth(1, dt) == next(dt).
+	 */
+	DateTime nth(uint32_t n, const DateTime & dt) const;
+
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
+
+private:
+	Every(Chronos::EpochTime phaseSecs, Chronos::EpochTime periodSecs);
+
+	// index of the last occurrence at or before epoch (the first is index 0)
+	inline Chronos::EpochTime indexAtOrBefore(Chronos::EpochTime epoch) const { return (epoch - phase) / period; }
+
+	// the occurrence with that index, or endOfTime() if it's past it
+	DateTime atIndex(Chronos::EpochTime index) const;
+
+	Chronos::EpochTime phase; // first occurrence since the start of the epoch
+	Chronos::EpochTime period;
+};
+
+} /* namespace Mark */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_EVENTS_EVERY_H_ */
@@ -40,6 +40,13 @@ public:
 	virtual DateTime next(const DateTime & dt) const;
 	virtual DateTime previous(const DateTime & dt)  const;
 	virtual Event * clone()  const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return HourlyKind; }
+	virtual bool hasFixedOccurrences() const { return true; }
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
+
 private:
 
 	DateTime applyTo(const DateTime & dt) const;
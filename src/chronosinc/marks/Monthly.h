@@ -43,6 +43,27 @@ public:
 	virtual DateTime previous(const DateTime & dt)  const;
 
 	virtual Event * clone()  const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return MonthlyKind; }
+	virtual bool hasFixedOccurrences() const { return strict_time; }
+
+	/*
+	 * daysInMonth(tmYear, month)
+	 * @param tmYear: year, as an offset from 1970 (as in TimeElements)
+	 * @return: number of days in that month
+	 */
+	static uint8_t daysInMonth(uint8_t tmYear, Month month);
+
+	/*
+	 * shiftMonth(els, forward)
+	 * Moves els to the following (or preceding) month, wrapping years as required.
+	 * Only the Month and Year elements are touched.
+	 */
+	static void shiftMonth(Chronos::TimeElements & els, bool forward);
+
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
 
 private:
 	DateTime applyTo(const DateTime & dt, Direction dir) const;
@@ -0,0 +1,84 @@
+/*
+ * MonthlyNthWeekday.h
+ *  Time mark for the nth (or nth-last) given weekday of every month, e.g.
+ *  the second Tuesday or the last Friday.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ * 
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ * 
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ * 
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_EVENTS_MONTHLYNTHWEEKDAY_H_
+#define CHRONOS_INTINCLUDES_EVENTS_MONTHLYNTHWEEKDAY_H_
+
+#include "../DateTime.h"
+#include "../Event.h"
+#include "../timeTypes.h"
+
+namespace Chronos {
+namespace Mark {
+
+/*
+ * Chronos::Mark::MonthlyNthWeekday
+ *
+ * The nth weekday of the month, counting from the start of the month for n > 0
+ * and from its end for n < 0:
+ *
+ * 	// second Tuesday, at 19h30
+ * 	Chronos::Mark::MonthlyNthWeekday(2, Chronos::Weekday::Tuesday, 19, 30)
+ * 	// last Friday, at 17h00
+ * 	Chronos::Mark::MonthlyNthWeekday(-1, Chronos::Weekday::Friday, 17)
+ *
+ * n is kept within [-5, 5] (0 is taken as 1).  Months that don't have a fifth
+ * such weekday are skipped.
+ */
+class MonthlyNthWeekday : public Event {
+public:
+	MonthlyNthWeekday(int8_t n, Chronos::Weekday::Day day, Hours hour=0, Minutes min=0, Seconds secs=0);
+
+	virtual DateTime next(const DateTime & dt) const;
+	virtual DateTime previous(const DateTime & dt)  const;
+
+	virtual Event * clone()  const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return MonthlyNthWeekdayKind; }
+	virtual bool hasFixedOccurrences() const { return true; }
+
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
+
+private:
+	DateTime applyTo(const DateTime & dt, Direction dir) const;
+
+	// sets into to the occurrence within the month of els, returns false if it has none
+	bool occurrenceIn(const Chronos::TimeElements & els, DateTime & into) const;
+
+	int8_t nth;
+	WeekDay wday;
+	Hours hour;
+	Minutes minute;
+	Seconds sec;
+};
+
+} /* namespace Mark */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_EVENTS_MONTHLYNTHWEEKDAY_H_ */
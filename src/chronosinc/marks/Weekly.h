@@ -45,8 +45,15 @@ public:
 	virtual DateTime previous(const DateTime & dt)  const;
 
 	virtual Event * clone()  const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return WeeklyKind; }
+	virtual bool hasFixedOccurrences() const { return strict_time; }
 
 
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
+
 private:
 
 
@@ -47,6 +47,13 @@ public:
 
 
 	virtual Event * clone() const;
+	virtual Event * cloneInto(void * storage) const;
+	virtual bool params(Params & into) const;
+	virtual Kind kind() const { return YearlyKind; }
+	virtual bool hasFixedOccurrences() const { return strict_time; }
+
+protected:
+	virtual DateTime step(const DateTime & occurrence, Direction dir) const;
 
 private:
 	DateTime applyTo(const DateTime & dt, Direction dir) const;
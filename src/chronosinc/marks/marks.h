@@ -34,6 +34,24 @@
 #include "../../chronosinc/marks/Weekly.h"
 #include "../../chronosinc/marks/Monthly.h"
 #include "../../chronosinc/marks/Yearly.h"
+#include "../../chronosinc/marks/Every.h"
+#include "../../chronosinc/marks/MonthlyNthWeekday.h"
+#include "../../chronosinc/marks/Composite.h"
+#include "../../chronosinc/Cursor.h"
+#include "../../chronosinc/marks/Allocator.h"
+
+
+#define CHRONOS_SIZEMAX(a, b)	((a) > (b) ? (a) : (b))
+
+// CHRONOS_MARK_INLINE_SIZE -- room needed to hold any of the
+// built-in marks, which Chronos::Events keep in place, off the heap.
+#define CHRONOS_MARK_INLINE_SIZE	CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Hourly), \
+									CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Daily), \
+									CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Weekly), \
+									CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Monthly), \
+									CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Yearly), \
+									CHRONOS_SIZEMAX(sizeof(Chronos::Mark::Every), \
+													sizeof(Chronos::Mark::MonthlyNthWeekday)))))))
 
 
 #endif /* CHRONOS_INTINCLUDES_MARK_EVENTS_H_ */
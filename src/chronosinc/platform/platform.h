@@ -32,6 +32,8 @@
 
 #ifdef CHRONOS_PLATFORM_ARDUINO
 #include "../../chronosinc/platform/platformArduino.h"
+#elif defined(CHRONOS_PLATFORM_POSIX)
+#include "../../chronosinc/platform/platformPOSIX.h"
 #else
 #error "You MUST specify a supported CHRONOS_PLATFORM_* in ChronosConfig.h"
 #endif
@@ -42,5 +42,12 @@
 
 #define CHRONOS_DELAY_MS(t)		delay(t)
 
+// placement new, used to keep marks in place within events
+#ifdef __AVR__
+#include <new.h>
+#else
+#include <new>
+#endif
+
 
 #endif /* CHRONOS_INTINCLUDES_PLATFORM_PLATFORMARDUINO_H_ */
@@ -0,0 +1,52 @@
+/*
+ * platformPOSIX.h
+ * Native builds, on Linux/BSD/macOS hosts.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_PLATFORM_PLATFORMPOSIX_H_
+#define CHRONOS_INTINCLUDES_PLATFORM_PLATFORMPOSIX_H_
+
+#include "../ChronosConfig.h"
+#include "../../chronosinc/platform/printPOSIX.h"
+
+#include <unistd.h>
+
+#define CHRONOS_DEBUG_SERIAL_DEVICE		Chronos::Platform::StdioPrint::err()
+
+#ifdef CHRONOS_DEBUG_ENABLE
+#define CHRONOS_DEBUG_OUT(...)		CHRONOS_DEBUG_SERIAL_DEVICE.print(__VA_ARGS__)
+#define CHRONOS_DEBUG_OUTLN(...)	CHRONOS_DEBUG_SERIAL_DEVICE.println(__VA_ARGS__)
+#define CHRONOS_DEBUG_OUTINT(v)		CHRONOS_DEBUG_SERIAL_DEVICE.print((int)(v))
+#define CHRONOS_DEBUG_OUTHEX(v)		CHRONOS_DEBUG_SERIAL_DEVICE.print((unsigned long)(v), HEX)
+
+#endif
+
+
+#define CHRONOS_DELAY_MS(t)		usleep((t) * 1000UL)
+
+// placement new, used to keep marks in place within events
+#include <new>
+
+
+#endif /* CHRONOS_INTINCLUDES_PLATFORM_PLATFORMPOSIX_H_ */
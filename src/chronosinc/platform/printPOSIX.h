@@ -0,0 +1,114 @@
+/*
+ * printPOSIX.h
+ * Stand-in for the Arduino Print class, so printTo() and debug output
+ * work on POSIX hosts.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_PLATFORM_PRINTPOSIX_H_
+#define CHRONOS_INTINCLUDES_PLATFORM_PRINTPOSIX_H_
+
+#include "../ChronosConfig.h"
+
+#ifdef CHRONOS_PLATFORM_POSIX
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifndef DEC
+#define DEC	10
+#define HEX	16
+#define OCT	8
+#define BIN	2
+#endif
+
+/*
+ * Print
+ *
+ * Same interface as Arduino's (the parts Chronos uses, and a bit): derive from
+ * it, implement write(uint8_t) -- and write(buffer, size), if you can do better
+ * than one byte at a time -- and pass it to DateTime::printTo() & co:
+ *
+ * 	Chronos::DateTime::now().printTo(Chronos::Platform::StdioPrint::out());
+ *
+ */
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t * buffer, size_t size);
+	size_t write(const char * str);
+
+	size_t print(const char str[]);
+	size_t print(char c);
+	size_t print(unsigned char v, int base=DEC);
+	size_t print(int v, int base=DEC);
+	size_t print(unsigned int v, int base=DEC);
+	size_t print(long v, int base=DEC);
+	size_t print(unsigned long v, int base=DEC);
+
+	size_t println();
+	size_t println(const char str[]);
+	size_t println(char c);
+	size_t println(unsigned char v, int base=DEC);
+	size_t println(int v, int base=DEC);
+	size_t println(unsigned int v, int base=DEC);
+	size_t println(long v, int base=DEC);
+	size_t println(unsigned long v, int base=DEC);
+
+private:
+	size_t printNumber(unsigned long v, uint8_t base);
+};
+
+namespace Chronos {
+namespace Platform {
+
+/*
+ * StdioPrint -- a Print that writes to a stdio FILE.
+ */
+class StdioPrint : public Print {
+public:
+	StdioPrint(FILE * f) : file(f) {}
+
+	virtual size_t write(uint8_t c);
+	virtual size_t write(const uint8_t * buffer, size_t size);
+	using Print::write;
+
+	/*
+	 * out()/err() -- on stdout and stderr
+	 */
+	static StdioPrint & out();
+	static StdioPrint & err();
+
+private:
+	FILE * file;
+};
+
+} /* namespace Platform */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_PLATFORM_POSIX */
+
+#endif /* CHRONOS_INTINCLUDES_PLATFORM_PRINTPOSIX_H_ */
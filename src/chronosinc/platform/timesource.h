@@ -1,7 +1,7 @@
 /*
  * timesource.h
- * Main header used to select time source include.  Currently, only the
- * Arduino Time library is supported.
+ * Main header used to select time source include: the Arduino Time library,
+ * or the system clock on POSIX hosts.
  *
  *  http://flyingcarsandstuff.com/projects/chronos
  *  Created on: Dec 20, 2015
@@ -34,13 +34,26 @@
 
 #ifdef CHRONOS_CLOCKSOURCE_TIMELIB
 #include "../../chronosinc/platform/timesourceTimelib.h"
+#elif defined(CHRONOS_CLOCKSOURCE_POSIX)
+#include "../../chronosinc/platform/timesourcePOSIX.h"
 #else
 #error "You MUST define a DATETIME_CLOCKSOURCE_* in ChronosConfig.h"
 
 #endif
 
-#ifndef DATETIME_GET_CURRENT_EPOCH
-#error "Selected clocksource didn't set DATETIME_GET_CURRENT_EPOCH??"
+#ifndef DATETIME_READ_CLOCK_EPOCH
+#error "Selected clocksource didn't set DATETIME_READ_CLOCK_EPOCH??"
+#endif
+
+// "now", as far as DateTime is concerned: straight from the clock, cached or simulated
+#if defined(CHRONOS_CLOCK_SIMULATED)
+#include "../../chronosinc/platform/timesourceSimulated.h"
+#define DATETIME_GET_CURRENT_EPOCH()		Chronos::SimulatedClock::now()
+#elif defined(CHRONOS_CLOCK_CACHED)
+#include "../../chronosinc/platform/timesourceCached.h"
+#define DATETIME_GET_CURRENT_EPOCH()		Chronos::CachedClock::now()
+#else
+#define DATETIME_GET_CURRENT_EPOCH()		DATETIME_READ_CLOCK_EPOCH()
 #endif
 
 #endif /* CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCE_H_ */
@@ -0,0 +1,88 @@
+/*
+ * timesourceCached.h
+ * A cached "now", refreshed on demand, in front of whichever clock
+ * source is selected.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCECACHED_H_
+#define CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCECACHED_H_
+
+#include "../ChronosConfig.h"
+#include "../../chronosinc/timeTypes.h"
+
+#ifdef CHRONOS_CLOCK_CACHED
+
+#if defined(CHRONOS_PLATFORM_POSIX) && (__cplusplus >= 201103L)
+#include <atomic>
+#define CACHEDCLOCK_ATOMIC
+#endif
+
+namespace Chronos {
+
+/*
+ * CachedClock
+ *
+ * With CHRONOS_CLOCK_CACHED, DateTime::now() and DateTime() read the epoch kept
+ * here rather than the clock.  It only moves when refresh()ed:
+ *
+ * 	void loop() {
+ * 		Chronos::CachedClock::refresh(); // one clock read per tick...
+ * 		dispatchEvents(); // ... however many DateTime::now()s in here
+ * 	}
+ *
+ * The cache is process-wide: one thread's refresh() is seen by all (a relaxed
+ * atomic, on hosts with C++11).  Until the first refresh(), now() reads the clock.
+ */
+class CachedClock {
+public:
+	static inline EpochTime now()
+	{
+#ifdef CACHEDCLOCK_ATOMIC
+		EpochTime t = cached.load(std::memory_order_relaxed);
+#else
+		EpochTime t = cached;
+#endif
+		return t ? t : refresh();
+	}
+
+	/*
+	 * refresh()
+	 * Read the clock into the cache.
+	 * @return: the new "now"
+	 */
+	static EpochTime refresh();
+
+private:
+#ifdef CACHEDCLOCK_ATOMIC
+	static std::atomic<EpochTime> cached;
+#else
+	static volatile EpochTime cached;
+#endif
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CLOCK_CACHED */
+
+#endif /* CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCECACHED_H_ */
@@ -0,0 +1,79 @@
+/*
+ * timesourcePOSIX.h
+ * Time-keeping and epoch <-> elements conversions on POSIX hosts, using
+ * the system clock.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCEPOSIX_H_
+#define CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCEPOSIX_H_
+
+#include "../ChronosConfig.h"
+#include "../../chronosinc/timeTypes.h"
+
+#ifdef CHRONOS_CLOCKSOURCE_POSIX
+
+namespace Chronos {
+
+/*
+ * SystemClock
+ *
+ * Chronos' notion of "now", on POSIX hosts: clock_gettime(CLOCK_REALTIME, or
+ * CLOCK_REALTIME_COARSE with CHRONOS_CLOCK_COARSE), so
+ * UTC, unless moved by DateTime::setTime() -- which doesn't touch the system
+ * clock, it only shifts what Chronos reads from it (for this process).
+ *
+ * The conversions are the Time library's, in closed form (no per-year or
+ * per-month loops).
+ */
+class SystemClock {
+public:
+	static EpochTime now();
+	static void setTime(Year year, Month month, Day day, Hours hours, Minutes minutes, Seconds secs);
+
+	static void breakTime(EpochTime epoch, TimeElements & elements);
+	static EpochTime makeTime(const TimeElements & elements);
+
+private:
+	static int64_t offset; // setTime() - system clock, in seconds
+};
+
+} /* namespace Chronos */
+
+
+#define DATETIME_READ_CLOCK_EPOCH()		Chronos::SystemClock::now()
+
+
+#define DATETIME_SET_CURRENT_TIME(year, month, day, hours, minutes, seconds) \
+	Chronos::SystemClock::setTime(year, month, day, hours, minutes, seconds);
+
+
+#define DATETIME_CONVERT_EPOCH_INTO_TIMELEMENTS(epoch, elements) \
+	Chronos::SystemClock::breakTime(epoch, elements);
+
+#define DATETIME_CONVERT_TIMELEMENTS_TO_EPOCH(elements) \
+		Chronos::SystemClock::makeTime(elements);
+
+#endif /* CHRONOS_CLOCKSOURCE_POSIX */
+
+#endif /* CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCEPOSIX_H_ */
@@ -0,0 +1,91 @@
+/*
+ * timesourceSimulated.h
+ * A simulated "now", moved programmatically, for replaying schedules
+ * faster than real time.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCESIMULATED_H_
+#define CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCESIMULATED_H_
+
+#include "../ChronosConfig.h"
+#include "../../chronosinc/timeTypes.h"
+
+#ifdef CHRONOS_CLOCK_SIMULATED
+
+#if defined(CHRONOS_PLATFORM_POSIX) && (__cplusplus >= 201103L)
+#include <atomic>
+#define SIMULATEDCLOCK_ATOMIC
+#endif
+
+namespace Chronos {
+
+/*
+ * SimulatedClock
+ *
+ * With CHRONOS_CLOCK_SIMULATED, DateTime::now() and DateTime() read the epoch kept
+ * here and the clock source is only used for conversions.  Time stands still
+ * until moved:
+ *
+ * 	Chronos::SimulatedClock::set(Chronos::DateTime(2026, 1, 1).asEpoch());
+ * 	...
+ * 	Chronos::SimulatedClock::advance(Chronos::Span::Hours(2).totalSeconds());
+ *
+ * DateTime::setTime() sets it too.  The ScheduleReplay and the CoScheduler jump
+ * it from one event start/end to the next, rather than waiting.
+ */
+class SimulatedClock {
+public:
+	static inline EpochTime now()
+	{
+#ifdef SIMULATEDCLOCK_ATOMIC
+		return current.load(std::memory_order_relaxed);
+#else
+		return current;
+#endif
+	}
+
+	/*
+	 * set(epoch) -- jump to epoch (backwards, too)
+	 */
+	static void set(EpochTime epoch);
+
+	/*
+	 * advance(secs) -- move secs forward
+	 * @return: the new "now"
+	 */
+	static EpochTime advance(EpochTime secs);
+
+private:
+#ifdef SIMULATEDCLOCK_ATOMIC
+	static std::atomic<EpochTime> current;
+#else
+	static volatile EpochTime current;
+#endif
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CLOCK_SIMULATED */
+
+#endif /* CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCESIMULATED_H_ */
@@ -28,11 +28,11 @@
 #ifndef CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCETIMELIB_H_
 #define CHRONOS_INTINCLUDES_PLATFORM_TIMESOURCETIMELIB_H_
 
-#define DATETIME_GET_CURRENT_EPOCH()		::now()
+#define DATETIME_READ_CLOCK_EPOCH()		::now()
 
 
 #define DATETIME_SET_CURRENT_TIME(year, month, day, hours, minutes, seconds) \
-	::setTime(hours, minutes, secs, day, month, year);
+	::setTime(hours, minutes, seconds, day, month, year);
 
 
 #define DATETIME_CONVERT_EPOCH_INTO_TIMELEMENTS(epoch, elements) \
@@ -41,7 +41,6 @@
 #define DATETIME_CONVERT_TIMELEMENTS_TO_EPOCH(elements) \
 		::makeTime(elements);
 
-
 /*
 #define DATETIME_CONVERT_EPOCH_INTO_TIMELEMENTS(epoch, elements) \
 	Chronos::Calculator::breakTime(epoch, elements);
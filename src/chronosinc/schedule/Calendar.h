@@ -55,6 +55,9 @@
  */
 #define DefineCalendarType(name, num)		typedef	Chronos::CalendarStaticArray<num> name;
 
+// end-of-list marker, for the per-tag slot lists
+#define CALENDAR_SLOT_NONE		0xff
+
 
 namespace Chronos {
 
@@ -86,17 +89,57 @@ public:
 	 * @param eventId: the EventID to search for
 	 * @return success: event was found and removed
 	 */
-	bool remove(EventID evId);
+	virtual bool remove(EventID evId);
 
 	/*
 	 * add(event) -- add an event to the calendar.
 	 * @param event: the Chronos::Event to add
-	 * @return success: returns true if there was enough room in the calendar for this event.
+	 * @return success: returns true if there was enough room in the calendar for this event,
+	 * and it isValid().
 	 */
-	bool add(const Chronos::Event & event);
+	virtual bool add(const Chronos::Event & event);
 #ifdef PLATFORM_SUPPORTS_RVAL_MOVE
 	// rvalue move
-	bool add(Chronos::Event&& event);
+	virtual bool add(Chronos::Event&& event);
+#endif
+
+	/*
+	 * emplace(id, start, end) -- add a one-time event to the calendar, building
+	 * it right in its slot rather than copying it in.
+	 * @return success: returns true if there was enough room in the calendar for this event.
+	 */
+	virtual bool emplace(EventID id, const DateTime & start, const DateTime & end);
+
+#ifdef PLATFORM_SUPPORTS_RVAL_MOVE
+	/*
+	 * emplace<MarkType>(id, duration, markArgs...) -- add a recurring event to the calendar,
+	 * constructing it, and its MarkType mark, right in its slot:
+	 *
+	 * 	MyCalendar.emplace<Chronos::Mark::Weekly>(4, Chronos::Span::Hours(1),
+	 * 											Chronos::Weekday::Monday, 10, 30, 0);
+	 *
+	 * @return success: returns true if there was enough room in the calendar for this event,
+	 * and it isValid().
+	 */
+	template<class MarkType, class... MarkArgs>
+	bool emplace(EventID id, const Chronos::Span::Delta & duration, MarkArgs&&... markArgs)
+	{
+		Chronos::Event * evt = claimSlot(true);
+		if (NULL == evt)
+			return false;
+
+		evt->set<MarkType>(id, duration, std::forward<MarkArgs>(markArgs)...);
+		if (! evt->isValid())
+		{
+			// give the slot back
+			num_events--;
+			num_recurring--;
+			return false;
+		}
+
+		indexSlot(num_events - 1);
+		return true;
+	}
 #endif
 
 	/*
@@ -105,7 +148,25 @@ public:
 	 * Empty the calendar of all events add()ed.
 	 *
 	 */
-	void clear();
+	virtual void clear();
+
+	/*
+	 * setTag(eventId, tag) -- (re)categorize events already in the calendar.
+	 * @param eventId: the EventID to search for (all events with that id are tagged)
+	 * @param tag: the new EventTag
+	 * @return success: at least one event was found
+	 */
+	virtual bool setTag(EventID evId, EventTag tag);
+
+	/*
+	 * beginUpdate()/endUpdate()
+	 *
+	 * Bracket a batch of add()/remove()/setTag() calls, so the tag index is rebuilt
+	 * once, in endUpdate(), rather than after each removal.  Batches may be nested.
+	 * Tagged queries made during a batch still work, through a full scan.
+	 */
+	void beginUpdate();
+	void endUpdate();
 
 
 	/*
@@ -122,7 +183,15 @@ public:
 	 *
 	 * @note: At return, Occurrences [0, returnValue] will be set in intoArray, and sorted by start DateTime
 	 */
-	uint8_t listOngoing(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) ;
+	virtual uint8_t listOngoing(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) ;
+
+	/*
+	 * listOngoing(tag, maxNumber, intoArray, dt)
+	 *
+	 * Same as above, but only for events with the specified EventTag.  Only those are visited,
+	 * so the whole of intoArray is available to them.
+	 */
+	virtual uint8_t listOngoing(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) ;
 
 	/*
 	 * listNext(maxNumber, intoArray, dt)
@@ -138,7 +207,17 @@ public:
 	 *
 	 * @note: At return, Occurrences [0, returnValue] will be set in intoArray, and sorted by start DateTime
 	 */
-	uint8_t listNext(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt);
+	virtual uint8_t listNext(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt);
+
+	/*
+	 * listNext(tag, maxNumber, intoArray, dt)
+	 *
+	 * Same as above, but only for events with the specified EventTag, e.g. the next 5 maintenance
+	 * windows:
+	 *
+	 * 	MyCalendar.listNext(MAINTENANCE, 5, occurrences, Chronos::DateTime::now());
+	 */
+	virtual uint8_t listNext(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt);
 
 	/*
 	 * listForDay -- list all events that will begin on the day specified in dt.
@@ -153,6 +232,22 @@ public:
 	 */
 	uint8_t listForDay(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt);
 
+	/*
+	 * nextOccurrenceOf(eventId, dt, into)
+	 *
+	 * Find the earliest occurrence of a given event starting after dt.
+	 * @return: true if one was found, and loaded into into.
+	 */
+	virtual bool nextOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into);
+
+	/*
+	 * currentOccurrenceOf(eventId, dt, into)
+	 *
+	 * Find an occurrence of a given event that's happening at dt.
+	 * @return: true if one was found, and loaded into into.
+	 */
+	virtual bool currentOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into);
+
 
 
 	/*
@@ -169,16 +264,89 @@ public:
 	 * when the call returns.
 	 *
 	 */
-	bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT);
+	virtual bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT);
+
+	/*
+	 * eventAt(i, into)
+	 *
+	 * Copy the i-th event held into into, for walking through the whole calendar
+	 * (e.g. to save it).  Events come in the order they're kept in, which adding them
+	 * to an empty calendar of the same type, in that order, reproduces.
+	 * @return: false once i is past the last event.
+	 */
+	virtual bool eventAt(uint32_t i, Chronos::Event & into);
 
 
 protected:
+	/*
+	 * slotsDateTimeOfInterest(dt, returnDT)
+	 *
+	 * nextDateTimeOfInterest(), looking only at the events held in this class'
+	 * slots -- for subclasses that keep (some of) their events elsewhere and
+	 * handle those themselves.
+	 */
+	bool slotsDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT);
+
 	virtual Chronos::Event * eventSlot(uint8_t i) = 0;
 
+	/*
+	 * tagLink(i)
+	 *
+	 * Storage for the per-tag index: the slot following slot i in its tag's list.
+	 * Implementations that return NULL (the default) get filtered queries through
+	 * a full scan.
+	 */
+	virtual uint8_t * tagLink(uint8_t i) { return NULL; }
+
+	/*
+	 * claimSlot(recurring)
+	 *
+	 * Reserve the next free event slot, counting it as used.
+	 * @return: the slot, or NULL if the calendar is full.
+	 */
+	Chronos::Event * claimSlot(bool recurring);
+
+	/*
+	 * insertOccurrence(occ, number, into)
+	 *
+	 * Insert occ in its place within the sorted into[] list, bumping the last entry.
+	 * @return: false if occ comes after everything in the list, and so wasn't inserted.
+	 */
+	static bool insertOccurrence(const Event::Occurrence & occ, uint8_t number, Event::Occurrence into[]);
+
+	/*
+	 * numListed(number, into)
+	 *
+	 * @return: number of actual occurrences at the start of a list filled by insertOccurrence().
+	 */
+	static uint8_t numListed(uint8_t number, const Event::Occurrence into[]);
+
 private:
+	// the per-event parts of listNext()/listOngoing()
+	void listNextOf(Chronos::Event * evt, uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	static void padList(uint8_t number, Event::Occurrence into[]);
+	// nextDateTimeOfInterest(), through our own listings if slotsOnly
+	bool closestStartOrEnd(const DateTime & fromDT, DateTime & returnDT, bool slotsOnly);
+
+	/*
+	 * Tag index: for each indexed tag, the first and last slots of a list running
+	 * through tagLink(), in slot order.
+	 */
+	bool tagIndexed(EventTag tag);
+	void indexSlot(uint8_t i);
+	void reindex();
+	// reindex(), or leave it to endUpdate() during a batch
+	void refreshIndex();
+	uint8_t firstTagged(EventTag tag);
+	uint8_t nextTagged(EventTag tag, uint8_t slot);
+
 	uint8_t num_events;
 	uint8_t max_events;
 	uint8_t num_recurring;
+	uint8_t update_depth;
+	bool index_stale;
+	uint8_t tag_first[CHRONOS_CALENDAR_INDEXED_TAGS];
+	uint8_t tag_last[CHRONOS_CALENDAR_INDEXED_TAGS];
 
 };
 
@@ -205,8 +373,17 @@ protected:
 
 		return &(event_list[i]);
 	}
+
+	virtual uint8_t * tagLink(uint8_t i) {
+
+		if (i >= MAXNUM)
+			return NULL;
+
+		return &(tag_links[i]);
+	}
 private:
 	Chronos::Event event_list[MAXNUM];
+	uint8_t tag_links[MAXNUM];
 
 
 };
@@ -0,0 +1,389 @@
+/*
+ * CalendarColumnar.h
+ *
+ * A Calendar that keeps one-time events in separate start/end/id columns,
+ * rather than as full Chronos::Event objects.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_CALENDARCOLUMNAR_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_CALENDARCOLUMNAR_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+#include "../../chronosinc/Sort.h"
+#include "../../chronosinc/schedule/ColumnScan.h"
+
+
+/*
+ * DefineColumnarCalendarType(name, maxOneTime, maxRecurring)
+ *
+ * Like DefineCalendarType, for columnar calendars:
+ *
+ *   DefineColumnarCalendarType(Agenda, 200, 8); // 200 one-time and 8 repeating events
+ */
+#define DefineColumnarCalendarType(name, numOneTime, numRecurring)	\
+		typedef	Chronos::CalendarColumnar<numOneTime, numRecurring> name;
+
+namespace Chronos {
+
+/*
+ * CalendarColumnar<MAXONETIME, MAXRECURRING>
+ *
+ * A Calendar for lots of one-time events.  These are stored as plain columns
+ * of start epochs, end epochs and ids, so the scans in listNext()/listOngoing()
+ * are sequential runs over 4-byte values instead of hops over whole Chronos::Events
+ * (with their marks, durations and cached DateTime elements).  These scans are
+ * done block by block with the ColumnScan kernels (SIMD, where available).
+ *
+ * Recurring events still need their marks, and are kept as Chronos::Events, up to
+ * MAXRECURRING of them.
+ *
+ * One-time events' EventTags are kept in a column of their own, checked against
+ * the scan hits in the filtered queries (recurring events use the usual tag index).
+ *
+ * Other than the capacities, it's used just like any other Calendar.
+ *
+ * MAXONETIME is a 32-bit count: these are meant for host-sized agendas (the
+ * columns take 13 bytes per event), and a calendar of a million appointments is
+ * fair game.  Like CalendarImage, its numEvents() counts them all, but through a
+ * plain Calendar reference (whose numEvents() is a uint8_t) only the recurring
+ * events are counted -- eventAt() sees them all either way.
+ */
+template<uint32_t MAXONETIME, uint8_t MAXRECURRING>
+class CalendarColumnar : public Calendar {
+
+public:
+	CalendarColumnar() : Calendar(MAXRECURRING), num_onetime(0)
+	{
+
+	}
+
+	/*
+	 * numEvents() is the total of recurring and one-time events, numOneTime() only
+	 * counts the latter.
+	 */
+	inline uint32_t numEvents() { return Calendar::numEvents() + num_onetime; }
+	inline uint32_t numOneTime() const { return num_onetime;}
+
+	virtual bool add(const Chronos::Event & event)
+	{
+		if (event.isRecurring())
+			return Calendar::add(event);
+
+		return addOneTime(event);
+	}
+
+#ifdef PLATFORM_SUPPORTS_RVAL_MOVE
+	virtual bool add(Chronos::Event&& event)
+	{
+		if (event.isRecurring())
+			return Calendar::add(std::move(event));
+
+		return addOneTime(event);
+	}
+#endif
+
+	// (keep the recurring emplace<MarkType>() visible)
+	using Calendar::emplace;
+
+	virtual bool emplace(EventID id, const DateTime & start, const DateTime & end)
+	{
+		if (num_onetime >= MAXONETIME)
+			return false;
+
+		starts[num_onetime] = start.asEpoch();
+		ends[num_onetime] = end.asEpoch();
+		ids[num_onetime] = id;
+		tags[num_onetime] = EVENTTAG_NONE;
+		num_onetime++;
+		return true;
+	}
+
+	virtual bool remove(EventID evId)
+	{
+		if (evId <= EVENTID_NOTSET)
+			return false;
+
+		for (uint32_t i=0; i<num_onetime; i++)
+		{
+			if (ids[i] == evId)
+			{
+				// order doesn't matter, last one takes its place
+				num_onetime--;
+				starts[i] = starts[num_onetime];
+				ends[i] = ends[num_onetime];
+				ids[i] = ids[num_onetime];
+				tags[i] = tags[num_onetime];
+				return true;
+			}
+		}
+
+		return Calendar::remove(evId);
+	}
+
+	virtual void clear()
+	{
+		num_onetime = 0;
+		Calendar::clear();
+	}
+
+	virtual bool setTag(EventID evId, EventTag tag)
+	{
+		bool foundIt = false;
+		for (uint32_t i=0; i<num_onetime; i++)
+		{
+			if (ids[i] == evId)
+			{
+				tags[i] = tag;
+				foundIt = true;
+			}
+		}
+
+		return Calendar::setTag(evId, tag) || foundIt;
+	}
+
+
+	virtual uint8_t listNext(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+	{
+		if (! number)
+			return 0;
+
+		// recurring events first, this leaves the tail of into[] padded
+		// with end-of-time entries, ready for insertOccurrence()
+		Calendar::listNext(number, into, dt);
+		return listNextOneTime(NULL, number, into, dt);
+	}
+
+	virtual uint8_t listNext(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+	{
+		if (! number)
+			return 0;
+
+		Calendar::listNext(tag, number, into, dt);
+		return listNextOneTime(&tag, number, into, dt);
+	}
+
+	virtual uint8_t listOngoing(uint8_t number, Event::Occurrence into[], const DateTime & dt)
+	{
+		return listOngoingOneTime(NULL, Calendar::listOngoing(number, into, dt), number, into, dt);
+	}
+
+	virtual uint8_t listOngoing(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+	{
+		return listOngoingOneTime(&tag, Calendar::listOngoing(tag, number, into, dt), number, into, dt);
+	}
+
+	virtual bool nextOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+	{
+		bool foundIt = Calendar::nextOccurrenceOf(evId, dt, into);
+		Chronos::EpochTime after = dt.asEpoch();
+		for (uint32_t i=0; i<num_onetime; i++)
+		{
+			if (ids[i] == evId && starts[i] > after && (! foundIt || starts[i] < into.start.asEpoch()))
+			{
+				into = Event::Occurrence(ids[i], DateTime(starts[i]), DateTime(ends[i]));
+				foundIt = true;
+			}
+		}
+
+		return foundIt;
+	}
+
+	virtual bool currentOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into)
+	{
+		Chronos::EpochTime at = dt.asEpoch();
+		for (uint32_t i=0; i<num_onetime; i++)
+		{
+			if (ids[i] == evId && starts[i] <= at && ends[i] > at)
+			{
+				into = Event::Occurrence(ids[i], DateTime(starts[i]), DateTime(ends[i]), true);
+				return true;
+			}
+		}
+
+		return Calendar::currentOccurrenceOf(evId, dt, into);
+	}
+
+	virtual bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT)
+	{
+		// closest start or end amongst the recurring events...
+		bool foundSomething = slotsDateTimeOfInterest(fromDT, returnDT);
+		Chronos::EpochTime closest = foundSomething ? returnDT.asEpoch() : DateTime::endOfTime().asEpoch();
+
+		// ... and the one-time events: the closest upcoming start, or end of an
+		// ongoing one.  Events yet to start end no sooner than they start, so
+		// the closest end beyond 'at' will do for the latter.
+		Chronos::EpochTime at = fromDT.asEpoch();
+		if (closestAfter(starts, at, closest))
+			foundSomething = true;
+		if (closestAfter(ends, at, closest))
+			foundSomething = true;
+
+		if (foundSomething)
+		{
+			returnDT = DateTime(closest);
+		}
+
+		return foundSomething;
+	}
+
+	// the recurring events, then the one-time ones
+	virtual bool eventAt(uint32_t i, Chronos::Event & into)
+	{
+		if (i < Calendar::numEvents())
+			return Calendar::eventAt(i, into);
+
+		i -= Calendar::numEvents();
+		if (i >= num_onetime)
+			return false;
+
+		into.set(ids[i], DateTime(starts[i]), DateTime(ends[i]));
+		into.setTag(tags[i]);
+		return true;
+	}
+
+protected:
+	virtual Chronos::Event * eventSlot(uint8_t i) {
+
+		if (i >= MAXRECURRING)
+			return NULL;
+
+		return &(recurring_list[i]);
+	}
+
+	virtual uint8_t * tagLink(uint8_t i) {
+
+		if (i >= MAXRECURRING)
+			return NULL;
+
+		return &(tag_links[i]);
+	}
+
+private:
+	bool addOneTime(const Chronos::Event & event)
+	{
+		if (! emplace(event.id(), event.start(), event.finish()))
+			return false;
+
+		tags[num_onetime - 1] = event.tag();
+		return true;
+	}
+
+	/*
+	 * The one-time halves of the listings: tag is NULL for all events, or points
+	 * to the one they must carry.
+	 */
+	uint8_t listNextOneTime(const EventTag * tag, uint8_t number, Event::Occurrence into[], const DateTime & dt)
+	{
+		Chronos::EpochTime after = dt.asEpoch();
+		// anything starting at or beyond the last entry won't make it in
+		Chronos::EpochTime cutoff = into[number - 1].start.asEpoch();
+		uint16_t hits[CHRONOS_COLUMN_SCAN_BLOCK];
+		for (uint32_t block=0; block<num_onetime; block += CHRONOS_COLUMN_SCAN_BLOCK)
+		{
+			uint16_t numHits = ColumnScan::between(&(starts[block]), blockSize(block),
+					after, cutoff, hits);
+
+			for (uint16_t h=0; h<numHits; h++)
+			{
+				uint32_t i = block + hits[h];
+				// cutoff may have moved up since the scan
+				if (starts[i] < cutoff && (NULL == tag || tags[i] == *tag))
+				{
+					insertOccurrence(Event::Occurrence(ids[i], DateTime(starts[i]), DateTime(ends[i])),
+							number, into);
+					cutoff = into[number - 1].start.asEpoch();
+				}
+			}
+		}
+
+		return numListed(number, into);
+	}
+
+	uint8_t listOngoingOneTime(const EventTag * tag, uint8_t numFound, uint8_t number,
+			Event::Occurrence into[], const DateTime & dt)
+	{
+		if (numFound >= number)
+			return numFound;
+
+		Chronos::EpochTime at = dt.asEpoch();
+		uint16_t hits[CHRONOS_COLUMN_SCAN_BLOCK];
+		for (uint32_t block=0; block<num_onetime && numFound < number; block += CHRONOS_COLUMN_SCAN_BLOCK)
+		{
+			uint16_t numHits = ColumnScan::spanning(&(starts[block]), &(ends[block]), blockSize(block),
+					at, hits);
+
+			for (uint16_t h=0; h<numHits && numFound < number; h++)
+			{
+				uint32_t i = block + hits[h];
+				if (NULL != tag && tags[i] != *tag)
+					continue;
+
+				into[numFound++] = Event::Occurrence(ids[i], DateTime(starts[i]), DateTime(ends[i]), true);
+			}
+		}
+
+		Chronos::Sort::bubble(into, numFound);
+		return numFound;
+	}
+
+	// lowers closest to the smallest column[] entry beyond at, if there's one below it
+	bool closestAfter(const Chronos::EpochTime column[], Chronos::EpochTime at, Chronos::EpochTime & closest)
+	{
+		bool found = false;
+		uint16_t hits[CHRONOS_COLUMN_SCAN_BLOCK];
+		for (uint32_t block=0; block<num_onetime; block += CHRONOS_COLUMN_SCAN_BLOCK)
+		{
+			uint16_t numHits = ColumnScan::between(&(column[block]), blockSize(block),
+					at, closest, hits);
+
+			for (uint16_t h=0; h<numHits; h++)
+			{
+				if (column[block + hits[h]] < closest)
+				{
+					closest = column[block + hits[h]];
+					found = true;
+				}
+			}
+		}
+
+		return found;
+	}
+
+	inline uint16_t blockSize(uint32_t block) const {
+		return (num_onetime - block) < CHRONOS_COLUMN_SCAN_BLOCK ? (num_onetime - block) : CHRONOS_COLUMN_SCAN_BLOCK;
+	}
+
+	Chronos::EpochTime starts[MAXONETIME];
+	Chronos::EpochTime ends[MAXONETIME];
+	EventID ids[MAXONETIME];
+	EventTag tags[MAXONETIME];
+	uint32_t num_onetime;
+
+	Chronos::Event recurring_list[MAXRECURRING];
+	uint8_t tag_links[MAXRECURRING];
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_CALENDARCOLUMNAR_H_ */
@@ -0,0 +1,303 @@
+/*
+ * CalendarImage.h
+ *
+ * A read-only calendar, queried straight out of a binary image: a buffer
+ * or a file mapped into memory.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_CALENDARIMAGE_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_CALENDARIMAGE_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+#include "../../chronosinc/Sort.h"
+#include "../../chronosinc/schedule/ColumnScan.h"
+
+// format version written by CalendarImage::Builder, and the only one attach() accepts
+#define CHRONOS_CALENDAR_IMAGE_VERSION		1
+
+namespace Chronos {
+
+/*
+ * CalendarImage
+ *
+ * A Calendar whose events live in a binary image, written once by a
+ * CalendarImage::Builder:
+ *
+ * 	Chronos::CalendarImage::Builder builder;
+ * 	builder.add(Chronos::Event(1, Chronos::DateTime(2026, 10, 19, 9), Chronos::Span::Hours(1)));
+ * 	builder.add(Chronos::Event(2, Chronos::Mark::Daily(7, 30, 0), Chronos::Span::Minutes(20)));
+ * 	...
+ * 	builder.writeFile("agenda.chri");
+ *
+ * and later used in place, without parsing it or allocating anything:
+ *
+ * 	Chronos::CalendarImage agenda;
+ * 	if (agenda.map("agenda.chri"))
+ * 		numNext = agenda.listNext(10, occurrences, Chronos::DateTime::now());
+ *
+ * The image holds no pointers, only offsets from its own start, so it may be
+ * mapped anywhere, or be any suitably aligned buffer (e.g. a const array
+ * compiled in, on platforms where those are directly addressable).
+ *
+ * Layout: a Header, then the one-time events as columns -- starts, ends, an
+ * index of their positions ordered by id, ids and tags -- sorted by start, and
+ * the recurring events as fixed-size Records (id, tag, duration, bounds and
+ * the Mark::Event::Params of their mark).  All values are in the byte order of
+ * the machine that wrote the image, which attach() checks.
+ *
+ * Since starts are sorted, listNext() binary searches for its first candidate and
+ * stops at the first start beyond what it can list, and the ongoing events at any
+ * time are found between two binary searches -- those can't have started more
+ * than the longest one-time event's length before.  A recurring event is rebuilt,
+ * in place, in a scratch Chronos::Event whenever the base Calendar visits it.
+ *
+ * The image is read-only: add(), emplace(), remove() and setTag() all return false.
+ * Recurring events must use the built-in marks, and can't have exceptions (see
+ * Chronos::Event::setExceptions()).  Like the other calendars, queries aren't
+ * thread-safe -- the scratch event is shared -- but any number of CalendarImages,
+ * in as many processes, can map the same file.
+ */
+class CalendarImage : public Calendar {
+public:
+	class Builder;
+
+	CalendarImage();
+	virtual ~CalendarImage();
+
+	/*
+	 * attach(image, size)
+	 *
+	 * Use the image (e.g. from Builder::write()) at image, which must be 4-byte aligned
+	 * and stay there, unchanged, until clear() or destruction.  Any previous image is
+	 * let go first.
+	 * @return: false if the image isn't valid, in which case the calendar is empty.
+	 */
+	bool attach(const void * image, uint32_t size);
+
+#ifdef CHRONOS_PLATFORM_POSIX
+	/*
+	 * map(path)
+	 *
+	 * attach() the image in file path, mmap()ed read-only.  It's unmapped by clear()
+	 * and on destruction.
+	 * @return: false if the file couldn't be mapped, or isn't a valid image.
+	 */
+	bool map(const char * path);
+#endif
+
+	/*
+	 * clear() lets go of the image (unmapping it, if need be) -- there's nothing
+	 * else to empty.
+	 */
+	virtual void clear();
+
+	inline bool isAttached() const { return NULL != header; }
+
+	/*
+	 * numEvents() is the total of recurring and one-time events, numOneTime() only
+	 * counts the latter (through a plain Calendar reference, numEvents() only
+	 * counts the recurring ones).
+	 */
+	inline uint32_t numEvents() { return Calendar::numEvents() + num_onetime; }
+	inline uint32_t numOneTime() const { return num_onetime; }
+
+	// read-only
+	virtual bool add(const Chronos::Event & event) { return false; }
+#ifdef PLATFORM_SUPPORTS_RVAL_MOVE
+	virtual bool add(Chronos::Event&& event) { return false; }
+#endif
+	using Calendar::emplace;
+	virtual bool emplace(EventID id, const DateTime & start, const DateTime & end) { return false; }
+	virtual bool remove(EventID evId) { return false; }
+	virtual bool setTag(EventID evId, EventTag tag) { return false; }
+
+	virtual uint8_t listNext(uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	virtual uint8_t listNext(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	virtual uint8_t listOngoing(uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	virtual uint8_t listOngoing(EventTag tag, uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	virtual bool nextOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into);
+	virtual bool currentOccurrenceOf(EventID evId, const DateTime & dt, Event::Occurrence & into);
+	virtual bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT);
+	// the recurring events, then the one-time ones, by start
+	virtual bool eventAt(uint32_t i, Chronos::Event & into);
+
+	/*
+	 * Header -- at the start of every image.  Offsets are in bytes, from the start of
+	 * the image.
+	 */
+	class Header {
+	public:
+		char magic[4]; // "CHRI"
+		uint16_t version;
+		uint16_t byte_order; // 0x0102, as written
+		uint32_t size; // of the whole image
+		uint32_t num_onetime;
+		uint32_t num_recurring;
+		uint32_t max_length; // of the one-time events, in seconds
+		uint32_t starts; // EpochTime[num_onetime], sorted
+		uint32_t ends; // EpochTime[num_onetime]
+		uint32_t by_id; // uint32_t[num_onetime], positions sorted by id then start
+		uint32_t recurring; // Record[num_recurring]
+		uint32_t ids; // EventID[num_onetime]
+		uint32_t tags; // EventTag[num_onetime]
+	};
+
+	/*
+	 * Record -- a recurring event.
+	 */
+	class Record {
+	public:
+		Chronos::Mark::Event::Params mark;
+		uint32_t length; // duration, in seconds
+		uint32_t first; // bounds, see Chronos::Event::setUntil()/setCount()
+		uint32_t last;
+		EventID id;
+		EventTag tag;
+		uint8_t reserved[2];
+	};
+
+	/*
+	 * Builder
+	 *
+	 * Collects events, which are copied as they're add()ed, and writes them out as
+	 * an image.  The Builder allocates as it goes, the image never does.
+	 */
+	class Builder {
+	public:
+		Builder();
+		~Builder();
+
+		/*
+		 * add(event)
+		 * @return: false if the event can't go in an image (a recurring event with
+		 * a user-defined mark or exceptions, or one too many recurring events) or
+		 * there was no memory to hold it.
+		 */
+		bool add(const Chronos::Event & event);
+
+		inline uint32_t numOneTime() const { return num_onetime; }
+		inline uint8_t numRecurring() const { return num_recurring; }
+
+		/*
+		 * size()
+		 * @return: bytes the image will take.
+		 */
+		uint32_t size() const;
+
+		/*
+		 * write(into, maxSize)
+		 * Write the image into the (4-byte aligned) buffer.
+		 * @return: bytes written, or 0 if it needs more than maxSize.
+		 */
+		uint32_t write(void * into, uint32_t maxSize);
+
+#ifdef CHRONOS_PLATFORM_POSIX
+		/*
+		 * writeFile(path)
+		 * Write the image to a file, replacing any there.
+		 * @return: success
+		 */
+		bool writeFile(const char * path);
+#endif
+
+	private:
+		Builder(const Builder & other);
+		Builder & operator=(const Builder & other);
+
+		class OneTime {
+		public:
+			Chronos::EpochTime start;
+			Chronos::EpochTime finish;
+			EventID id;
+			EventTag tag;
+		};
+
+		static int byStart(const void * a, const void * b);
+
+		OneTime * onetime;
+		uint32_t num_onetime;
+		uint32_t onetime_capacity;
+		Record * recurring;
+		uint8_t num_recurring;
+		uint8_t recurring_capacity;
+	};
+
+protected:
+	virtual Chronos::Event * eventSlot(uint8_t i);
+
+private:
+	CalendarImage(const CalendarImage & other);
+	CalendarImage & operator=(const CalendarImage & other);
+
+	static bool validate(const Header * hdr, uint32_t size);
+	// Chronos::Event::saveTo(), for the Builder
+	static bool save(const Chronos::Event & event, Record & into);
+
+	template<class T>
+	inline const T * column(uint32_t offset) const {
+		return reinterpret_cast<const T *>(reinterpret_cast<const uint8_t *>(header) + offset);
+	}
+
+	// first position, from low, whose start is > epoch
+	uint32_t firstStartAfter(Chronos::EpochTime epoch, uint32_t low=0) const;
+	// where the one-time events that may be ongoing at epoch start
+	uint32_t firstMaybeOngoing(Chronos::EpochTime epoch) const;
+	// first place, in the by_id index, of an event that's either evId starting after epoch, or beyond evId
+	uint32_t firstOfIdAfter(EventID evId, Chronos::EpochTime epoch) const;
+
+	// the position at place k of the by_id index (a bogus one is clamped, so we stay within the image)
+	inline uint32_t position(uint32_t k) const { return by_id[k] < num_onetime ? by_id[k] : 0; }
+
+	inline Event::Occurrence occurrenceAt(uint32_t i, bool isOngoing=false) const {
+		return Event::Occurrence(ids[i], DateTime(starts[i]), DateTime(ends[i]), isOngoing);
+	}
+
+	/*
+	 * The one-time halves of the listings: tag is NULL for all events, or points
+	 * to the one they must carry.
+	 */
+	uint8_t listNextOneTime(const EventTag * tag, uint8_t number, Event::Occurrence into[], const DateTime & dt);
+	uint8_t listOngoingOneTime(const EventTag * tag, uint8_t numFound, uint8_t number,
+			Event::Occurrence into[], const DateTime & dt);
+
+	const Header * header;
+	const Chronos::EpochTime * starts;
+	const Chronos::EpochTime * ends;
+	const uint32_t * by_id;
+	const Record * records;
+	const EventID * ids;
+	const EventTag * tags;
+	uint32_t num_onetime;
+
+	// the recurring event last rebuilt, from records[scratch_slot]
+	Chronos::Event scratch;
+	uint8_t scratch_slot;
+
+	void * mapped; // when map()ped
+	uint32_t mapped_size;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_CALENDARIMAGE_H_ */
@@ -0,0 +1,162 @@
+/*
+ * CallbackExecutor.h
+ *
+ * Runs callbacks for batches of event occurrences on a pool of worker
+ * threads.  Host (multi-threaded OS) builds only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_CALLBACKEXECUTOR_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_CALLBACKEXECUTOR_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_CALLBACK_EXECUTOR
+
+#ifndef PLATFORM_SUPPORTS_RVAL_MOVE
+#error "CallbackExecutor needs C++11 (and ENABLE_UTILITY_INCLUDE)"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// CHRONOS_EXECUTOR_STRAND_BATCH -- max callbacks run for one event before its
+// worker moves on to others (and lets them be stolen).
+#ifndef CHRONOS_EXECUTOR_STRAND_BATCH
+#define CHRONOS_EXECUTOR_STRAND_BATCH	16
+#endif
+
+namespace Chronos {
+
+/*
+ * CallbackExecutor
+ *
+ * Hands batches of due occurrences, e.g. everything starting on the hour,
+ * to a callback, in parallel:
+ *
+ * 	Chronos::CallbackExecutor executor([](const Chronos::Event::Occurrence & occ) {
+ * 		startJob(occ.id);
+ * 	});
+ * 	...
+ * 	uint8_t numStarting = MyCalendar.listNext(50, starting, lastCheck);
+ * 	executor.submit(starting, numStarting);
+ *
+ * Callbacks for any one EventID run in the order they were submitted, one at a
+ * time.  Callbacks for different events run concurrently: each EventID has a
+ * strand (its queue of pending occurrences), and strands with work are spread over
+ * per-worker deques.  Workers take strands from the front of their own deque and,
+ * when it runs dry, steal from the back of the others'.
+ *
+ * Callbacks may submit() more work.
+ *
+ * Needs C++11 and is only available with CHRONOS_CALLBACK_EXECUTOR defined (see
+ * ChronosConfig.h).
+ */
+class CallbackExecutor {
+public:
+	typedef std::function<void(const Event::Occurrence &)> Callback;
+
+	/*
+	 * CallbackExecutor(callback, numWorkers)
+	 * @param callback: what to call for each occurrence submitted
+	 * @param numWorkers: worker threads, by default one per core
+	 */
+	CallbackExecutor(const Callback & callback, unsigned numWorkers=0);
+
+	/*
+	 * Destruction waits for the callbacks already submitted.
+	 */
+	~CallbackExecutor();
+
+	/*
+	 * submit(occurrences, num)
+	 * Queue callbacks for num occurrences, returning right away.
+	 */
+	void submit(const Event::Occurrence occurrences[], uint16_t num);
+
+	/*
+	 * waitIdle()
+	 * Wait until every callback submitted so far has returned.
+	 */
+	void waitIdle();
+
+	inline unsigned numWorkers() const { return workers.size(); }
+
+	/*
+	 * numStolen()
+	 * @return: how many times a worker took a strand from another's deque.
+	 */
+	inline uint32_t numStolen() const { return num_stolen.load(); }
+
+private:
+	CallbackExecutor(const CallbackExecutor &) = delete;
+	CallbackExecutor & operator=(const CallbackExecutor &) = delete;
+
+	class Strand {
+	public:
+		Strand() : scheduled(false) {}
+
+		std::mutex lock;
+		std::deque<Event::Occurrence> pending;
+		bool scheduled; // on some worker's deque, or being run
+	};
+
+	class Worker {
+	public:
+		std::mutex lock;
+		std::deque<uint8_t> strands;
+		std::thread thread;
+	};
+
+	static inline uint8_t strandFor(EventID evId) { return (uint8_t)evId; }
+
+	void schedule(uint8_t strand, unsigned workerIdx);
+	bool take(unsigned workerIdx, uint8_t & strand);
+	void runStrand(unsigned workerIdx, uint8_t strand);
+	void work(unsigned workerIdx);
+
+	Callback callback;
+	Strand strands[256];
+	std::vector<Worker *> workers;
+
+	std::atomic<uint32_t> outstanding; // callbacks not yet returned
+	std::atomic<uint32_t> queued; // strands sitting on deques
+	std::atomic<uint32_t> num_stolen;
+	std::atomic<unsigned> next_worker;
+
+	std::mutex idle_lock;
+	std::condition_variable work_available;
+	std::condition_variable all_done;
+	bool stopping;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CALLBACK_EXECUTOR */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_CALLBACKEXECUTOR_H_ */
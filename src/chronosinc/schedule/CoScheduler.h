@@ -0,0 +1,193 @@
+/*
+ * CoScheduler.h
+ *
+ * C++20 coroutine support: co_await calendar events starting or ending.
+ * Linux hosts only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_COSCHEDULER_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_COSCHEDULER_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_COROUTINES
+
+#if !defined(__linux__) || (__cplusplus < 202002L)
+#error "CoScheduler needs C++20 and Linux (timerfd/epoll)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <map>
+
+namespace Chronos {
+
+/*
+ * CoScheduler
+ *
+ * Suspends coroutines until some DateTime, or some edge (start or end) of events
+ * in a calendar, and resumes them from run():
+ *
+ * 	Chronos::CoScheduler::Task watchDoor(Chronos::CoScheduler & sched) {
+ * 		for (;;) {
+ * 			Chronos::Event::Occurrence occ = co_await sched.untilStart(DOOR_OPEN_EVENT);
+ * 			if (occ.id == EVENTID_NOTSET)
+ * 				co_return; // no more of those
+ * 			unlockDoor();
+ * 			co_await sched.untilEnd(DOOR_OPEN_EVENT);
+ * 			lockDoor();
+ * 		}
+ * 	}
+ *
+ * 	Chronos::CoScheduler sched(MyCalendar);
+ * 	watchDoor(sched);
+ * 	sched.run();
+ *
+ * Edges are resolved against the calendar when co_await'ed.  However many
+ * coroutines are waiting, a single timerfd is armed, for the nearest one, and
+ * run() sleeps on it in epoll_wait().
+ *
+ * The timer is armed relative to Chronos' clock (DateTime::now()), which only has
+ * seconds: when woken a little before an edge, run() tries again every
+ * CHRONOS_COSCHEDULER_RETRY_MS until that clock gets there.  With
+ * CHRONOS_CLOCK_CACHED, run() refreshes the CachedClock each time it wakes, so
+ * the coroutines it resumes all see the same "now".  With CHRONOS_CLOCK_SIMULATED,
+ * it doesn't sleep at all: it moves the SimulatedClock to the next waiter's time.
+ *
+ * Single-threaded: awaiting, run() and stop() all happen on the same thread.
+ *
+ * Needs C++20 and Linux, and is only available with CHRONOS_COROUTINES defined (see
+ * ChronosConfig.h).
+ */
+#ifndef CHRONOS_COSCHEDULER_RETRY_MS
+#define CHRONOS_COSCHEDULER_RETRY_MS	50
+#endif
+
+class CoScheduler {
+public:
+	/*
+	 * Task -- return type for coroutines that co_await the scheduler.  These start
+	 * right away, run until their first co_await and clean up after themselves when
+	 * they're done.
+	 */
+	class Task {
+	public:
+		class promise_type {
+		public:
+			Task get_return_object() { return Task(); }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	/*
+	 * Awaitables, as returned by until*() below.
+	 */
+	class TimeAwaiter {
+	public:
+		TimeAwaiter(CoScheduler & sched, Chronos::EpochTime when, bool valid) :
+			scheduler(sched), at(when), is_valid(valid) {}
+
+		bool await_ready() const;
+		void await_suspend(std::coroutine_handle<> handle);
+		bool await_resume() const { return is_valid; }
+
+	protected:
+		CoScheduler & scheduler;
+		Chronos::EpochTime at;
+		bool is_valid;
+	};
+
+	class OccurrenceAwaiter : public TimeAwaiter {
+	public:
+		OccurrenceAwaiter(CoScheduler & sched, const Event::Occurrence & occ, bool atStart);
+		Event::Occurrence await_resume() const { return occurrence; }
+
+	private:
+		Event::Occurrence occurrence;
+	};
+
+	CoScheduler(Calendar & cal);
+	~CoScheduler();
+
+	/*
+	 * until(dt)
+	 * co_await resumes once dt is reached, returning true.
+	 */
+	TimeAwaiter until(const DateTime & dt);
+
+	/*
+	 * untilNext()
+	 * co_await resumes at the calendar's next DateTime of interest (the closest start or
+	 * end of any event), returning true -- or right away with false, if there is none.
+	 */
+	TimeAwaiter untilNext();
+
+	/*
+	 * untilStart(eventId)/untilEnd(eventId)
+	 * co_await resumes when the next occurrence of eventId starts (or when the current
+	 * one, or else the next one, ends), returning that Event::Occurrence -- or right
+	 * away with an Occurrence with id EVENTID_NOTSET, if there is none.
+	 */
+	OccurrenceAwaiter untilStart(EventID evId);
+	OccurrenceAwaiter untilEnd(EventID evId);
+
+	/*
+	 * run()
+	 * Resume waiting coroutines as their time comes, until there are none left
+	 * or stop() is called.
+	 * @return: false if the timer couldn't be set up.
+	 */
+	bool run();
+
+	/*
+	 * stop() -- have run() return (e.g. from a coroutine it resumed).
+	 */
+	void stop() { stopping = true;}
+
+	inline size_t numWaiting() const { return waiters.size(); }
+
+	inline Calendar & calendar() { return cal; }
+
+private:
+	CoScheduler(const CoScheduler &) = delete;
+	CoScheduler & operator=(const CoScheduler &) = delete;
+
+	void wait(Chronos::EpochTime at, std::coroutine_handle<> handle);
+	bool armTimer(Chronos::EpochTime at);
+
+	Calendar & cal;
+	std::multimap<Chronos::EpochTime, std::coroutine_handle<> > waiters;
+	int timer_fd;
+	int epoll_fd;
+	bool stopping;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_COROUTINES */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_COSCHEDULER_H_ */
@@ -0,0 +1,82 @@
+/*
+ * ColumnScan.h
+ *
+ * Filtering kernels for columns of epochs, as used by CalendarColumnar.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_COLUMNSCAN_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_COLUMNSCAN_H_
+
+#include "../timeTypes.h"
+
+// CHRONOS_COLUMN_SCAN_BLOCK -- number of entries scanned per kernel call, which
+// is also the size of the (stack) index buffers the calendars hand to the kernels.
+#ifndef CHRONOS_COLUMN_SCAN_BLOCK
+#define CHRONOS_COLUMN_SCAN_BLOCK	64
+#endif
+
+// CHRONOS_COLUMN_SCAN_KERNELS -- define as one of the below to always use that
+// kernel set (which the CPU had better support), rather than the best one found
+// at runtime: to compare them, or to rule them out.
+#define CHRONOS_COLUMN_SCAN_SCALAR	1
+#define CHRONOS_COLUMN_SCAN_SSE2	2
+#define CHRONOS_COLUMN_SCAN_AVX2	3
+
+namespace Chronos {
+namespace ColumnScan {
+
+/*
+ * Each kernel looks at entries [0, num) of the columns and writes the indices
+ * of those that match to matches[], in order, returning how many did.
+ * matches[] must have room for num indices.
+ *
+ * On x86 hosts these use AVX2 or SSE2, picked at runtime according to what
+ * the CPU supports, comparing 8 (or 4) epochs at a time.  Elsewhere, they're
+ * plain loops.
+ */
+
+/*
+ * between(values, num, low, high, matches)
+ * Selects entries where low < value < high.
+ */
+uint16_t between(const Chronos::EpochTime values[], uint16_t num,
+		Chronos::EpochTime low, Chronos::EpochTime high, uint16_t matches[]);
+
+/*
+ * spanning(starts, ends, num, at, matches)
+ * Selects entries where starts[i] <= at < ends[i], i.e. ongoing at 'at'.
+ */
+uint16_t spanning(const Chronos::EpochTime starts[], const Chronos::EpochTime ends[], uint16_t num,
+		Chronos::EpochTime at, uint16_t matches[]);
+
+/*
+ * implementation()
+ * @return: name of the kernel set in use ("avx2", "sse2" or "scalar").
+ */
+const char * implementation();
+
+} /* namespace ColumnScan */
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_COLUMNSCAN_H_ */
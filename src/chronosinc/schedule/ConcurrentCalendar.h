@@ -0,0 +1,345 @@
+/*
+ * ConcurrentCalendar.h
+ *
+ * A calendar that may be queried from many threads at once, without locks,
+ * while others update it.  Host (multi-threaded OS) builds only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_CONCURRENTCALENDAR_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_CONCURRENTCALENDAR_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_CONCURRENT_CALENDAR
+
+#ifndef PLATFORM_SUPPORTS_RVAL_MOVE
+#error "ConcurrentCalendar needs C++11 (and ENABLE_UTILITY_INCLUDE)"
+#endif
+
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+// the cache is written to by queries, which would then race each other
+#error "ConcurrentCalendar can't be used with CHRONOS_EVENT_OCCURRENCE_CACHE"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// CHRONOS_CONCURRENT_MAX_READERS -- default number of queries that may be
+// in progress at once, on a ConcurrentCalendar.  Any more wait for a free slot.
+#ifndef CHRONOS_CONCURRENT_MAX_READERS
+#define CHRONOS_CONCURRENT_MAX_READERS	32
+#endif
+
+namespace Chronos {
+
+/*
+ * ConcurrentCalendar<MAXNUM, MAXREADERS>
+ *
+ * Holds up to MAXNUM events, like CalendarStaticArray<MAXNUM>, as a series of
+ * immutable versions:
+ *
+ *   - queries (listNext(), listOngoing()...) run against the current version, and
+ *     never lock or wait on writers;
+ *
+ *   - updates (add(), remove()...) are serialized amongst themselves, and each
+ *     publishes a modified copy of the current version.  Use update() to apply
+ *     a number of changes as a single version.
+ *
+ * Superseded versions are freed by writers, once every query that might still be
+ * looking at them is done (epoch-based reclamation: each query announces the
+ * epoch it started in, each retired version the epoch it was replaced in).
+ *
+ * For a number of queries that must all see the same state, take a snapshot():
+ *
+ * 	Chronos::ConcurrentCalendar<50>::Snapshot snap(MyCalendar.snapshot());
+ * 	uint8_t numOngoing = snap.listOngoing(10, ongoing, now);
+ * 	uint8_t numNext = snap.listNext(10, upcoming, now);
+ *
+ * Queries only read events, so versions are safe to share.  Copies of events
+ * (new versions, eventAt() results...) share user-defined marks, whose reference
+ * counts are atomic on hosts.
+ *
+ * Needs C++11 and is only available with CHRONOS_CONCURRENT_CALENDAR defined (see
+ * ChronosConfig.h).
+ */
+template<uint8_t MAXNUM, uint8_t MAXREADERS = CHRONOS_CONCURRENT_MAX_READERS>
+class ConcurrentCalendar {
+private:
+	class Version {
+	public:
+		Version() : retired_at(0), next_retired(NULL) {}
+		Version(const Version & other) : calendar(other.calendar), retired_at(0), next_retired(NULL) {}
+
+		CalendarStaticArray<MAXNUM> calendar;
+		uint64_t retired_at;
+		Version * next_retired;
+	};
+
+public:
+	/*
+	 * Snapshot -- a pinned version of the calendar.  Every query made through
+	 * it sees the same events.  Hold on to it only as long as needed: versions
+	 * retired while it's around can't be freed.
+	 */
+	class Snapshot {
+	public:
+		Snapshot(Snapshot && other) : owner(other.owner), slot(other.slot), version(other.version)
+		{
+			other.owner = NULL;
+		}
+		~Snapshot()
+		{
+			if (owner)
+				owner->leave(slot);
+		}
+
+		uint32_t numEvents() { return version->calendar.numEvents(); }
+		uint8_t numRecurring() { return version->calendar.numRecurring(); }
+
+		uint8_t listNext(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+			return version->calendar.listNext(maxNumber, intoArray, dt);
+		}
+		uint8_t listNext(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+			return version->calendar.listNext(tag, maxNumber, intoArray, dt);
+		}
+		uint8_t listOngoing(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+			return version->calendar.listOngoing(maxNumber, intoArray, dt);
+		}
+		uint8_t listOngoing(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+			return version->calendar.listOngoing(tag, maxNumber, intoArray, dt);
+		}
+		uint8_t listForDay(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+			return version->calendar.listForDay(maxNumber, intoArray, dt);
+		}
+		bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT) {
+			return version->calendar.nextDateTimeOfInterest(fromDT, returnDT);
+		}
+
+	private:
+		friend class ConcurrentCalendar;
+		Snapshot(ConcurrentCalendar * cal, uint8_t rslot, Version * v) : owner(cal), slot(rslot), version(v) {}
+		Snapshot(const Snapshot &) = delete;
+		Snapshot & operator=(const Snapshot &) = delete;
+
+		ConcurrentCalendar * owner;
+		uint8_t slot;
+		Version * version;
+	};
+
+	ConcurrentCalendar() : current(new Version()), epoch(1), retired(NULL)
+	{
+		for (uint8_t i=0; i<MAXREADERS; i++)
+			readers[i].epoch.store(0);
+	}
+
+	/*
+	 * Destruction frees all versions: no queries may be in progress.
+	 */
+	~ConcurrentCalendar()
+	{
+		delete current.load();
+		while (retired)
+		{
+			Version * v = retired;
+			retired = v->next_retired;
+			delete v;
+		}
+	}
+
+	/*
+	 * snapshot()
+	 * @return: a Snapshot of the current version, for consistent queries.
+	 */
+	Snapshot snapshot()
+	{
+		uint8_t slot = enter();
+		return Snapshot(this, slot, current.load());
+	}
+
+	/*
+	 * Queries: each runs against the version current when it's called.
+	 */
+	uint32_t numEvents() { return snapshot().numEvents(); }
+	uint8_t numRecurring() { return snapshot().numRecurring(); }
+
+	uint8_t listNext(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+		return snapshot().listNext(maxNumber, intoArray, dt);
+	}
+	uint8_t listNext(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+		return snapshot().listNext(tag, maxNumber, intoArray, dt);
+	}
+	uint8_t listOngoing(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+		return snapshot().listOngoing(maxNumber, intoArray, dt);
+	}
+	uint8_t listOngoing(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+		return snapshot().listOngoing(tag, maxNumber, intoArray, dt);
+	}
+	uint8_t listForDay(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt) {
+		return snapshot().listForDay(maxNumber, intoArray, dt);
+	}
+	bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT) {
+		return snapshot().nextDateTimeOfInterest(fromDT, returnDT);
+	}
+
+	/*
+	 * update(mutator)
+	 *
+	 * Apply any number of changes as a single new version.  mutator is called with
+	 * a Calendar & to modify, and returns true to publish the result (false throws
+	 * it away):
+	 *
+	 * 	MyCalendar.update([&](Chronos::Calendar & cal) {
+	 * 		return cal.remove(4) && cal.add(replacement);
+	 * 	});
+	 *
+	 * @return: what mutator returned.
+	 */
+	template<class Mutator>
+	bool update(Mutator mutator)
+	{
+		std::lock_guard<std::mutex> lock(write_lock);
+
+		Version * next = new Version(*(current.load()));
+		if (! mutator(static_cast<Calendar &>(next->calendar)))
+		{
+			delete next;
+			return false;
+		}
+
+		publish(next);
+		return true;
+	}
+
+	/*
+	 * Single updates, as in Calendar.
+	 */
+	bool add(const Chronos::Event & event) {
+		return update([&event](Calendar & cal) { return cal.add(event); });
+	}
+	bool add(Chronos::Event && event) {
+		return update([&event](Calendar & cal) { return cal.add(std::move(event)); });
+	}
+	bool emplace(EventID id, const DateTime & start, const DateTime & end) {
+		return update([&](Calendar & cal) { return cal.emplace(id, start, end); });
+	}
+	bool remove(EventID evId) {
+		return update([evId](Calendar & cal) { return cal.remove(evId); });
+	}
+	bool setTag(EventID evId, EventTag tag) {
+		return update([evId, tag](Calendar & cal) { return cal.setTag(evId, tag); });
+	}
+	void clear() {
+		update([](Calendar & cal) { cal.clear(); return true; });
+	}
+
+private:
+	ConcurrentCalendar(const ConcurrentCalendar &) = delete;
+	ConcurrentCalendar & operator=(const ConcurrentCalendar &) = delete;
+
+	// one reader slot per cache line, so queries on different cores don't
+	// bounce the same line around
+	struct alignas(64) ReaderSlot {
+		std::atomic<uint64_t> epoch; // 0 when free
+	};
+
+	uint8_t enter()
+	{
+		// threads start looking at "their" slot, so they usually get it right away
+		static std::atomic<uint8_t> thread_counter(0);
+		static thread_local uint8_t hint = thread_counter.fetch_add(1);
+
+		uint64_t now = epoch.load();
+		for (uint8_t i=hint % MAXREADERS; ; i = (i + 1) % MAXREADERS)
+		{
+			uint64_t free = 0;
+			if (readers[i].epoch.compare_exchange_weak(free, now))
+			{
+				return i;
+			}
+
+			if (i == ((hint + MAXREADERS - 1) % MAXREADERS))
+			{
+				// all taken
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void leave(uint8_t slot)
+	{
+		readers[slot].epoch.store(0);
+	}
+
+	void publish(Version * next)
+	{
+		Version * old = current.exchange(next);
+
+		// queries entering from here on get next, only those that announced
+		// an epoch <= this one may still be using old.
+		old->retired_at = epoch.fetch_add(1);
+		old->next_retired = retired;
+		retired = old;
+
+		reclaim();
+	}
+
+	void reclaim()
+	{
+		uint64_t oldestActive = UINT64_MAX;
+		for (uint8_t i=0; i<MAXREADERS; i++)
+		{
+			uint64_t e = readers[i].epoch.load();
+			if (e && e < oldestActive)
+				oldestActive = e;
+		}
+
+		Version ** link = &retired;
+		while (*link)
+		{
+			Version * v = *link;
+			if (v->retired_at < oldestActive)
+			{
+				*link = v->next_retired;
+				delete v;
+			} else {
+				link = &(v->next_retired);
+			}
+		}
+	}
+
+	std::atomic<Version *> current;
+	std::atomic<uint64_t> epoch;
+	ReaderSlot readers[MAXREADERS];
+
+	std::mutex write_lock;
+	Version * retired; // only touched with write_lock held
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_CONCURRENT_CALENDAR */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_CONCURRENTCALENDAR_H_ */
@@ -0,0 +1,241 @@
+/*
+ * IcsImporter.h
+ *
+ * Streaming import of iCalendar (.ics, RFC 5545) VEVENTs into a calendar.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_ICSIMPORTER_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_ICSIMPORTER_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+// CHRONOS_ICS_LINE_MAX -- longest (unfolded) content line kept, longer ones
+// (e.g. lengthy DESCRIPTIONs) are ignored
+#ifndef CHRONOS_ICS_LINE_MAX
+#define CHRONOS_ICS_LINE_MAX	256
+#endif
+
+// CHRONOS_ICS_TEXT_MAX -- room for the UID and SUMMARY handed to the Listener,
+// including the terminating nul (they're truncated to fit)
+#ifndef CHRONOS_ICS_TEXT_MAX
+#define CHRONOS_ICS_TEXT_MAX	64
+#endif
+
+namespace Chronos {
+
+/*
+ * IcsImporter
+ *
+ * Parses iCalendar data as it comes, chunk by chunk, and adds a Chronos::Event
+ * to the calendar for each VEVENT:
+ *
+ * 	Chronos::IcsImporter importer(MyCalendar);
+ * 	while ((numRead = fread(buf, 1, sizeof(buf), icsFile)) > 0)
+ * 		importer.feed(buf, numRead);
+ * 	importer.finish();
+ *
+ * Only one (unfolded) content line is held at a time, so input of any size
+ * goes through a fixed CHRONOS_ICS_LINE_MAX buffer, and the chunks may be split
+ * anywhere.  The whole import is a single Calendar::beginUpdate()/endUpdate()
+ * batch.
+ *
+ * DTSTART, DTEND and DURATION give one-time events.  An RRULE makes a
+ * recurring event instead, with the built-in mark that matches:
+ *
+ * 	FREQ=HOURLY/DAILY						Hourly, Daily
+ * 	FREQ=WEEKLY (or DAILY) ;BYDAY=MO,WE...	one Weekly per day, all with the same id
+ * 	FREQ=MONTHLY ;BYMONTHDAY=15				Monthly
+ * 	FREQ=MONTHLY ;BYDAY=-1FR (or ;BYSETPOS)	MonthlyNthWeekday
+ * 	FREQ=YEARLY ;BYMONTH ;BYMONTHDAY		Yearly
+ * 	any fixed period with INTERVAL > 1,
+ * 	FREQ=MINUTELY/SECONDLY					Every
+ *
+ * bounded by DTSTART (see Chronos::Event::setFrom()), and by COUNT or UNTIL.
+ * Rules that don't fit any of those (e.g. COUNT across several BYDAYs,
+ * monthly/yearly INTERVALs), cancelled events and malformed ones are skipped.
+ *
+ * Chronos has no time zones: times are taken as written, in whatever time
+ * Chronos runs on.  UTC times (with a trailing Z) are converted with the
+ * offset given to setUtcOffset() -- events with UTC times are skipped until
+ * there is one -- and events with times in a TZID are skipped.
+ *
+ * Events with EXDATEs or RDATEs are skipped too, rather than imported with
+ * occurrences added or missing (Chronos::Event exceptions live in arrays the
+ * caller owns, see Chronos::Event::setExceptions()), as are the RECURRENCE-ID
+ * overrides of single occurrences.  Components nested in VEVENTs, like
+ * VALARMs, are ignored.
+ *
+ * Events get the id given to the constructor, unless a Listener says otherwise.
+ */
+class IcsImporter {
+public:
+	class Listener {
+	public:
+		virtual ~Listener() {}
+
+		/*
+		 * imported(event, uid, summary)
+		 * Called for each event before it goes in the calendar: set its id or tag, or
+		 * put it somewhere else (e.g. a CalendarImage::Builder).
+		 * @return: true to have it added to the calendar
+		 */
+		virtual bool imported(Chronos::Event & event, const char * uid, const char * summary) = 0;
+	};
+
+	/*
+	 * IcsImporter(calendar, id, listener)
+	 * @param calendar: where the events go
+	 * @param id: EventID they all get, by default
+	 * @param listener: optional, see Listener above
+	 */
+	IcsImporter(Calendar & calendar, EventID id=1, Listener * listener=NULL);
+
+	/*
+	 * Destruction finish()es, if need be.
+	 */
+	~IcsImporter();
+
+	/*
+	 * setUtcOffset(seconds)
+	 * Convert UTC times to Chronos' time, which is seconds ahead of UTC (e.g.
+	 * -5 * 3600 for EST -- a fixed offset, as there's no DST here either).
+	 */
+	void setUtcOffset(int32_t seconds);
+
+	/*
+	 * feed(data, len)
+	 * Parse the next len bytes of the input.
+	 */
+	void feed(const char * data, uint32_t len);
+
+	/*
+	 * finish()
+	 * Handle whatever remains of the input and close the calendar's batch.
+	 * @return: number of events added to the calendar.
+	 */
+	uint32_t finish();
+
+	/*
+	 * numAdded()/numSkipped()
+	 * @return: events added to the calendar so far, and VEVENTs that couldn't be
+	 * (unsupported, malformed, cancelled, with times in a TZID, with EXDATEs... see
+	 * above, or refused by a full calendar).  Events
+	 * the Listener kept out of the calendar are in neither.
+	 */
+	inline uint32_t numAdded() const { return num_added; }
+	inline uint32_t numSkipped() const { return num_skipped; }
+
+private:
+	IcsImporter(const IcsImporter & other);
+	IcsImporter & operator=(const IcsImporter & other);
+
+	typedef enum {
+		NoFreq=0,
+		Secondly,
+		Minutely,
+		Hourly,
+		Daily,
+		Weekly,
+		Monthly,
+		Yearly
+	} Frequency;
+
+	/*
+	 * What's been gathered about the VEVENT being parsed.
+	 */
+	class Pending {
+	public:
+		Pending() { reset(); }
+		void reset();
+
+		Chronos::EpochTime start;
+		Chronos::EpochTime end;
+		Chronos::EpochTime length;
+		Chronos::EpochTime until;
+		uint32_t interval;
+		uint16_t count;
+		bool has_start;
+		bool has_end;
+		bool has_length;
+		bool has_until;
+		bool all_day;
+		bool invalid;
+		bool cancelled;
+		uint8_t freq;
+		uint8_t by_day; // bit (Weekday::Day - 1) for each day listed
+		int8_t nth; // of the BYDAY, for monthly rules
+		uint8_t by_month_day;
+		uint8_t by_month;
+		char uid[CHRONOS_ICS_TEXT_MAX];
+		char summary[CHRONOS_ICS_TEXT_MAX];
+	};
+
+	void append(const char * data, uint32_t len);
+	void processLine();
+	// params are the line's ;NAME=VALUE parameters, if any
+	void property(const char * name, uint16_t nameLen, const char * params, uint16_t paramsLen,
+			const char * value, uint16_t valueLen);
+	void endEvent();
+	void addRecurring(Chronos::EpochTime length);
+	// DTSTART, COUNT and UNTIL, as the event's bounds
+	void bound(Chronos::Event & event, const DateTime & from);
+	void add(Chronos::Event & event);
+
+	bool parseRule(const char * value, uint16_t len);
+
+	/*
+	 * parseDateTime(value, len, into, isDate)
+	 * @return: false unless value is a DATE (YYYYMMDD) or DATE-TIME (YYYYMMDDTHHMMSS, Z or not)
+	 */
+	static bool parseDateTime(const char * value, uint16_t len, Chronos::EpochTime & into, bool & isDate,
+			bool & isUtc);
+	// parseDateTime(), and UTC times converted, @return: false if they can't be
+	bool readDateTime(const char * value, uint16_t len, Chronos::EpochTime & into, bool & isDate);
+	// an RFC 5545 DURATION, e.g. PT1H30M, or P1W, into seconds
+	static bool parseDuration(const char * value, uint16_t len, Chronos::EpochTime & into);
+	static void copyText(char * into, const char * value, uint16_t len);
+
+	Calendar & cal;
+	Listener * listener;
+	EventID default_id;
+	int32_t utc_offset;
+	bool has_utc_offset;
+
+	char line[CHRONOS_ICS_LINE_MAX];
+	uint16_t line_len;
+	bool line_overflow;
+	bool line_complete; // waiting to see whether the next line continues it
+
+	bool in_event;
+	uint8_t nested; // depth of components within the VEVENT
+	bool finished;
+	Pending pending;
+
+	uint32_t num_added;
+	uint32_t num_skipped;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_ICSIMPORTER_H_ */
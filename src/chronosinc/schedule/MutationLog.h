@@ -0,0 +1,212 @@
+/*
+ * MutationLog.h
+ *
+ * Durable calendars: a write-ahead log of calendar changes, with snapshots,
+ * replayed on restart.  POSIX hosts only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONLOG_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONLOG_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_MUTATION_LOG
+
+#if !defined(CHRONOS_PLATFORM_POSIX) || !defined(PLATFORM_SUPPORTS_RVAL_MOVE)
+#error "MutationLog needs a POSIX host and C++11 (and ENABLE_UTILITY_INCLUDE)"
+#endif
+
+#include <string>
+#include <vector>
+
+// CHRONOS_MUTATION_LOG_BUFFER -- bytes of changes held between commits: when
+// full, the next change commits them first
+#ifndef CHRONOS_MUTATION_LOG_BUFFER
+#define CHRONOS_MUTATION_LOG_BUFFER		(64 * 1024UL)
+#endif
+
+// CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES -- log size past which a commit takes a
+// snapshot, which bounds the replay on restart
+#ifndef CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES
+#define CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES	(4 * 1024 * 1024UL)
+#endif
+
+namespace Chronos {
+
+/*
+ * MutationLog
+ *
+ * Makes changes to a calendar survive a crash.  Changes go through the log,
+ * which applies them to the calendar and records them:
+ *
+ * 	Chronos::MutationLog log(MyCalendar);
+ * 	log.open("/var/lib/myapp/calendar"); // recovers whatever was there
+ * 	...
+ * 	log.add(Chronos::Event(3, Chronos::DateTime(2026, 10, 19, 9), Chronos::Span::Hours(1)));
+ * 	log.remove(2);
+ * 	log.commit(); // both are now on disk
+ *
+ * Changes are encoded as compact binary records (a handful of bytes each, 31
+ * for a recurring event) into a buffer, and commit() writes the whole buffer
+ * as a single checksummed frame, then fdatasync()s once: the cost of the sync
+ * is shared by every change in the group, and a change only costs its encoding
+ * until then.  Changes not yet committed are lost in a crash.
+ *
+ * Once the log outgrows CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES, commit() takes a
+ * snapshot(): the calendar's events (see Calendar::eventAt()), written to a new
+ * file that's then renamed over the previous snapshot, after which the log starts
+ * over.  If the snapshot fails, commit() leaves it until the log has grown by
+ * another CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES.  open() loads the snapshot and replays the log written since, so recovery
+ * time depends on the calendar's size, not its history.  A frame torn by a crash
+ * fails its checksum and is dropped, with anything after it.
+ *
+ * Files: path.snap and path.log, each starting with the generation they belong
+ * to, which is how a log that a newer snapshot already covers is recognized.
+ *
+ * Like CalendarImage, the log only takes recurring events with built-in marks and
+ * no exceptions -- add() refuses the others -- and values are in the host's byte
+ * order.  Recovery should be into the same type of calendar, so events land in
+ * the same order (remove() takes the first event with the id).  Changes made to
+ * the calendar directly aren't logged.  Single-threaded, like the calendar; use
+ * a MutationQueue in front of it for other threads.
+ *
+ * Needs a POSIX host and C++11, and is only available with CHRONOS_MUTATION_LOG
+ * defined (see ChronosConfig.h).
+ */
+class MutationLog {
+public:
+	MutationLog(Calendar & calendar);
+
+	/*
+	 * Destruction commits what's pending.
+	 */
+	~MutationLog();
+
+	/*
+	 * open(path)
+	 *
+	 * Empty the calendar, load it back from path.snap and path.log (if they exist),
+	 * and log changes to path.log from here on.
+	 * @return: false if a file couldn't be read or created, or the snapshot is damaged.
+	 */
+	bool open(const char * path);
+
+	/*
+	 * close() -- commit() and stop logging.
+	 */
+	void close();
+
+	inline bool isOpen() const { return log_fd >= 0; }
+
+	/*
+	 * The changes, as for the Calendar methods of the same name.
+	 * @return: false if the calendar refused the change, or it can't be logged.
+	 */
+	bool add(const Chronos::Event & event);
+	bool remove(EventID evId);
+	bool setTag(EventID evId, EventTag tag);
+	bool clear();
+
+	/*
+	 * commit()
+	 * Write the changes pending, and sync them to disk.
+	 * @return: success -- when false, the changes are still pending.
+	 */
+	bool commit();
+
+	/*
+	 * snapshot()
+	 * Commit, save the whole calendar and start an empty log.
+	 * @return: success
+	 */
+	bool snapshot();
+
+	/*
+	 * numReplayed() -- changes (snapshot events included) applied by open().
+	 * numCommits() -- number of syncs so far, each for a group of changes.
+	 * logSize() -- bytes committed to the current log.
+	 */
+	inline uint32_t numReplayed() const { return num_replayed; }
+	inline uint32_t numCommits() const { return num_commits; }
+	inline uint32_t logSize() const { return log_size; }
+	inline uint32_t generation() const { return log_generation; }
+
+private:
+	MutationLog(const MutationLog &) = delete;
+	MutationLog & operator=(const MutationLog &) = delete;
+
+	typedef enum {
+		AddOneTime=1,
+		AddRecurring,
+		Remove,
+		SetTag,
+		Clear
+	} RecordType;
+
+	// room for the largest record
+	typedef uint8_t Record[32];
+
+	/*
+	 * encode(event, into)
+	 * @return: bytes of the record for adding event, 0 if it can't be logged.
+	 */
+	static uint8_t encode(const Chronos::Event & event, Record & into);
+
+	// make room for len more bytes of records, committing if need be
+	bool reserve(uint8_t len);
+	inline void append(const uint8_t * record, uint8_t len) {
+		pending.insert(pending.end(), record, record + len);
+	}
+
+	/*
+	 * replay(data, size, magic, generation, goodSize)
+	 * Apply the records in a file (mapped at data) with the given magic.
+	 * @return: false unless the header's fine, with generation and goodSize (what's
+	 * left once any torn frames are dropped) set.
+	 */
+	bool replay(const uint8_t * data, uint32_t size, const char * magic,
+			uint32_t & generation, uint32_t & goodSize);
+	bool applyRecords(const uint8_t * records, uint32_t len);
+
+	// write a new, empty, log for the generation and switch to it
+	bool startLog(uint32_t generation);
+
+	Calendar & cal;
+	std::string log_path;
+	std::string snapshot_path;
+	std::vector<uint8_t> pending; // the frame being built, header space first
+	int log_fd;
+	uint32_t log_size;
+	uint32_t log_generation;
+	uint32_t snapshot_at; // log size past which commit() takes a snapshot
+	bool snapshotting;
+	uint32_t num_replayed;
+	uint32_t num_commits;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_MUTATION_LOG */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONLOG_H_ */
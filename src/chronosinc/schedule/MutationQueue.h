@@ -0,0 +1,233 @@
+/*
+ * MutationQueue.h
+ *
+ * A lock-free queue of calendar changes, posted from any number of threads
+ * and applied in batches by the thread that owns the calendar.  Host
+ * (multi-threaded OS) builds only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONQUEUE_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONQUEUE_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_MUTATION_QUEUE
+
+#ifndef PLATFORM_SUPPORTS_RVAL_MOVE
+#error "MutationQueue needs C++11 (and ENABLE_UTILITY_INCLUDE)"
+#endif
+
+#include <atomic>
+#include <new>
+
+namespace Chronos {
+
+/*
+ * MutationQueue
+ *
+ * Producers post add()/remove()/setTag()/clear() requests, which never block
+ * (beyond allocating the request): each is a single atomic exchange on the
+ * queue head.  The thread that owns the calendar periodically calls
+ *
+ * 	changes.applyTo(MyCalendar);
+ *
+ * which pops the pending requests in order and applies them as a single
+ * Calendar update batch (see Calendar::beginUpdate()), so the calendar's
+ * index is only rebuilt once.  Requests from any one producer are applied
+ * in the order they were posted.
+ *
+ * Posting add(Event&&) hands the event over without copying.  add(const Event &)
+ * posts a copy, which shares the event's user-defined mark, if any: that's fine
+ * from any thread, as mark reference counts are atomic on hosts.
+ *
+ * Needs C++11 and is only available with CHRONOS_MUTATION_QUEUE defined (see
+ * ChronosConfig.h).
+ */
+class MutationQueue {
+public:
+	MutationQueue() : head(&stub), tail(&stub), num_rejected(0)
+	{
+		stub.next.store(NULL);
+	}
+
+	/*
+	 * Destruction drops any changes not yet applied.  No producer may still
+	 * be posting.
+	 */
+	~MutationQueue()
+	{
+		Request * req;
+		while ((req = pop()))
+			delete req;
+	}
+
+	/*
+	 * Posting changes, from any thread.
+	 * @return: false only if the request couldn't be allocated.
+	 */
+	bool add(const Chronos::Event & event) { return post(new (std::nothrow) Request(Request::Add, event)); }
+	bool add(Chronos::Event && event) { return post(new (std::nothrow) Request(std::move(event))); }
+	bool remove(EventID evId) { return post(new (std::nothrow) Request(Request::Remove, evId)); }
+	bool setTag(EventID evId, EventTag tag) { return post(new (std::nothrow) Request(Request::SetTag, evId, tag)); }
+	bool clear() { return post(new (std::nothrow) Request(Request::Clear, EVENTID_NOTSET)); }
+
+	/*
+	 * applyTo(calendar, maxNumber)
+	 *
+	 * Apply pending changes to calendar, from the thread that owns it.
+	 * @param maxNumber: upper bound on the number of changes applied in this batch
+	 * @return: number of changes taken off the queue
+	 */
+	uint16_t applyTo(Calendar & calendar, uint16_t maxNumber=0xffff)
+	{
+		uint16_t numApplied = 0;
+		calendar.beginUpdate();
+		Request * req;
+		while (numApplied < maxNumber && (req = pop()))
+		{
+			if (! apply(calendar, *req))
+				num_rejected++;
+
+			delete req;
+			numApplied++;
+		}
+		calendar.endUpdate();
+
+		return numApplied;
+	}
+
+	/*
+	 * numRejected()
+	 * @return: number of changes the calendar refused so far (full, unknown id...)
+	 */
+	inline uint32_t numRejected() const { return num_rejected; }
+
+private:
+	MutationQueue(const MutationQueue &) = delete;
+	MutationQueue & operator=(const MutationQueue &) = delete;
+
+	class Request {
+	public:
+		typedef enum { Add=0, Remove, SetTag, Clear } Type;
+
+		Request() : type(Clear), id(EVENTID_NOTSET), tag(EVENTTAG_NONE) {}
+		Request(Type t, const Chronos::Event & evt) : type(t), id(evt.id()), tag(evt.tag()), event(evt) {}
+		Request(Chronos::Event && evt) : type(Add), id(evt.id()), tag(evt.tag()), event(std::move(evt)) {}
+		Request(Type t, EventID evId, EventTag evTag=EVENTTAG_NONE) : type(t), id(evId), tag(evTag) {}
+
+		std::atomic<Request *> next;
+		uint8_t type;
+		EventID id;
+		EventTag tag;
+		Chronos::Event event;
+	};
+
+	static bool apply(Calendar & calendar, Request & req)
+	{
+		switch (req.type)
+		{
+		case Request::Add:
+			return calendar.add(std::move(req.event));
+		case Request::Remove:
+			return calendar.remove(req.id);
+		case Request::SetTag:
+			return calendar.setTag(req.id, req.tag);
+		case Request::Clear:
+			calendar.clear();
+			return true;
+		}
+		return false;
+	}
+
+	/*
+	 * An intrusive multi-producer, single-consumer list (D. Vyukov's): producers
+	 * swap themselves in as the head and then link the previous head to them;
+	 * the consumer follows the links from the tail.  The stub keeps the list
+	 * from ever being empty.
+	 */
+	bool post(Request * req)
+	{
+		if (! req)
+			return false;
+
+		push(req);
+		return true;
+	}
+
+	void push(Request * req)
+	{
+		req->next.store(NULL, std::memory_order_relaxed);
+		Request * prev = head.exchange(req, std::memory_order_acq_rel);
+		prev->next.store(req, std::memory_order_release);
+	}
+
+	Request * pop()
+	{
+		Request * t = tail;
+		Request * next = t->next.load(std::memory_order_acquire);
+		if (t == &stub)
+		{
+			if (! next)
+				return NULL;
+
+			tail = next;
+			t = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (next)
+		{
+			tail = next;
+			return t;
+		}
+
+		if (t != head.load(std::memory_order_acquire))
+		{
+			// a producer is between its exchange and its link: catch it next time
+			return NULL;
+		}
+
+		// t is the last one, put the stub back behind it so it can be taken
+		push(&stub);
+		next = t->next.load(std::memory_order_acquire);
+		if (next)
+		{
+			tail = next;
+			return t;
+		}
+
+		return NULL;
+	}
+
+	std::atomic<Request *> head;
+	Request * tail; // consumer only
+	Request stub;
+	uint32_t num_rejected;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_MUTATION_QUEUE */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_MUTATIONQUEUE_H_ */
@@ -0,0 +1,115 @@
+/*
+ * ScheduleReplay.h
+ * Steps through a calendar from one event start/end to the next, for
+ * accelerated replays of its schedule.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_SCHEDULEREPLAY_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_SCHEDULEREPLAY_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+namespace Chronos {
+
+/*
+ * ScheduleReplay
+ *
+ * Replays everything a calendar would dispatch over some period, without
+ * waiting for it to happen: it jumps from one DateTime of interest to the next
+ * (see Calendar::nextDateTimeOfInterest()) and tells a listener which
+ * occurrences ended and started there.
+ *
+ * 	class Dispatcher : public Chronos::ScheduleReplay::Listener {
+ * 		virtual void started(const Chronos::DateTime & at,
+ * 				const Chronos::Event::Occurrence occurrences[], uint8_t num) { ... }
+ * 	};
+ *
+ * 	Chronos::ScheduleReplay replay(MyCalendar);
+ * 	Dispatcher dispatcher;
+ * 	replay.run(Chronos::DateTime(2026, 1, 1), Chronos::DateTime(2027, 1, 1), dispatcher);
+ *
+ * With CHRONOS_CLOCK_SIMULATED, the SimulatedClock is set to each of those
+ * DateTimes before the listener hears about it, so code that relies on
+ * DateTime::now() behaves as it would live.
+ *
+ * Listeners may change the calendar: changes are seen from the next step.
+ */
+class ScheduleReplay {
+public:
+	class Listener {
+	public:
+		virtual ~Listener() {}
+
+		/*
+		 * ended(at, occurrences, num) -- occurrences that were on-going, and finished
+		 * at 'at'.  Called before started() for the same DateTime -- and once more
+		 * after it, for zero-length occurrences, which start and end at 'at'.
+		 */
+		virtual void ended(const DateTime & at, const Event::Occurrence occurrences[], uint8_t num) {}
+
+		/*
+		 * started(at, occurrences, num) -- occurrences that begin at 'at'.
+		 */
+		virtual void started(const DateTime & at, const Event::Occurrence occurrences[], uint8_t num) {}
+	};
+
+	ScheduleReplay(Calendar & calendar);
+	~ScheduleReplay();
+
+	/*
+	 * run(from, until, listener)
+	 *
+	 * Replay every start and end in [from, until].  Occurrences already on-going
+	 * at 'from' are only reported when they end.
+	 *
+	 * @return: the number of DateTimes stepped through
+	 */
+	uint32_t run(const DateTime & from, const DateTime & until, Listener & listener);
+
+	/*
+	 * numStarted()/numEnded()
+	 * @return: occurrences reported to the listener by the last run().
+	 */
+	inline uint32_t numStarted() const { return num_started;}
+	inline uint32_t numEnded() const { return num_ended;}
+
+private:
+	ScheduleReplay(const ScheduleReplay &);
+	ScheduleReplay & operator=(const ScheduleReplay &);
+
+	bool reserve(uint16_t num, uint8_t numPrevious);
+
+	Calendar & cal;
+	Event::Occurrence * ongoing;
+	Event::Occurrence * previous; // what was on-going at the last step
+	Event::Occurrence * starting;
+	Event::Occurrence * changed;
+	uint8_t capacity;
+	uint32_t num_started;
+	uint32_t num_ended;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_SCHEDULEREPLAY_H_ */
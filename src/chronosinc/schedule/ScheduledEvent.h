@@ -38,12 +38,23 @@
 #include "../platform/platform.h"
 
 #define EVENTID_NOTSET		-1
+#define EVENT_MARK_NOTSET	0xff
+#define EVENTTAG_NONE		0
+// last start of a series that goes on forever
+#define EVENT_SERIES_FOREVER	0xffffffffUL
 
 namespace Chronos {
 
 
 typedef int8_t EventID;
 
+/*
+ * EventTag -- a small category number, shared by any events you want to
+ * query together (e.g. all events for a given room).  Calendars index the
+ * first CHRONOS_CALENDAR_INDEXED_TAGS values (see ChronosConfig.h).
+ */
+typedef uint8_t EventTag;
+
 
 /*
  * Chronos::Event class
@@ -196,11 +207,55 @@ public:
 	void reset();
 
 	/*
-	 * id()
+	 * set(id, start, end)
+	 *
+	 * Re-initialize this event, in place, as a one-time event -- the equivalent of
+	 * assigning it a Chronos::Event(id, start, end).
+	 */
+	void set(EventID id, const DateTime & start, const DateTime & end);
+
+#ifdef PLATFORM_SUPPORTS_RVAL_MOVE
+	/*
+	 * set<MarkType>(id, duration, markArgs...)
+	 *
+	 * Re-initialize this event, in place, as a recurring event whose mark is constructed
+	 * directly from markArgs, rather than copied from a temporary, e.g.
+	 *
+	 * 	evt.set<Chronos::Mark::Daily>(2, Chronos::Span::Minutes(45), 9, 0, 0);
+	 *
+	 * Mostly used through Calendar::emplace().
+	 */
+	template<class MarkType, class... MarkArgs>
+	void set(EventID id, const Chronos::Span::Delta & evtDuration, MarkArgs&&... markArgs)
+	{
+		event_id = id;
+		event_tag = EVENTTAG_NONE;
+		is_recurring = true;
+		duration = evtDuration;
+		setSeries(0, EVENT_SERIES_FOREVER);
+		exceptions = Exceptions();
+		emplaceMark<MarkType>(std::forward<MarkArgs>(markArgs)...);
+	}
+#endif
+
+	/*
+	 * id()/setId(id)
+	 *
+	 * @return: EventID specified during construction -- or since, with setId(), which
+	 * only makes sense before the event is added to a calendar.
+	 */
+	EventID id() const { return event_id;}
+	void setId(EventID id) { event_id = id;}
+
+	/*
+	 * tag()/setTag(tag)
 	 *
-	 * @return: EventID specified during construction.
+	 * The category the event belongs to, EVENTTAG_NONE by default.  Set it before
+	 * adding the event to a calendar (or use Calendar::setTag()), and the
+	 * calendar's filtered queries will find it.
 	 */
-	EventID id() { return event_id;}
+	EventTag tag() const { return event_tag;}
+	void setTag(EventTag tag) { event_tag = tag;}
 
 	/*
 	 * isRecurring()
@@ -209,6 +264,81 @@ public:
 	 */
 	bool isRecurring() const { return is_recurring; }
 
+	/*
+	 * isValid()
+	 *
+	 * @return: false for a recurring event whose mark is missing or couldn't be
+	 * built as asked (see Mark::Event::isValid()) -- calendars won't add those.
+	 */
+	bool isValid() const;
+
+	/*
+	 * start()/finish()
+	 *
+	 * @return: the bounding DateTimes of a one-time event.  Recurring events
+	 * don't have fixed bounds, see nextOccurrence() for those (they keep the
+	 * series bounds, see setFrom()/setUntil(), here instead).
+	 */
+	inline const DateTime & start() const { return dt_start; }
+	inline const DateTime & finish() const { return dt_end; }
+
+	/*
+	 * Bounding recurring events.
+	 *
+	 * By default, recurring events go on forever.  They may be limited to end at some
+	 * DateTime (UNTIL), or to a number of occurrences (COUNT), and specific occurrences
+	 * may be excluded:
+	 *
+	 * 	Chronos::Event standup(1, Chronos::Mark::Daily(9, 0, 0), Chronos::Span::Minutes(15));
+	 * 	standup.setCount(10, Chronos::DateTime(2026, 11, 2)); // 10 days, starting Nov 2nd
+	 *
+	 * 	// holidays, sorted -- the array is *not* copied, it must stick around
+	 * 	static const Chronos::DateTime holidays[] = { ... };
+	 * 	standup.setExceptions(holidays, 2);
+	 *
+	 * Once a series is over, hasNext() is false and the calendar skips it in queries.
+	 */
+
+	/*
+	 * These only apply to recurring events.
+	 *
+	 * setFrom(first)
+	 * @param first: no occurrences start before this DateTime
+	 */
+	void setFrom(const DateTime & first);
+
+	/*
+	 * setUntil(last)
+	 * @param last: no occurrences start after this DateTime
+	 *
+	 * @note: like setCount(), this keeps the last occurrence at or before last (so call
+	 * it once the series has its mark), which is what hasNext() looks at.
+	 */
+	void setUntil(const DateTime & last);
+
+	/*
+	 * setCount(count, from)
+	 * @param count: number of occurrences in the series
+	 * @param from: DateTime at which the series starts (the first occurrence is at or after it)
+	 *
+	 * @note: the bound is computed here, so the mark is stepped through count times, once.
+	 */
+	void setCount(uint16_t count, const DateTime & from);
+
+	/*
+	 * setExceptions(sortedExceptions, num)
+	 * @param sortedExceptions: array of occurrence start DateTimes to skip, in increasing order.
+	 * 		The array is used in place, and must outlive the event (and its copies).
+	 * @param num: number of entries
+	 */
+	void setExceptions(const DateTime sortedExceptions[], uint8_t num);
+
+	/*
+	 * clearBounds()
+	 * Remove any UNTIL/COUNT limit and exceptions.
+	 */
+	void clearBounds();
+
 	/*
 	 * hasNext(dt)
 	 *
@@ -224,8 +354,8 @@ public:
 	 * @param dt: a DateTime
 	 * @return: Event::Occurrence for the *next* time this event happens, relative to dt (occurrence.start > dt)
 	 *
-	 * @note: will always return something valid for repeating events. For one-time events, this only makes sense
-	 * when dt > event.start.
+	 * @note: will always return something valid for repeating events, unless bounded (see setUntil()) and over.
+	 * For one-time events, this only makes sense when dt > event.start.
 	 */
 	Event::Occurrence nextOccurrence(const DateTime & fromDateTime);
 
@@ -243,6 +373,28 @@ public:
 	 */
 	Event::Occurrence closestOccurrence(const DateTime & fromDateTime);
 
+	/*
+	 * cursor(dt)
+	 *
+	 * Mostly for internal use, by the calendar.
+	 *
+	 * @param dt: a DateTime
+	 * @return: a Mark::Cursor walking the event's time mark from dt on.  Only recurring
+	 * events have a mark, for one-time events the cursor is invalid.
+	 */
+	Chronos::Mark::Cursor cursor(const DateTime & fromDateTime) const;
+
+	/*
+	 * nextOccurrence(cursor)
+	 *
+	 * @param cursor: a Mark::Cursor obtained from this event's cursor()
+	 * @return: Event::Occurrence for the next start the cursor steps to.  Repeated calls
+	 * return the same as repeatedly calling nextOccurrence(dt), feeding it the last start,
+	 * but don't redo the search each time.  Once a bounded series is over, the occurrence
+	 * returned has an id of EVENTID_NOTSET.
+	 */
+	Event::Occurrence nextOccurrence(Chronos::Mark::Cursor & cursor) const;
+
 
 	/*
 	 * Default constructor.  Needed internally but creates an Event with an invalid
@@ -252,12 +404,132 @@ public:
 
 private:
 	// private, I say!
+
+	/*
+	 * Built-in marks (Hourly, Daily...) are kept right here, in mark_store, and
+	 * called through a switch on mark_kind.  Only user-defined marks are clone()d
+	 * onto the heap and called virtually -- that clone is then shared (see
+	 * Mark::Event::retain()) by all copies of this event.
+	 */
+	const Chronos::Mark::Event * mark() const;
+	void setMark(const Chronos::Mark::Event & timeEvent);
+	void copyMark(const Event & other);
+#ifdef PLATFORM_SUPPORTS_RVAL_MOVE
+	template<class MarkType, class... MarkArgs>
+	void emplaceMark(MarkArgs&&... markArgs)
+	{
+		releaseMark();
+		if (sizeof(MarkType) <= sizeof(mark_store.bytes))
+		{
+			Chronos::Mark::Event * inPlace = new (mark_store.bytes) MarkType(std::forward<MarkArgs>(markArgs)...);
+			if (inPlace->kind() != Chronos::Mark::Event::UserDefinedKind)
+			{
+				mark_kind = inPlace->kind();
+				return;
+			}
+
+			// user-defined marks live on the heap, so we can call them virtually
+			// (clone it out before the heap pointer overwrites the storage)
+			const Chronos::Mark::Event * onHeap = inPlace->clone();
+			inPlace->~Event();
+			mark_store.heap = onHeap;
+		} else {
+			mark_store.heap = new MarkType(std::forward<MarkArgs>(markArgs)...);
+		}
+
+		if (mark_store.heap)
+		{
+			mark_kind = Chronos::Mark::Event::UserDefinedKind;
+		}
+	}
+#endif
+	void releaseMark();
+	DateTime markNext(const DateTime & dt) const;
+	DateTime markPrevious(const DateTime & dt) const;
+
+	// markNext()/markPrevious(), through the occurrence cache when enabled
+	DateTime occurrenceAfter(const DateTime & dt);
+	DateTime occurrenceBefore(const DateTime & dt);
+
+	/*
+	 * For CalendarImage and MutationLog (see CalendarImage.h, MutationLog.h), which keep
+	 * recurring events as plain data:
+	 * saveTo() unloads a recurring event with a built-in mark and no exceptions (it returns
+	 * false for anything else), restoreFrom() rebuilds one right here, without allocating.
+	 */
+	bool saveTo(Chronos::Mark::Event::Params & markParams, Chronos::EpochTime & length,
+			Chronos::EpochTime & first, Chronos::EpochTime & last) const;
+	bool restoreFrom(EventID id, EventTag tag, const Chronos::Mark::Event::Params & markParams,
+			Chronos::EpochTime length, Chronos::EpochTime first, Chronos::EpochTime last);
+	friend class CalendarImage;
+	friend class MutationLog;
+
+	/*
+	 * Series bounds, as epochs: occurrences start within [seriesFirst(), seriesLast()],
+	 * and aren't in the (caller-owned, sorted) exceptions.
+	 *
+	 * Recurring events have no use for dt_start and dt_end, and one-time events none
+	 * for series bounds, so the former keep the latter: on AVR, where every byte of an
+	 * Event is multiplied by the calendar's capacity, the bounds then only add the
+	 * exceptions' 3 bytes to each event.
+	 */
+	inline Chronos::EpochTime seriesFirst() const { return dt_start.asEpoch(); }
+	inline Chronos::EpochTime seriesLast() const { return dt_end.asEpoch(); }
+	inline void setSeries(Chronos::EpochTime first, Chronos::EpochTime last) {
+		dt_start = DateTime(first);
+		dt_end = DateTime(last);
+	}
+
+	class Exceptions {
+	public:
+		Exceptions() : list(NULL), num(0) {}
+
+		const DateTime * list;
+		uint8_t num;
+	};
+
+	bool isException(const DateTime & start) const;
+	// valid occurrence starts after (before) dt, @return: false if there are none
+	bool validNext(const DateTime & dt, DateTime & into);
+	bool validPrevious(const DateTime & dt, DateTime & into);
+
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+	/*
+	 * A pair of consecutive occurrences, prev and next, around the last query:
+	 * the next occurrence is the same for any query in [prev, next) and the
+	 * previous for any in (prev, next].  Only usable with marks that
+	 * hasFixedOccurrences().
+	 */
+	class OccurrenceCache {
+	public:
+		typedef enum { Empty=0, Valid, Unusable } State;
+		OccurrenceCache() : prev(0), next(0), state(Empty) {}
+
+		Chronos::EpochTime prev;
+		Chronos::EpochTime next;
+		uint8_t state;
+	};
+
+	// make sure the cache answers for dt, @return: false if it can't be used
+	bool occurrenceWindow(const DateTime & dt, Chronos::Mark::Event::Direction dir);
+#endif
+
 	EventID event_id;
 	bool is_recurring;
-	Chronos::Mark::Event * t_event;
+	uint8_t mark_kind;
+	EventTag event_tag;
+	union {
+		const Chronos::Mark::Event * heap;
+		void * align;
+		uint8_t bytes[CHRONOS_MARK_INLINE_SIZE];
+	} mark_store;
 	Chronos::Span::Delta duration;
 	DateTime dt_start;
 	DateTime dt_end;
+	Exceptions exceptions;
+#ifdef CHRONOS_EVENT_OCCURRENCE_CACHE
+	OccurrenceCache occ_cache;
+#endif
 
 
 };
@@ -0,0 +1,359 @@
+/*
+ * ShardedCalendar.h
+ *
+ * A calendar split across a number of internal calendars (shards), which
+ * are queried in parallel.  Host (multi-threaded OS) builds only.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_INTINCLUDES_SCHEDULE_SHARDEDCALENDAR_H_
+#define CHRONOS_INTINCLUDES_SCHEDULE_SHARDEDCALENDAR_H_
+
+#include "../../chronosinc/schedule/Calendar.h"
+
+#ifdef CHRONOS_SHARDED_CALENDAR
+
+#ifndef PLATFORM_SUPPORTS_RVAL_MOVE
+#error "ShardedCalendar needs C++11 (and ENABLE_UTILITY_INCLUDE)"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Chronos {
+
+/*
+ * ForkJoin -- a fixed set of worker threads that run the tasks [0, numTasks)
+ * of a job, with the calling thread pitching in, and return when they're
+ * all done.
+ */
+class ForkJoin {
+public:
+	ForkJoin(unsigned numWorkers) : total(0), busy(0), generation(0), stopping(false)
+	{
+		for (unsigned i=0; i<numWorkers; i++)
+			workers.emplace_back(&ForkJoin::work, this);
+	}
+
+	~ForkJoin()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (size_t i=0; i<workers.size(); i++)
+			workers[i].join();
+	}
+
+	void run(uint16_t numTasks, const std::function<void(uint16_t)> & task)
+	{
+		if (workers.empty() || numTasks < 2)
+		{
+			for (uint16_t i=0; i<numTasks; i++)
+				task(i);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &task;
+			total = numTasks;
+			next.store(0);
+			busy = workers.size();
+			generation++;
+		}
+		wake.notify_all();
+
+		drain(task, numTasks);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this] { return busy == 0; });
+		job = NULL;
+	}
+
+private:
+	ForkJoin(const ForkJoin &) = delete;
+	ForkJoin & operator=(const ForkJoin &) = delete;
+
+	void drain(const std::function<void(uint16_t)> & task, uint16_t numTasks)
+	{
+		uint16_t i;
+		while ((i = next.fetch_add(1)) < numTasks)
+			task(i);
+	}
+
+	void work()
+	{
+		uint64_t seen = 0;
+		for (;;)
+		{
+			const std::function<void(uint16_t)> * task;
+			uint16_t numTasks;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stopping || generation != seen; });
+				if (stopping)
+					return;
+
+				seen = generation;
+				task = job;
+				numTasks = total;
+			}
+
+			drain(*task, numTasks);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--busy == 0)
+				done.notify_one();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(uint16_t)> * job;
+	uint16_t total;
+	std::atomic<uint16_t> next;
+	size_t busy;
+	uint64_t generation;
+	bool stopping;
+};
+
+/*
+ * ShardedCalendar<SHARD, NUMSHARDS>
+ *
+ * Spreads events over NUMSHARDS calendars of type SHARD, by EventID modulo
+ * NUMSHARDS (see shardFor()), so one can hold up to NUMSHARDS times what a
+ * SHARD does, e.g.
+ *
+ * 	// 32 x 60000 one-time events, 32 x 16 recurring ones
+ * 	Chronos::ShardedCalendar<Chronos::CalendarColumnar<60000, 16>, 32> bigCalendar;
+ *
+ * There's no hashing: ids a multiple of NUMSHARDS apart share a shard, so
+ * number events consecutively to spread them evenly.
+ *
+ * Queries have the same signatures as Calendar's.  They run on every shard
+ * at once, on a pool of worker threads, and the (sorted) per-shard lists are
+ * merged into the result.
+ *
+ * As with other calendars, a ShardedCalendar may only be used by one thread at
+ * a time (the parallelism is inside the queries).
+ *
+ * Needs C++11 and is only available with CHRONOS_SHARDED_CALENDAR defined (see
+ * ChronosConfig.h).
+ */
+template<class SHARD, uint8_t NUMSHARDS>
+class ShardedCalendar {
+public:
+	/*
+	 * ShardedCalendar(numWorkers)
+	 * @param numWorkers: threads to add to the calling one for queries, by default
+	 * enough to have one per core (up to one per shard).
+	 */
+	ShardedCalendar(int numWorkers=-1) :
+		shards(new SHARD[NUMSHARDS]),
+		pool(numWorkers >= 0 ? numWorkers : defaultWorkers())
+	{
+
+	}
+
+	~ShardedCalendar() { delete [] shards; }
+
+	/*
+	 * shardFor(evId)
+	 * @return: index of the shard events with this EventID are kept in,
+	 * (uint8_t)evId % NUMSHARDS.
+	 */
+	static inline uint8_t shardFor(EventID evId) { return ((uint8_t)evId) % NUMSHARDS; }
+
+	inline SHARD & shard(uint8_t i) { return shards[i]; }
+
+	uint32_t numEvents()
+	{
+		uint32_t total = 0;
+		for (uint8_t s=0; s<NUMSHARDS; s++)
+			total += shards[s].numEvents();
+		return total;
+	}
+
+	uint16_t numRecurring()
+	{
+		uint16_t total = 0;
+		for (uint8_t s=0; s<NUMSHARDS; s++)
+			total += shards[s].numRecurring();
+		return total;
+	}
+
+	bool add(const Chronos::Event & event) { return shards[shardFor(event.id())].add(event); }
+	bool add(Chronos::Event && event) { return shards[shardFor(event.id())].add(std::move(event)); }
+	bool emplace(EventID id, const DateTime & start, const DateTime & end) {
+		return shards[shardFor(id)].emplace(id, start, end);
+	}
+	template<class MarkType, class... MarkArgs>
+	bool emplace(EventID id, const Chronos::Span::Delta & duration, MarkArgs&&... markArgs) {
+		return shards[shardFor(id)].template emplace<MarkType>(id, duration, std::forward<MarkArgs>(markArgs)...);
+	}
+	bool remove(EventID evId) { return shards[shardFor(evId)].remove(evId); }
+	bool setTag(EventID evId, EventTag tag) { return shards[shardFor(evId)].setTag(evId, tag); }
+	void clear()
+	{
+		for (uint8_t s=0; s<NUMSHARDS; s++)
+			shards[s].clear();
+	}
+
+	uint8_t listNext(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
+	{
+		fanOut(maxNumber, [&](uint8_t s, Event::Occurrence * partial) {
+			return shards[s].listNext(maxNumber, partial, dt);
+		});
+		return merge(maxNumber, intoArray);
+	}
+
+	uint8_t listNext(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
+	{
+		fanOut(maxNumber, [&](uint8_t s, Event::Occurrence * partial) {
+			return shards[s].listNext(tag, maxNumber, partial, dt);
+		});
+		return merge(maxNumber, intoArray);
+	}
+
+	uint8_t listOngoing(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
+	{
+		fanOut(maxNumber, [&](uint8_t s, Event::Occurrence * partial) {
+			return shards[s].listOngoing(maxNumber, partial, dt);
+		});
+		return merge(maxNumber, intoArray);
+	}
+
+	uint8_t listOngoing(EventTag tag, uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
+	{
+		fanOut(maxNumber, [&](uint8_t s, Event::Occurrence * partial) {
+			return shards[s].listOngoing(tag, maxNumber, partial, dt);
+		});
+		return merge(maxNumber, intoArray);
+	}
+
+	uint8_t listForDay(uint8_t maxNumber, Event::Occurrence intoArray[], const DateTime & dt)
+	{
+		// as in Calendar: whatever's next from the start of the day, that starts that day
+		DateTime startOfDay = dt.startOfDay();
+		uint8_t numNext = listNext(maxNumber, intoArray, startOfDay - Chronos::Span::Seconds(1));
+		uint8_t numFound = 0;
+		while (numFound < numNext && intoArray[numFound].start.sameDateAs(startOfDay))
+			numFound++;
+
+		return numFound;
+	}
+
+	bool nextDateTimeOfInterest(const DateTime & fromDT, DateTime & returnDT)
+	{
+		Chronos::EpochTime closest[NUMSHARDS];
+		pool.run(NUMSHARDS, [&](uint16_t s) {
+			DateTime shardDT;
+			closest[s] = shards[s].nextDateTimeOfInterest(fromDT, shardDT) ?
+					shardDT.asEpoch() : DateTime::endOfTime().asEpoch();
+		});
+
+		Chronos::EpochTime best = DateTime::endOfTime().asEpoch();
+		for (uint8_t s=0; s<NUMSHARDS; s++)
+		{
+			if (closest[s] < best)
+				best = closest[s];
+		}
+
+		if (best == DateTime::endOfTime().asEpoch())
+			return false;
+
+		returnDT = DateTime(best);
+		return true;
+	}
+
+private:
+	ShardedCalendar(const ShardedCalendar &) = delete;
+	ShardedCalendar & operator=(const ShardedCalendar &) = delete;
+
+	static unsigned defaultWorkers()
+	{
+		unsigned cores = std::thread::hardware_concurrency();
+		if (cores > NUMSHARDS)
+			cores = NUMSHARDS;
+
+		return cores ? cores - 1 : 0;
+	}
+
+	// run query on all shards, each into its own partial list
+	template<class Query>
+	void fanOut(uint8_t maxNumber, Query query)
+	{
+		partials.resize((size_t)NUMSHARDS * maxNumber);
+		pool.run(NUMSHARDS, [&](uint16_t s) {
+			num_partial[s] = query(s, &(partials[(size_t)s * maxNumber]));
+		});
+		partial_stride = maxNumber;
+	}
+
+	// merge the sorted partial lists, keeping the first maxNumber occurrences
+	uint8_t merge(uint8_t maxNumber, Event::Occurrence intoArray[])
+	{
+		uint8_t pos[NUMSHARDS] = {0};
+		uint8_t numMerged = 0;
+		while (numMerged < maxNumber)
+		{
+			int best = -1;
+			for (uint8_t s=0; s<NUMSHARDS; s++)
+			{
+				if (pos[s] < num_partial[s] && (best < 0 ||
+						partials[s * partial_stride + pos[s]].start < partials[best * partial_stride + pos[best]].start))
+				{
+					best = s;
+				}
+			}
+
+			if (best < 0)
+				break;
+
+			intoArray[numMerged++] = partials[best * partial_stride + pos[best]];
+			pos[best]++;
+		}
+
+		return numMerged;
+	}
+
+	SHARD * shards;
+	ForkJoin pool;
+	std::vector<Event::Occurrence> partials;
+	uint8_t num_partial[NUMSHARDS];
+	uint8_t partial_stride;
+};
+
+} /* namespace Chronos */
+
+#endif /* CHRONOS_SHARDED_CALENDAR */
+
+#endif /* CHRONOS_INTINCLUDES_SCHEDULE_SHARDEDCALENDAR_H_ */
@@ -33,6 +33,7 @@
 #ifdef DATETIME_TEST_ENABLE
 #include "../chronosinc/timeExtInc.h"
 uint32_t runTest(uint16_t numTimes);
+bool weekdayTest();
 #endif
 
 
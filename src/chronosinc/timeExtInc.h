@@ -39,10 +39,27 @@
 #include <HardwareSerial.h>
 #endif
 
+#ifdef CHRONOS_PLATFORM_POSIX
+#include <stddef.h>
+#include <string.h>
+#include "../chronosinc/platform/printPOSIX.h"
+#endif
+
 #ifdef CHRONOS_CLOCKSOURCE_TIMELIB
 #include <Time.h>
 #endif
 
+#ifdef CHRONOS_CLOCKSOURCE_POSIX
+// what the Arduino Time library would provide
+#define SECS_PER_MIN	(60UL)
+#define SECS_PER_HOUR	(3600UL)
+#define SECS_PER_DAY	(SECS_PER_HOUR * 24UL)
+#define SECS_PER_WEEK	(SECS_PER_DAY * 7UL)
+
+#define tmYearToCalendar(Y)	((Y) + 1970)
+#define CalendarYrToTm(Y)	((Y) - 1970)
+#endif
+
 
 
 #endif /* CHRONOS_INTINCLUDES_TIMEEXTINC_H_ */
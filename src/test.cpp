@@ -25,7 +25,7 @@
 #include "chronosinc/test.h"
 
 #ifdef DATETIME_TEST_ENABLE
-#include "DateTime.h"
+#include "Chronos.h"
 
 
 #define CALENDAR_MAX_NUM_EVENTS   8
@@ -172,6 +172,34 @@ uint32_t runTest(uint16_t numTimes)
 	return numFound;
 }
 
+/*
+ * weekdayTest -- regression check: DateTimes built from elements, or modified
+ * through the setters, must know their day of the week (Weekly marks and
+ * isWeekend() depend on it).
+ */
+bool weekdayTest()
+{
+	// 1970-01-01 was a thursday, 2000-01-01 a saturday, 2015-12-21 a monday
+	if (Chronos::DateTime(1970, 1, 1, 0, 0, 0).weekday() != Chronos::Weekday::Thursday)
+		return false;
+	if (Chronos::DateTime(2000, 1, 1, 12, 0, 0).weekday() != Chronos::Weekday::Saturday)
+		return false;
+
+	Chronos::DateTime dt(2015, 12, 21, 17, 30, 0);
+	if (dt.weekday() != Chronos::Weekday::Monday || dt.isWeekend())
+		return false;
+
+	dt.setDay(26);
+	if (dt.weekday() != Chronos::Weekday::Saturday || ! dt.isWeekend())
+		return false;
+
+	// the monday class, from a tuesday: next one is on the 28th
+	Chronos::DateTime nextClass(Chronos::Mark::Weekly(Chronos::Weekday::Monday, 10, 30, 0).next(
+			Chronos::DateTime(2015, 12, 22, 9, 0, 0)));
+
+	return nextClass == Chronos::DateTime(Chronos::DateTime(2015, 12, 28, 10, 30, 0).asEpoch());
+}
+
 #endif
 
 
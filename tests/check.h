@@ -0,0 +1,49 @@
+/*
+ * check.h
+ * Minimal checks for the host tests.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHRONOS_TESTS_CHECK_H_
+#define CHRONOS_TESTS_CHECK_H_
+
+#include <stdio.h>
+
+static unsigned check_failures = 0;
+
+/*
+ * CHECK(cond) -- report (but keep going) if cond is false.
+ */
+#define CHECK(cond) do { \
+		if (! (cond)) { \
+			check_failures++; \
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+		} \
+	} while (0)
+
+/*
+ * CHECK_RESULT() -- main()'s return value.
+ */
+#define CHECK_RESULT() (check_failures ? 1 : 0)
+
+#endif /* CHRONOS_TESTS_CHECK_H_ */
@@ -0,0 +1,97 @@
+/*
+ * test_allocations.cpp
+ * Adding events to calendars: emplace() and add(Event&&) must not allocate.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <utility>
+#include "check.h"
+
+using namespace Chronos;
+
+// every heap allocation in the process is counted here
+static unsigned long num_allocations = 0;
+void * operator new(size_t size) { num_allocations++; return malloc(size); }
+void operator delete(void * ptr) noexcept { free(ptr); }
+void operator delete(void * ptr, size_t) noexcept { free(ptr); }
+
+// a user-defined mark, which events keep on the heap
+class EveryOtherDay : public Mark::Event {
+public:
+	virtual DateTime next(const DateTime & dt) const {
+		return DateTime(((dt.asEpoch() / (2 * SECS_PER_DAY)) + 1) * 2 * SECS_PER_DAY);
+	}
+	virtual DateTime previous(const DateTime & dt) const {
+		return DateTime(((dt.asEpoch() - 1) / (2 * SECS_PER_DAY)) * 2 * SECS_PER_DAY);
+	}
+	virtual Mark::Event * clone() const { return new EveryOtherDay(); }
+};
+
+static void checkAdds(Calendar & cal)
+{
+	DateTime start(2026, 3, 1, 9, 0, 0);
+	unsigned long before;
+
+	before = num_allocations;
+	CHECK(cal.emplace<Mark::Daily>(1, Span::Minutes(45), 9, 0, 0));
+	CHECK(cal.emplace<Mark::Weekly>(2, Span::Hours(1), Weekday::Monday, 10, 30, 0));
+	CHECK(num_allocations == before);
+
+	before = num_allocations;
+	CHECK(cal.emplace(3, start, start + Span::Hours(2)));
+	CHECK(num_allocations == before);
+
+	// built-in marks live in the event, user-defined ones move along with it
+	Chronos::Event builtIn(4, Mark::Monthly(2, 19, 0, 0), Span::Hours(2));
+	Chronos::Event userDefined(5, EveryOtherDay(), Span::Hours(1));
+	Chronos::Event oneTime(6, start, Span::Minutes(30));
+	before = num_allocations;
+	CHECK(cal.add(std::move(builtIn)));
+	CHECK(cal.add(std::move(userDefined)));
+	CHECK(cal.add(std::move(oneTime)));
+	CHECK(num_allocations == before);
+
+	// (through a Calendar reference, a CalendarColumnar's numEvents() only counts recurring events)
+	uint32_t numAdded = 0;
+	Chronos::Event added;
+	while (cal.eventAt(numAdded, added))
+		numAdded++;
+	CHECK(numAdded == 6);
+	Chronos::Event::Occurrence occ;
+	CHECK(cal.nextOccurrenceOf(5, start, occ) && occ.start > start);
+	CHECK(cal.nextOccurrenceOf(1, start, occ) && occ.start.hour() == 9);
+}
+
+int main()
+{
+	static CalendarStaticArray<8> staticArray;
+	static CalendarColumnar<8, 8> columnar;
+
+	checkAdds(staticArray);
+	checkAdds(columnar);
+	CHECK(staticArray.numEvents() == 6 && columnar.numEvents() == 6);
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,138 @@
+/*
+ * test_allocator.cpp
+ * Mark clones through a SlabAllocator: slots taken and given back, heap fallback when
+ * full, clones made once a reference count saturates, and all of it from several
+ * threads at once (meant to also run under ThreadSanitizer).
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <thread>
+#include <vector>
+#include "check.h"
+
+#define NUM_SLOTS	32
+
+using namespace Chronos;
+
+static Mark::SlabAllocator<sizeof(Mark::Union), NUM_SLOTS> slab;
+
+static void testSlots()
+{
+	{
+		// the union's two members are clones, and so is the event's copy of the union
+		Mark::Union both(Mark::Daily(9, 0, 0), Mark::Weekly(Weekday::Monday, 10, 0, 0));
+		CHECK(slab.used() == 2);
+		Chronos::Event evt(1, both, Span::Hours(1));
+		CHECK(slab.used() == 3);
+
+		// copies share it
+		Chronos::Event copy(evt);
+		Chronos::Event other;
+		other = copy;
+		CHECK(slab.used() == 3);
+		CHECK(other.nextOccurrence(DateTime(2016, 1, 1, 0, 0, 0)).start == DateTime(2016, 1, 1, 9, 0, 0));
+	}
+	CHECK(slab.used() == 0);
+
+	// once the slab's full, marks go on the heap
+	std::vector<Mark::Event *> marks;
+	for (int i=0; i<NUM_SLOTS + 4; i++)
+		marks.push_back(Mark::Daily(9, 0, 0).clone());
+	CHECK(slab.used() == NUM_SLOTS && slab.available() == 0);
+	CHECK(slab.owns(marks[0]) && ! slab.owns(marks.back()));
+
+	// and mixed releases put back only the slab's own
+	for (size_t i=0; i<marks.size(); i += 2)
+		marks[i]->release();
+	CHECK(slab.used() == NUM_SLOTS / 2);
+	for (size_t i=1; i<marks.size(); i += 2)
+		marks[i]->release();
+	CHECK(slab.used() == 0);
+}
+
+static void testSaturation()
+{
+	Mark::Union both(Mark::Daily(9, 0, 0), Mark::Weekly(Weekday::Monday, 10, 0, 0));
+	CHECK(slab.used() == 2);
+
+	// a reference count that's full gets a clone instead, from the slab
+	std::vector<const Mark::Event *> refs;
+	const Mark::Event * ref;
+	while ((ref = both.retain()) == &both)
+		refs.push_back(ref);
+	CHECK(both.references() == CHRONOS_MARK_MAX_REFERENCES);
+	CHECK(slab.owns(ref) && slab.used() == 3);
+	ref->release();
+	for (size_t i=0; i<refs.size(); i++)
+		refs[i]->release();
+	CHECK(both.references() == 1 && slab.used() == 2);
+}
+
+static void testThreads()
+{
+	Chronos::Event original(1, Mark::Union(Mark::Daily(9, 0, 0), Mark::Weekly(Weekday::Monday, 10, 0, 0)),
+			Span::Hours(1));
+	uint8_t usedBefore = slab.used();
+
+	std::vector<std::thread> threads;
+	for (int t=0; t<4; t++)
+	{
+		threads.push_back(std::thread([&original] {
+			for (int round=0; round<4; round++)
+			{
+				// enough copies, between the threads, to saturate the count: clones
+				// then come from the slab (or the heap) on whichever thread copies
+				std::vector<Chronos::Event> copies(20000);
+				for (size_t i=0; i<copies.size(); i++)
+					copies[i] = original;
+
+				for (int i=0; i<2000; i++)
+				{
+					Mark::Union mine(Mark::Daily(9, 0, 0), Mark::Hourly(30, 0));
+					Chronos::Event evt(2, mine, Span::Minutes(5));
+					Chronos::Event copy(evt);
+				}
+			}
+		}));
+	}
+	for (size_t t=0; t<threads.size(); t++)
+		threads[t].join();
+
+	CHECK(slab.used() == usedBefore);
+	CHECK(original.nextOccurrence(DateTime(2016, 1, 1, 0, 0, 0)).start == DateTime(2016, 1, 1, 9, 0, 0));
+}
+
+int main()
+{
+	Mark::Event::setAllocator(&slab);
+	CHECK(Mark::Event::allocator() == &slab);
+
+	testSlots();
+	testSaturation();
+	testThreads();
+	CHECK(slab.used() == 0);
+
+	Mark::Event::setAllocator(NULL);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,115 @@
+/*
+ * test_bounds.cpp
+ * Bounded series: COUNT, UNTIL and exceptions, and what hasNext() makes of them.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include "check.h"
+
+using namespace Chronos;
+
+DefineCalendarType(Agenda, 4);
+
+static DateTime at(Year y, Month mo, Day d, Hours h, Minutes mi, Seconds s)
+{
+	return DateTime(y, mo, d, h, mi, s);
+}
+
+// the occurrences left in the series, from dt on
+static int numLeft(Chronos::Event evt, const DateTime & dt)
+{
+	int num = 0;
+	DateTime from(dt);
+	while (evt.hasNext(from) && num < 100)
+	{
+		Event::Occurrence occ(evt.nextOccurrence(from));
+		if (occ.id != evt.id())
+			break;
+		from = occ.start;
+		num++;
+	}
+	return num;
+}
+
+int main()
+{
+	// standup, every day at 9, Nov 2nd through the morning of Nov 5th (2026)
+	Chronos::Event standup(1, Mark::Daily(9, 0, 0), Span::Minutes(15));
+	standup.setFrom(at(2026, 11, 2, 0, 0, 0));
+	standup.setUntil(at(2026, 11, 5, 12, 0, 0));
+
+	CHECK(numLeft(standup, at(2026, 10, 1, 0, 0, 0)) == 4);
+	CHECK(standup.hasNext(at(2026, 11, 5, 8, 59, 59)));
+	// the last one has started, even though UNTIL is a few hours off
+	CHECK(! standup.hasNext(at(2026, 11, 5, 9, 0, 0)));
+	CHECK(! standup.hasNext(at(2026, 11, 5, 10, 0, 0)));
+	CHECK(numLeft(standup, at(2026, 11, 5, 9, 0, 0)) == 0);
+
+	// same as the COUNT for it
+	Chronos::Event counted(2, Mark::Daily(9, 0, 0), Span::Minutes(15));
+	counted.setCount(4, at(2026, 11, 2, 0, 0, 0));
+	CHECK(counted.finish() == standup.finish());
+	CHECK(! counted.hasNext(at(2026, 11, 5, 9, 0, 0)));
+
+	// UNTIL right on an occurrence keeps it
+	Chronos::Event onTheDot(3, Mark::Daily(9, 0, 0), Span::Minutes(15));
+	onTheDot.setUntil(at(2026, 11, 5, 9, 0, 0));
+	CHECK(onTheDot.hasNext(at(2026, 11, 5, 8, 59, 59)));
+	CHECK(! onTheDot.hasNext(at(2026, 11, 5, 9, 0, 0)));
+
+	// UNTIL before the first occurrence: nothing, ever
+	Chronos::Event never(4, Mark::Daily(9, 0, 0), Span::Minutes(15));
+	never.setFrom(at(2026, 11, 2, 10, 0, 0));
+	never.setUntil(at(2026, 11, 3, 8, 0, 0));
+	CHECK(! never.hasNext(at(2026, 10, 1, 0, 0, 0)));
+	CHECK(numLeft(never, at(2026, 10, 1, 0, 0, 0)) == 0);
+
+	// exceptions skip occurrences, but don't move the end
+	static const DateTime holidays[] = { at(2026, 11, 3, 9, 0, 0), at(2026, 11, 5, 9, 0, 0) };
+	Chronos::Event withHolidays(standup);
+	withHolidays.setExceptions(holidays, 2);
+	CHECK(numLeft(withHolidays, at(2026, 10, 1, 0, 0, 0)) == 2);
+
+	// and clearBounds() lets it go on forever
+	withHolidays.clearBounds();
+	CHECK(withHolidays.hasNext(at(2040, 1, 1, 0, 0, 0)));
+
+	// calendars skip the series once it's over
+	Agenda agenda;
+	CHECK(agenda.add(standup));
+	Event::Occurrence occs[4];
+	CHECK(agenda.listNext(4, occs, at(2026, 11, 4, 12, 0, 0)) == 1);
+	CHECK(occs[0].start == at(2026, 11, 5, 9, 0, 0));
+	CHECK(agenda.listNext(4, occs, at(2026, 11, 5, 9, 0, 0)) == 0);
+
+	// one-time events have no series: their start and end stay put
+	Chronos::Event meeting(5, at(2026, 11, 4, 14, 0, 0), Span::Hours(1));
+	meeting.setFrom(at(2026, 11, 5, 0, 0, 0));
+	meeting.setUntil(at(2026, 11, 3, 0, 0, 0));
+	CHECK(meeting.start() == at(2026, 11, 4, 14, 0, 0));
+	CHECK(meeting.finish() == at(2026, 11, 4, 15, 0, 0));
+	CHECK(meeting.hasNext(at(2026, 11, 4, 13, 0, 0)));
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,154 @@
+/*
+ * test_columnar.cpp
+ * CalendarColumnar must answer every query just like a plain Calendar holding the same events.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include "check.h"
+
+// more than a few ColumnScan blocks' worth
+#define NUM_ONETIME		190
+#define LIST_SIZE		30
+
+using namespace Chronos;
+
+DefineCalendarType(Reference, NUM_ONETIME + 8);
+DefineColumnarCalendarType(Columnar, NUM_ONETIME + 10, 8);
+
+static Reference reference;
+static Columnar columnar;
+
+static bool sameLists(const char * what, const DateTime & dt,
+		uint8_t numRef, const Event::Occurrence ref[], uint8_t numCol, const Event::Occurrence col[])
+{
+	bool same = (numRef == numCol);
+	for (uint8_t i=0; same && i<numRef; i++)
+	{
+		same = (ref[i].id == col[i].id && ref[i].start == col[i].start
+				&& ref[i].finish == col[i].finish && ref[i].isOngoing == col[i].isOngoing);
+	}
+
+	if (! same)
+		fprintf(stderr, "%s at %u: %u vs %u occurrences\n", what, (unsigned)dt.asEpoch(), numRef, numCol);
+
+	return same;
+}
+
+static void addBoth(const Chronos::Event & evt)
+{
+	CHECK(reference.add(evt));
+	CHECK(columnar.add(evt));
+}
+
+int main()
+{
+	DateTime base(2016, 3, 1, 0, 0, 1);
+
+	// recurring events: whole minutes, so they never share a start with the one-time ones
+	addBoth(Chronos::Event(1, Mark::Daily(9, 0, 0), Span::Minutes(45)));
+	addBoth(Chronos::Event(2, Mark::Weekly(Weekday::Monday, 10, 30, 0), Span::Hours(1)));
+	addBoth(Chronos::Event(3, Mark::Monthly(2, 19, 0, 0), Span::Hours(2)));
+	addBoth(Chronos::Event(4, Mark::Hourly(20), Span::Minutes(5)));
+
+	// one-time events at distinct (odd) seconds over a week, lasting up to 6 hours, some
+	// of them overlapping, a few zero-length, and a few sharing ids
+	srand(35);
+	for (int i=0; i<NUM_ONETIME; i++)
+	{
+		DateTime start(base + (Chronos::EpochTime)(((i * 7919) % NUM_ONETIME) * 3572));
+		Span::Seconds length((i % 17) ? (rand() % (6 * 3600)) : 0);
+		addBoth(Chronos::Event(10 + (i % 110), start, start + length));
+	}
+
+	for (EventID id=10; id<40; id += 3)
+	{
+		CHECK(reference.setTag(id, 7) == columnar.setTag(id, 7));
+	}
+
+	CHECK(reference.numEvents() == columnar.numEvents());
+	CHECK(columnar.numOneTime() == NUM_ONETIME);
+
+	Event::Occurrence ref[LIST_SIZE];
+	Event::Occurrence col[LIST_SIZE];
+	for (int q=0; q<400; q++)
+	{
+		// from before the first to after the last
+		DateTime dt(base - (Chronos::EpochTime)86400 + (Chronos::EpochTime)(rand() % (9 * 86400)));
+
+		CHECK(sameLists("listNext", dt, reference.listNext(LIST_SIZE, ref, dt), ref,
+				columnar.listNext(LIST_SIZE, col, dt), col));
+		CHECK(sameLists("listNext(tag)", dt, reference.listNext(7, LIST_SIZE, ref, dt), ref,
+				columnar.listNext(7, LIST_SIZE, col, dt), col));
+		CHECK(sameLists("listOngoing", dt, reference.listOngoing(LIST_SIZE, ref, dt), ref,
+				columnar.listOngoing(LIST_SIZE, col, dt), col));
+		CHECK(sameLists("listOngoing(tag)", dt, reference.listOngoing(7, LIST_SIZE, ref, dt), ref,
+				columnar.listOngoing(7, LIST_SIZE, col, dt), col));
+		CHECK(sameLists("listForDay", dt, reference.listForDay(LIST_SIZE, ref, dt), ref,
+				columnar.listForDay(LIST_SIZE, col, dt), col));
+
+		DateTime refNext, colNext;
+		bool refFound = reference.nextDateTimeOfInterest(dt, refNext);
+		CHECK(refFound == columnar.nextDateTimeOfInterest(dt, colNext));
+		CHECK(! refFound || refNext == colNext);
+
+		EventID id = 1 + (rand() % 120);
+		Event::Occurrence refOcc, colOcc;
+		refFound = reference.nextOccurrenceOf(id, dt, refOcc);
+		CHECK(refFound == columnar.nextOccurrenceOf(id, dt, colOcc));
+		CHECK(! refFound || (refOcc.start == colOcc.start && refOcc.finish == colOcc.finish));
+
+		refFound = reference.currentOccurrenceOf(id, dt, refOcc);
+		CHECK(refFound == columnar.currentOccurrenceOf(id, dt, colOcc));
+		CHECK(! refFound || (refOcc.start == colOcc.start && refOcc.finish == colOcc.finish));
+	}
+
+	// and still, once some are gone (all events with each id, as which one
+	// remove() picks out of those depends on how the calendar keeps them)
+	for (EventID id=10; id<120; id += 4)
+	{
+		while (reference.remove(id))
+		{
+			CHECK(columnar.remove(id));
+		}
+		CHECK(! columnar.remove(id));
+	}
+
+	CHECK(reference.numEvents() == columnar.numEvents());
+	for (int q=0; q<100; q++)
+	{
+		DateTime dt(base + (Chronos::EpochTime)(rand() % (7 * 86400)));
+		CHECK(sameLists("listNext", dt, reference.listNext(LIST_SIZE, ref, dt), ref,
+				columnar.listNext(LIST_SIZE, col, dt), col));
+		CHECK(sameLists("listOngoing", dt, reference.listOngoing(LIST_SIZE, ref, dt), ref,
+				columnar.listOngoing(LIST_SIZE, col, dt), col));
+
+		DateTime refNext, colNext;
+		bool refFound = reference.nextDateTimeOfInterest(dt, refNext);
+		CHECK(refFound == columnar.nextDateTimeOfInterest(dt, colNext));
+		CHECK(! refFound || refNext == colNext);
+	}
+
+	return CHECK_RESULT();
+}
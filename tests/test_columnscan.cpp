@@ -0,0 +1,107 @@
+/*
+ * test_columnscan.cpp
+ * ColumnScan kernels against plain loops, on epochs either side of 0x80000000.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+using namespace Chronos;
+
+// values clustered where a signed compare would go wrong, plus the extremes
+static const Chronos::EpochTime edges[] = { 0, 1, 0x7ffffffeUL, 0x7fffffffUL,
+		0x80000000UL, 0x80000001UL, 0xfffffffeUL, 0xffffffffUL };
+#define NUM_EDGES	(sizeof(edges)/sizeof(edges[0]))
+
+static Chronos::EpochTime someEpoch()
+{
+	Chronos::EpochTime e = edges[rand() % NUM_EDGES];
+	// ... or a little bit off
+	if (rand() % 2)
+		e += (rand() % 9) - 4;
+	return e;
+}
+
+static bool sameMatches(const char * what, uint16_t num, uint16_t numExpected, const uint16_t expected[],
+		uint16_t numFound, const uint16_t found[])
+{
+	bool same = (numExpected == numFound)
+			&& ! memcmp(expected, found, numFound * sizeof(found[0]));
+	if (! same)
+		fprintf(stderr, "%s (%s) over %u entries: %u expected, %u found\n", what,
+				ColumnScan::implementation(), num, numExpected, numFound);
+	return same;
+}
+
+int main()
+{
+#ifdef CHRONOS_COLUMN_SCAN_KERNELS
+	const char * pinned[] = { "", "scalar", "sse2", "avx2" };
+	CHECK(! strcmp(ColumnScan::implementation(), pinned[CHRONOS_COLUMN_SCAN_KERNELS]));
+#endif
+
+	Chronos::EpochTime starts[CHRONOS_COLUMN_SCAN_BLOCK];
+	Chronos::EpochTime ends[CHRONOS_COLUMN_SCAN_BLOCK];
+	uint16_t expected[CHRONOS_COLUMN_SCAN_BLOCK];
+	uint16_t found[CHRONOS_COLUMN_SCAN_BLOCK];
+
+	srand(36);
+	for (int run=0; run<20000; run++)
+	{
+		// every length, to go through the SIMD loops' tails
+		uint16_t num = run % (CHRONOS_COLUMN_SCAN_BLOCK + 1);
+		for (uint16_t i=0; i<num; i++)
+		{
+			starts[i] = someEpoch();
+			ends[i] = (rand() % 4) ? someEpoch() : starts[i];
+		}
+
+		Chronos::EpochTime low = someEpoch();
+		Chronos::EpochTime high = someEpoch();
+		uint16_t numExpected = 0;
+		for (uint16_t i=0; i<num; i++)
+		{
+			if (starts[i] > low && starts[i] < high)
+				expected[numExpected++] = i;
+		}
+
+		CHECK(sameMatches("between", num, numExpected, expected,
+				ColumnScan::between(starts, num, low, high, found), found));
+
+		Chronos::EpochTime at = someEpoch();
+		numExpected = 0;
+		for (uint16_t i=0; i<num; i++)
+		{
+			if (starts[i] <= at && at < ends[i])
+				expected[numExpected++] = i;
+		}
+
+		CHECK(sameMatches("spanning", num, numExpected, expected,
+				ColumnScan::spanning(starts, ends, num, at, found), found));
+	}
+
+	return CHECK_RESULT();
+}
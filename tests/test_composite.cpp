@@ -0,0 +1,172 @@
+/*
+ * test_composite.cpp
+ * Union, Intersect and Except occurrences (friday the 13th, weekdays except holidays),
+ * and composites that couldn't keep every mark being refused by calendars.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include "check.h"
+
+using namespace Chronos;
+
+DefineCalendarType(TestCalendar, 4);
+
+static DateTime at(Year y, Month mo, Day d, Hours h, Minutes mi, Seconds s)
+{
+	return DateTime(y, mo, d, h, mi, s);
+}
+
+static void testFridayThe13th()
+{
+	Mark::Intersect friday13(Mark::Monthly(13, 12, 0, 0), Mark::Weekly(Weekday::Friday, 12, 0, 0));
+	DateTime expected[] = { at(2015, 2, 13, 12, 0, 0), at(2015, 3, 13, 12, 0, 0),
+			at(2015, 11, 13, 12, 0, 0), at(2016, 5, 13, 12, 0, 0), at(2017, 1, 13, 12, 0, 0),
+			at(2017, 10, 13, 12, 0, 0), at(2018, 4, 13, 12, 0, 0), at(2018, 7, 13, 12, 0, 0),
+			at(2019, 9, 13, 12, 0, 0), at(2019, 12, 13, 12, 0, 0), at(2020, 3, 13, 12, 0, 0),
+			at(2020, 11, 13, 12, 0, 0) };
+	const int num = sizeof(expected) / sizeof(expected[0]);
+
+	DateTime dt(at(2015, 1, 1, 0, 0, 0));
+	for (int i=0; i<num; i++)
+	{
+		dt = friday13.next(dt);
+		CHECK(dt == expected[i]);
+		dt += 1;
+	}
+
+	dt = at(2021, 1, 1, 0, 0, 0);
+	for (int i=num-1; i>=0; i--)
+	{
+		dt = friday13.previous(dt);
+		CHECK(dt == expected[i]);
+		dt -= 1;
+	}
+
+	// from exactly an occurrence, it's the next/previous one
+	CHECK(friday13.next(expected[3]) == expected[4]);
+	CHECK(friday13.previous(expected[3]) == expected[2]);
+
+	// and one that can never happen runs out, at either end of time
+	Mark::Intersect never(Mark::Monthly(31, 12, 0, 0), Mark::Yearly(2, 1, 12, 0, 0));
+	CHECK(never.next(at(2015, 1, 1, 0, 0, 0)) == DateTime::endOfTime());
+	CHECK(never.previous(at(2015, 1, 1, 0, 0, 0)) == DateTime((Chronos::EpochTime)0));
+}
+
+static void testWeekdaysExceptHolidays()
+{
+	Mark::Weekly mon(Weekday::Monday, 9, 0, 0), tue(Weekday::Tuesday, 9, 0, 0),
+			wed(Weekday::Wednesday, 9, 0, 0), thu(Weekday::Thursday, 9, 0, 0),
+			fri(Weekday::Friday, 9, 0, 0);
+	const Mark::Event * weekdayList[] = { &mon, &tue, &wed, &thu, &fri };
+	Mark::Union weekdays(weekdayList, 5);
+	Mark::Except workdays(weekdays, Mark::Union(Mark::Yearly(12, 25, 9, 0, 0), Mark::Yearly(1, 1, 9, 0, 0)));
+	CHECK(weekdays.isValid() && workdays.isValid());
+
+	// christmas and new year's day 2015 are both fridays
+	DateTime expected[] = { at(2015, 12, 21, 9, 0, 0), at(2015, 12, 22, 9, 0, 0),
+			at(2015, 12, 23, 9, 0, 0), at(2015, 12, 24, 9, 0, 0), at(2015, 12, 28, 9, 0, 0),
+			at(2015, 12, 29, 9, 0, 0), at(2015, 12, 30, 9, 0, 0), at(2015, 12, 31, 9, 0, 0),
+			at(2016, 1, 4, 9, 0, 0), at(2016, 1, 5, 9, 0, 0) };
+	const int num = sizeof(expected) / sizeof(expected[0]);
+
+	DateTime dt(at(2015, 12, 20, 12, 0, 0));
+	for (int i=0; i<num; i++)
+	{
+		dt = workdays.next(dt);
+		CHECK(dt == expected[i]);
+		dt += 1;
+	}
+
+	dt = at(2016, 1, 5, 12, 0, 0);
+	for (int i=num-1; i>=0; i--)
+	{
+		dt = workdays.previous(dt);
+		CHECK(dt == expected[i]);
+		dt -= 1;
+	}
+
+	// the union alone does have those days
+	CHECK(weekdays.next(at(2015, 12, 24, 12, 0, 0)) == at(2015, 12, 25, 9, 0, 0));
+
+	// and a calendar uses it like any other mark
+	TestCalendar calendar;
+	CHECK(calendar.add(Chronos::Event(1, workdays, Span::Hours(8))));
+	Chronos::Event::Occurrence occ[3];
+	CHECK(calendar.listNext(3, occ, at(2015, 12, 24, 12, 0, 0)) == 3);
+	CHECK(occ[0].start == at(2015, 12, 28, 9, 0, 0));
+	CHECK(occ[1].start == at(2015, 12, 29, 9, 0, 0));
+	CHECK(occ[2].start == at(2015, 12, 30, 9, 0, 0));
+}
+
+static void testInvalid()
+{
+	Mark::Yearly holidays[CHRONOS_MARK_COMPOSITE_MAX + 3] = {
+			Mark::Yearly(1, 1, 0, 0, 0), Mark::Yearly(2, 1, 0, 0, 0), Mark::Yearly(3, 1, 0, 0, 0),
+			Mark::Yearly(4, 1, 0, 0, 0), Mark::Yearly(5, 1, 0, 0, 0), Mark::Yearly(6, 1, 0, 0, 0),
+			Mark::Yearly(7, 1, 0, 0, 0), Mark::Yearly(8, 1, 0, 0, 0), Mark::Yearly(9, 1, 0, 0, 0),
+			Mark::Yearly(10, 1, 0, 0, 0) };
+	const Mark::Event * list[CHRONOS_MARK_COMPOSITE_MAX + 3];
+	for (int i=0; i<CHRONOS_MARK_COMPOSITE_MAX + 3; i++)
+		list[i] = &(holidays[i]);
+
+	TestCalendar calendar;
+
+	// as many as fit is fine
+	Mark::Union most(list, CHRONOS_MARK_COMPOSITE_MAX);
+	CHECK(most.isValid() && most.numMarks() == CHRONOS_MARK_COMPOSITE_MAX);
+	CHECK(calendar.add(Chronos::Event(1, most, Span::Hours(1))));
+
+	// more isn't cut down to some other rule, it's refused
+	Mark::Union tooMany(list, CHRONOS_MARK_COMPOSITE_MAX + 3);
+	CHECK(! tooMany.isValid());
+	CHECK(! calendar.add(Chronos::Event(2, tooMany, Span::Hours(1))));
+	CHECK(! calendar.emplace<Mark::Union>(3, Span::Hours(1), list, CHRONOS_MARK_COMPOSITE_MAX + 3));
+	CHECK(calendar.numEvents() == 1 && calendar.numRecurring() == 1);
+
+	// as are NULL entries, and composites of invalid ones (or copies of them)
+	list[2] = NULL;
+	Mark::Intersect withNull(list, 3);
+	CHECK(! withNull.isValid());
+	CHECK(! Mark::Except(Mark::Daily(9, 0, 0), tooMany).isValid());
+	CHECK(! Mark::Union(most, tooMany).isValid());
+	Mark::Event * copy = tooMany.clone();
+	CHECK(copy && ! copy->isValid());
+	copy->release();
+
+	// an invalid Except doesn't occur at all
+	Mark::Except noRule(tooMany, Mark::Daily(9, 0, 0));
+	CHECK(noRule.next(at(2015, 1, 1, 0, 0, 0)) == DateTime::endOfTime());
+
+	CHECK(calendar.add(Chronos::Event(4, Mark::Union(most, Mark::Daily(9, 0, 0)), Span::Hours(1))));
+	CHECK(calendar.numEvents() == 2);
+}
+
+int main()
+{
+	testFridayThe13th();
+	testWeekdaysExceptHolidays();
+	testInvalid();
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,207 @@
+/*
+ * test_concurrent.cpp
+ * ConcurrentCalendar queries, from several threads, while another adds and removes events.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "check.h"
+
+#define NUM_READERS		4
+#define NUM_PAIRS		16
+#define PAIR_OFFSET		50
+#define NUM_UPDATES		3000
+#define LIST_SIZE		60
+
+using namespace Chronos;
+
+// 4 events that are always there, and up to NUM_PAIRS pairs (id, id + PAIR_OFFSET),
+// each added and removed as a single update: every version holds both or neither.
+static ConcurrentCalendar<4 + 2 * NUM_PAIRS + 1, 8> calendar;
+
+static std::atomic<bool> writing(true);
+static std::atomic<unsigned> violations(0);
+static std::atomic<unsigned long> numQueries(0);
+
+// 9:30, when all of the events are on
+static const DateTime during(2016, 3, 1, 9, 30, 0);
+static const DateTime before(2016, 3, 1, 8, 0, 0);
+
+static void violation(const char * what)
+{
+	if (violations.fetch_add(1) < 10)
+		fprintf(stderr, "reader: %s\n", what);
+}
+
+static bool isPairId(EventID id)
+{
+	return (id >= 10 && id < 10 + NUM_PAIRS) || (id >= 10 + PAIR_OFFSET && id < 10 + PAIR_OFFSET + NUM_PAIRS);
+}
+
+static bool isKnownId(EventID id)
+{
+	// 90 comes and goes on its own
+	return (id >= 1 && id <= 4) || id == 90 || isPairId(id);
+}
+
+/*
+ * checkOngoing -- the occurrences at during (all from one version): the fixed four, and
+ * whole pairs.  Fills present[] with the ids seen.
+ */
+static void checkOngoing(uint8_t num, const Event::Occurrence ongoing[], bool present[128])
+{
+	for (int i=0; i<128; i++)
+		present[i] = false;
+
+	for (uint8_t i=0; i<num; i++)
+	{
+		if (! isKnownId(ongoing[i].id) || ongoing[i].id == 90)
+			violation("unexpected event ongoing");
+		else if (present[ongoing[i].id])
+			violation("event ongoing twice");
+		else if (! (ongoing[i].start <= during && ongoing[i].finish > during))
+			violation("ongoing occurrence isn't");
+		else
+			present[ongoing[i].id] = true;
+	}
+
+	for (EventID id=1; id<=4; id++)
+		if (! present[id])
+			violation("fixed event missing");
+
+	for (EventID id=10; id<10 + NUM_PAIRS; id++)
+		if (present[id] != present[id + PAIR_OFFSET])
+			violation("half a pair");
+}
+
+/*
+ * checkNext -- upcoming occurrences are sorted, after before, and (with onlyIds) from
+ * events that were ongoing in the same version, or 90.
+ */
+static void checkNext(uint8_t num, const Event::Occurrence upcoming[], const bool * onlyIds)
+{
+	for (uint8_t i=0; i<num; i++)
+	{
+		if (! isKnownId(upcoming[i].id))
+			violation("unexpected event upcoming");
+		else if (onlyIds && upcoming[i].id != 90 && ! onlyIds[upcoming[i].id])
+			violation("upcoming event from another version");
+		if (upcoming[i].start <= before)
+			violation("upcoming occurrence isn't");
+		if (i && upcoming[i].start < upcoming[i - 1].start)
+			violation("upcoming occurrences out of order");
+	}
+}
+
+static void reader()
+{
+	Event::Occurrence ongoing[LIST_SIZE];
+	Event::Occurrence upcoming[LIST_SIZE];
+	bool present[128];
+	unsigned long queries = 0;
+
+	while (writing.load() || queries < 200)
+	{
+		// each query on its own...
+		checkOngoing(calendar.listOngoing(LIST_SIZE, ongoing, during), ongoing, present);
+		checkNext(calendar.listNext(LIST_SIZE, upcoming, before), upcoming, NULL);
+		DateTime nextDT;
+		if (! calendar.nextDateTimeOfInterest(before, nextDT) || nextDT != DateTime(2016, 3, 1, 8, 15, 0))
+			violation("wrong next datetime of interest");
+
+		// ...and together, against a single version
+		{
+			ConcurrentCalendar<4 + 2 * NUM_PAIRS + 1, 8>::Snapshot snap(calendar.snapshot());
+			uint8_t numOngoing = snap.listOngoing(LIST_SIZE, ongoing, during);
+			checkOngoing(numOngoing, ongoing, present);
+			checkNext(snap.listNext(LIST_SIZE, upcoming, before), upcoming, present);
+
+			uint32_t numEvents = snap.numEvents();
+			if (numEvents != numOngoing && numEvents != numOngoing + 1u)
+				violation("snapshot counts disagree");
+		}
+
+		queries += 4;
+	}
+
+	numQueries.fetch_add(queries);
+}
+
+int main()
+{
+	CHECK(calendar.add(Chronos::Event(1, Mark::Daily(9, 0, 0), Span::Hours(1))));
+	CHECK(calendar.add(Chronos::Event(2, Mark::Daily(8, 30, 0), Span::Hours(2))));
+	CHECK(calendar.add(Chronos::Event(3, Mark::Hourly(15, 0), Span::Minutes(30))));
+	CHECK(calendar.emplace(4, DateTime(2016, 3, 1, 9, 15, 0), DateTime(2016, 3, 1, 11, 0, 0)));
+
+	std::vector<std::thread> readers;
+	for (int r=0; r<NUM_READERS; r++)
+		readers.push_back(std::thread(reader));
+
+	bool present[NUM_PAIRS] = {false};
+	bool single = false;
+	unsigned failedUpdates = 0;
+	for (unsigned u=0; u<NUM_UPDATES; u++)
+	{
+		EventID k = 10 + ((u * 7) % NUM_PAIRS);
+		bool adding = ! present[k - 10];
+		bool done = calendar.update([k, adding](Calendar & cal) {
+			if (adding)
+				return cal.add(Chronos::Event(k, Mark::Daily(9, 10, 0), Span::Hours(1)))
+						&& cal.add(Chronos::Event(k + PAIR_OFFSET, Mark::Daily(9, 10, 0), Span::Hours(1)));
+			return cal.remove(k) && cal.remove(k + PAIR_OFFSET);
+		});
+		if (done)
+			present[k - 10] = adding;
+		else
+			failedUpdates++;
+
+		if (u % 5 == 0)
+		{
+			done = single ? calendar.remove(90) : calendar.add(Chronos::Event(90, Mark::Daily(12, 0, 0), Span::Minutes(5)));
+			if (done)
+				single = ! single;
+			else
+				failedUpdates++;
+		}
+	}
+	writing.store(false);
+
+	for (size_t r=0; r<readers.size(); r++)
+		readers[r].join();
+
+	CHECK(failedUpdates == 0);
+	CHECK(violations.load() == 0);
+	CHECK(numQueries.load() >= NUM_READERS * 200u);
+
+	// and what's left is what the writer thinks is there
+	uint32_t expected = 4 + (single ? 1 : 0);
+	for (int i=0; i<NUM_PAIRS; i++)
+		expected += present[i] ? 2 : 0;
+	CHECK(calendar.numEvents() == expected);
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,182 @@
+/*
+ * test_coscheduler.cpp
+ * Coroutines waiting on a CoScheduler resume in time order, in simulated time.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <vector>
+#include "check.h"
+
+using namespace Chronos;
+
+DefineCalendarType(Calendar4, 4);
+
+static Calendar4 calendar;
+
+// 2016-03-01 (a Tuesday)
+static const DateTime base(2016, 3, 1, 8, 0, 0);
+
+static DateTime at(int day, int hours, int minutes)
+{
+	return DateTime(2016, 3, 1 + day, hours, minutes, 0);
+}
+
+// who was resumed, and when
+class Resumed {
+public:
+	int who;
+	Chronos::EpochTime when;
+};
+static std::vector<Resumed> resumed;
+
+static void log(int who)
+{
+	Resumed r = { who, DateTime::now().asEpoch() };
+	resumed.push_back(r);
+}
+
+static CoScheduler::Task timer(CoScheduler & sched)
+{
+	// (awaited into a variable: GCC 12 miscompiles a co_await inside CHECK()'s do/while)
+	bool reached = co_await sched.until(at(0, 8, 10));
+	CHECK(reached);
+	log(1);
+	// already past: doesn't suspend at all
+	reached = co_await sched.until(at(0, 8, 5));
+	CHECK(reached);
+	log(2);
+	co_await sched.until(at(0, 9, 0));
+	log(3);
+}
+
+static CoScheduler::Task daily(CoScheduler & sched)
+{
+	for (int day=0; day<2; day++)
+	{
+		Event::Occurrence occ = co_await sched.untilStart(1);
+		CHECK(occ.id == 1 && occ.start == at(day, 9, 0));
+		log(4);
+		occ = co_await sched.untilEnd(1);
+		CHECK(occ.id == 1 && occ.finish == at(day, 10, 0));
+		log(5);
+	}
+}
+
+static CoScheduler::Task oneTime(CoScheduler & sched)
+{
+	// not on yet, so the end of the next one
+	Event::Occurrence occ = co_await sched.untilEnd(2);
+	CHECK(occ.id == 2 && occ.finish == at(0, 8, 45));
+	log(6);
+	// and that was the only one
+	occ = co_await sched.untilStart(2);
+	CHECK(occ.id == EVENTID_NOTSET);
+	log(7);
+}
+
+static CoScheduler::Task missing(CoScheduler & sched)
+{
+	Event::Occurrence occ = co_await sched.untilStart(99);
+	CHECK(occ.id == EVENTID_NOTSET);
+	log(8);
+}
+
+static CoScheduler::Task next(CoScheduler & sched)
+{
+	bool found = co_await sched.untilNext();
+	CHECK(found);
+	log(9);
+}
+
+static CoScheduler::Task stopper(CoScheduler & sched)
+{
+	co_await sched.until(at(2, 0, 0));
+	log(10);
+	sched.stop();
+}
+
+static CoScheduler::Task straggler(CoScheduler & sched)
+{
+	co_await sched.until(at(3, 0, 0));
+	log(11);
+}
+
+int main()
+{
+	SimulatedClock::set(base.asEpoch());
+
+	CHECK(calendar.add(Chronos::Event(1, Mark::Daily(9, 0, 0), Span::Hours(1))));
+	CHECK(calendar.add(Chronos::Event(2, at(0, 8, 30), at(0, 8, 45))));
+
+	{
+		CoScheduler sched(calendar);
+		timer(sched);
+		daily(sched);
+		oneTime(sched);
+		missing(sched);
+		next(sched);
+		stopper(sched);
+		straggler(sched);
+
+		// only missing() has nothing to wait for
+		CHECK(resumed.size() == 1);
+		CHECK(sched.numWaiting() == 6);
+
+		CHECK(sched.run());
+
+		// stopped, with straggler() still waiting (and destroyed with the scheduler)
+		CHECK(sched.numWaiting() == 1);
+		CHECK(DateTime::now() == at(2, 0, 0));
+	}
+
+	// in time order, and in the order they started waiting at the same time
+	const Resumed expected[] = {
+			{ 8, at(0, 8, 0).asEpoch() },
+			{ 1, at(0, 8, 10).asEpoch() },
+			{ 2, at(0, 8, 10).asEpoch() },
+			{ 9, at(0, 8, 30).asEpoch() },
+			{ 6, at(0, 8, 45).asEpoch() },
+			{ 7, at(0, 8, 45).asEpoch() },
+			{ 4, at(0, 9, 0).asEpoch() },
+			{ 3, at(0, 9, 0).asEpoch() },
+			{ 5, at(0, 10, 0).asEpoch() },
+			{ 4, at(1, 9, 0).asEpoch() },
+			{ 5, at(1, 10, 0).asEpoch() },
+			{ 10, at(2, 0, 0).asEpoch() },
+	};
+	const size_t numExpected = sizeof(expected) / sizeof(expected[0]);
+
+	CHECK(resumed.size() == numExpected);
+	for (size_t i=0; i<numExpected && i<resumed.size(); i++)
+	{
+		if (resumed[i].who != expected[i].who || resumed[i].when != expected[i].when)
+		{
+			fprintf(stderr, "resumed #%u: %d at %u, expected %d at %u\n", (unsigned)i,
+					resumed[i].who, (unsigned)resumed[i].when, expected[i].who, (unsigned)expected[i].when);
+			CHECK(false);
+		}
+	}
+
+	return CHECK_RESULT();
+}
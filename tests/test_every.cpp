@@ -0,0 +1,142 @@
+/*
+ * test_every.cpp
+ * Mark::Every next()/previous()/count()/nth(): around the anchor, from the start of the
+ * epoch, and near the end of time, where anchor + n * period would overflow.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include "check.h"
+
+using namespace Chronos;
+
+static DateTime at(Chronos::EpochTime epoch)
+{
+	return DateTime(epoch);
+}
+
+static void testAroundAnchor()
+{
+	DateTime anchor(2016, 1, 1, 0, 2, 0);
+	Chronos::EpochTime a = anchor.asEpoch();
+	Mark::Every every(anchor, Span::Minutes(5));
+
+	// the anchor is an occurrence, with others on both sides of it
+	CHECK(every.next(at(a - 1)) == anchor);
+	CHECK(every.next(anchor) == at(a + 300));
+	CHECK(every.previous(at(a + 1)) == anchor);
+	CHECK(every.previous(anchor) == at(a - 300));
+	CHECK(every.next(at(a - 3000)) == at(a - 2700));
+	CHECK(every.previous(at(a + 299)) == anchor);
+
+	// only the phase of the anchor matters
+	Mark::Every sameSteps(DateTime(2000, 6, 1, 12, 7, 0), Span::Minutes(5));
+	CHECK(sameSteps.next(anchor) == every.next(anchor));
+
+	// count() is after from, up to and including until
+	CHECK(every.count(anchor, anchor) == 0);
+	CHECK(every.count(at(a - 1), anchor) == 1);
+	CHECK(every.count(anchor, at(a + 299)) == 0);
+	CHECK(every.count(anchor, at(a + 300)) == 1);
+	CHECK(every.count(anchor, at(a + 3000)) == 10);
+	CHECK(every.count(at(a - 1), at(a + 3000)) == 11);
+	CHECK(every.count(at(a + 3000), anchor) == 0);
+
+	// nth(1) is next(), nth(0) where we are
+	CHECK(every.nth(0, anchor) == anchor);
+	CHECK(every.nth(1, anchor) == every.next(anchor));
+	CHECK(every.nth(12, anchor) == at(a + 3600));
+	CHECK(every.nth(12, at(a - 1)) == at(a + 3300));
+
+	// and a cursor steps by the period
+	Mark::Cursor cursor(every.cursor(at(a - 1)));
+	for (int i=0; i<10; i++)
+		CHECK(cursor.advance() == at(a + i * 300));
+	Mark::Cursor back(every.reverseCursor(at(a + 1)));
+	for (int i=0; i<10; i++)
+		CHECK(back.advance() == at(a - i * 300));
+}
+
+static void testStartOfEpoch()
+{
+	Mark::Every every(at(100), Span::Seconds(1000));
+	CHECK(every.next(at(0)) == at(100));
+	CHECK(every.previous(at(100)) == at(0));
+	CHECK(every.previous(at(50)) == at(0));
+	CHECK(every.count(at(0), at(2100)) == 3);
+	CHECK(every.count(at(0), at(99)) == 0);
+	CHECK(every.nth(3, at(0)) == at(2100));
+
+	Mark::Cursor back(every.reverseCursor(at(1500)));
+	CHECK(back.advance() == at(1100));
+	CHECK(back.advance() == at(100));
+	CHECK(back.advance() == at(0));
+}
+
+static void testEndOfTime()
+{
+	DateTime endOfTime(DateTime::endOfTime());
+	Chronos::EpochTime e = endOfTime.asEpoch();
+
+	// noon each day: the last one before the end of time is on 2106-02-06
+	Mark::Every daily(DateTime(2016, 1, 1, 12, 0, 0), Span::Days(1));
+	DateTime last(2106, 2, 6, 12, 0, 0);
+	CHECK(daily.next(last - 1) == last);
+	CHECK(daily.next(last) == endOfTime);
+	CHECK(daily.next(endOfTime) == endOfTime);
+	CHECK(daily.next(at(0xffffffffUL)) == endOfTime);
+	CHECK(daily.previous(endOfTime) == last);
+	CHECK(daily.nth(1, last - 1) == last);
+	CHECK(daily.nth(2, last - 1) == endOfTime);
+	CHECK(daily.nth(1000, DateTime(2106, 1, 1, 0, 0, 0)) == endOfTime);
+	CHECK(daily.nth(0xffffffffUL, DateTime(2016, 1, 1, 0, 0, 0)) == endOfTime);
+	CHECK(daily.count(last - 1, endOfTime) == 1);
+
+	Mark::Cursor cursor(daily.cursor(last - 1));
+	CHECK(cursor.advance() == last);
+	CHECK(cursor.advance() == endOfTime);
+	CHECK(cursor.advance() == endOfTime);
+
+	// a long period, where anchor + n * period wraps right around
+	Mark::Every rare(DateTime(2016, 1, 1, 0, 0, 0), Span::Days(20000));
+	Chronos::EpochTime r = rare.next(DateTime(2016, 1, 1, 0, 0, 0)).asEpoch();
+	CHECK(r > DateTime(2016, 1, 1, 0, 0, 0).asEpoch() && r < e);
+	CHECK(rare.next(at(r)) == endOfTime);
+	CHECK(rare.nth(3, DateTime(2016, 1, 1, 0, 0, 0)) == endOfTime);
+	CHECK(rare.previous(endOfTime) == at(r));
+
+	// one second at a time, right up to the end
+	Mark::Every seconds(Span::Seconds(1));
+	CHECK(seconds.next(at(e - 2)) == at(e - 1));
+	CHECK(seconds.next(at(e - 1)) == endOfTime);
+	CHECK(seconds.nth(5, at(e - 3)) == endOfTime);
+}
+
+int main()
+{
+	testAroundAnchor();
+	testStartOfEpoch();
+	testEndOfTime();
+
+	return CHECK_RESULT();
+}
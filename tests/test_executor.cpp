@@ -0,0 +1,122 @@
+/*
+ * test_executor.cpp
+ * CallbackExecutor runs each event's callbacks one at a time, in order, while workers steal.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "check.h"
+
+#define NUM_WORKERS		4
+#define NUM_OCCURRENCES	10000
+#define NUM_EVENTS		50
+#define BATCH_SIZE		250
+
+using namespace Chronos;
+
+static const DateTime base(2016, 3, 1, 9, 0, 0);
+
+// per event: whether a callback's running, and the last sequence number seen
+static std::atomic<bool> running[NUM_EVENTS + 1];
+static std::atomic<int32_t> lastSeen[NUM_EVENTS + 1];
+
+static std::atomic<uint32_t> numCalled(0);
+static std::atomic<uint32_t> numOverlaps(0);
+static std::atomic<uint32_t> numOutOfOrder(0);
+
+static void spin(unsigned rounds)
+{
+	volatile uint32_t x = 0;
+	for (unsigned i=0; i<rounds; i++)
+		x = x + i;
+}
+
+static void callback(const Event::Occurrence & occ)
+{
+	if (running[occ.id].exchange(true))
+		numOverlaps.fetch_add(1);
+
+	// each occurrence's sequence number is its start's offset from base
+	int32_t seq = (int32_t)(occ.start.asEpoch() - base.asEpoch());
+	if (lastSeen[occ.id].load() >= seq)
+		numOutOfOrder.fetch_add(1);
+	lastSeen[occ.id].store(seq);
+
+	// uneven work, so some workers fall behind and others steal from them
+	spin((occ.id % 5) ? 200 : 5000);
+	if (occ.id % 7 == 0)
+		std::this_thread::yield();
+
+	running[occ.id].store(false);
+	numCalled.fetch_add(1);
+}
+
+int main()
+{
+	for (int i=0; i<=NUM_EVENTS; i++)
+	{
+		running[i].store(false);
+		lastSeen[i].store(-1);
+	}
+
+	// occurrence seq belongs to event 1 + seq % NUM_EVENTS (or to a few events
+	// in turn, in the first batches, so their strands get long)
+	std::vector<Event::Occurrence> occurrences(NUM_OCCURRENCES);
+	for (uint32_t seq=0; seq<NUM_OCCURRENCES; seq++)
+	{
+		occurrences[seq].id = 1 + ((seq < 2000 ? seq % 3 : seq) % NUM_EVENTS);
+		occurrences[seq].start = base + (Chronos::EpochTime)seq;
+		occurrences[seq].finish = occurrences[seq].start + Span::Minutes(1);
+	}
+
+	{
+		CallbackExecutor executor(callback, NUM_WORKERS);
+		CHECK(executor.numWorkers() == NUM_WORKERS);
+
+		for (uint32_t i=0; i<NUM_OCCURRENCES / 2; i += BATCH_SIZE)
+			executor.submit(&(occurrences[i]), BATCH_SIZE);
+
+		// submitting while the first half is still running, too
+		std::thread submitter([&executor, &occurrences] {
+			for (uint32_t i=NUM_OCCURRENCES / 2; i<NUM_OCCURRENCES; i += BATCH_SIZE)
+				executor.submit(&(occurrences[i]), BATCH_SIZE);
+		});
+		submitter.join();
+
+		executor.waitIdle();
+		CHECK(numCalled.load() == NUM_OCCURRENCES);
+	}
+
+	CHECK(numOverlaps.load() == 0);
+	CHECK(numOutOfOrder.load() == 0);
+	for (int id=1; id<=NUM_EVENTS; id++)
+	{
+		// each event's last occurrence is amongst the last NUM_EVENTS
+		CHECK(lastSeen[id].load() >= NUM_OCCURRENCES - NUM_EVENTS);
+	}
+
+	return CHECK_RESULT();
+}
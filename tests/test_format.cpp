@@ -0,0 +1,188 @@
+/*
+ * test_format.cpp
+ * formatTo() for DateTimes and Deltas: every conversion, padding, truncation and odd patterns.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <chronosinc/Format.h>
+#include <string.h>
+#include "check.h"
+
+using namespace Chronos;
+
+// a Saturday morning
+static const DateTime morning(2016, 3, 5, 7, 4, 9);
+
+static bool formats(const DateTime & dt, const char * pattern, const char * expected)
+{
+	char buf[64];
+	size_t len = dt.formatTo(buf, sizeof(buf), pattern);
+	if (len == strlen(expected) && strcmp(buf, expected) == 0)
+		return true;
+
+	fprintf(stderr, "\"%s\": \"%s\" (%u), expected \"%s\"\n", pattern, buf, (unsigned)len, expected);
+	return false;
+}
+
+static bool formats(const Span::Delta & delta, const char * pattern, const char * expected)
+{
+	char buf[64];
+	size_t len = delta.formatTo(buf, sizeof(buf), pattern);
+	if (len == strlen(expected) && strcmp(buf, expected) == 0)
+		return true;
+
+	fprintf(stderr, "\"%s\": \"%s\" (%u), expected \"%s\"\n", pattern, buf, (unsigned)len, expected);
+	return false;
+}
+
+static void testNames()
+{
+	const char * months[] = { "Err", "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+			"Jul", "Aug", "Sep", "Oct", "Nov", "Dec", "Err" };
+	for (uint8_t m=0; m<=13; m++)
+		CHECK(strcmp(Format::monthShortName(m), months[m]) == 0);
+	CHECK(strcmp(Format::monthShortName(255), "Err") == 0);
+
+	const char * days[] = { "Err", "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Err" };
+	for (uint8_t d=0; d<=8; d++)
+		CHECK(strcmp(Format::dayShortName(d), days[d]) == 0);
+}
+
+static void testDateTimeConversions()
+{
+	CHECK(formats(morning, "%Y", "2016"));
+	CHECK(formats(morning, "%y", "16"));
+	CHECK(formats(morning, "%m", "03"));
+	CHECK(formats(morning, "%d", "05"));
+	CHECK(formats(morning, "%e", " 5"));
+	CHECK(formats(morning, "%H", "07"));
+	CHECK(formats(morning, "%I", "07"));
+	CHECK(formats(morning, "%M", "04"));
+	CHECK(formats(morning, "%S", "09"));
+	CHECK(formats(morning, "%p", "AM"));
+	CHECK(formats(morning, "%b", "Mar"));
+	CHECK(formats(morning, "%a", "Sat"));
+	CHECK(formats(morning, "%s", "1457161449"));
+	CHECK(formats(morning, "%F", "2016-03-05"));
+	CHECK(formats(morning, "%T", "07:04:09"));
+	CHECK(formats(morning, "%R", "07:04"));
+	CHECK(formats(morning, "%%", "%"));
+
+	// without padding
+	CHECK(formats(morning, "%-y %-m %-d %-e %-H %-I %-M %-S", "16 3 5 5 7 7 4 9"));
+	CHECK(formats(morning, "%-T %-R %-F", "7:04:09 7:04 2016-03-05"));
+	CHECK(formats(DateTime(16, 1, 1, 0, 0, 0), "%Y|%-Y", "0016|16"));
+
+	// the 12-hour clock
+	CHECK(formats(DateTime(2016, 3, 5, 0, 30, 0), "%I:%M %p", "12:30 AM"));
+	CHECK(formats(DateTime(2016, 3, 5, 12, 0, 0), "%I %p", "12 PM"));
+	CHECK(formats(DateTime(2016, 12, 31, 23, 59, 59), "%-I:%M:%S %p", "11:59:59 PM"));
+
+	// the default, and as much text as conversions
+	CHECK(formats(morning, "%Y-%m-%d %H:%M:%S", "2016-03-05 07:04:09"));
+	char buf[32];
+	CHECK(morning.formatTo(buf, sizeof(buf)) == 19 && strcmp(buf, "2016-03-05 07:04:09") == 0);
+	CHECK(formats(morning, "%a, %d %b %Y (day %e)", "Sat, 05 Mar 2016 (day  5)"));
+	CHECK(formats(morning, "no conversions", "no conversions"));
+	CHECK(formats(morning, "", ""));
+	CHECK(formats(DateTime::endOfTime(), "%s", "4294967280"));
+}
+
+static void testDateTimeOddities()
+{
+	// unknown conversions are copied, flag and all
+	CHECK(formats(morning, "%Q %-Q %j", "%Q %-Q %j"));
+
+	// a trailing '%' (with or without the flag) stays a '%'
+	CHECK(formats(morning, "at %H%", "at 07%"));
+	CHECK(formats(morning, "%", "%"));
+	CHECK(formats(morning, "%H%-", "07%"));
+}
+
+static void testDateTimeTruncation()
+{
+	char buf[16];
+
+	// cut off in the middle of a number...
+	memset(buf, 'x', sizeof(buf));
+	CHECK(morning.formatTo(buf, 8, "%Y-%m-%d") == 7 && strcmp(buf, "2016-03") == 0);
+	CHECK(buf[8] == 'x');
+	CHECK(morning.formatTo(buf, 3, "%Y") == 2 && strcmp(buf, "20") == 0);
+
+	// ... a name, or text
+	CHECK(morning.formatTo(buf, 3, "%b") == 2 && strcmp(buf, "Ma") == 0);
+	CHECK(morning.formatTo(buf, 4, "abcdef") == 3 && strcmp(buf, "abc") == 0);
+
+	// exactly enough room
+	CHECK(morning.formatTo(buf, 5, "%Y") == 4 && strcmp(buf, "2016") == 0);
+
+	// room for the NUL only
+	memset(buf, 'x', sizeof(buf));
+	CHECK(morning.formatTo(buf, 1, "%Y") == 0 && buf[0] == '\0' && buf[1] == 'x');
+
+	// and no room at all: nothing's written
+	memset(buf, 'x', sizeof(buf));
+	CHECK(morning.formatTo(buf, 0, "%Y") == 0 && buf[0] == 'x');
+	CHECK(morning.formatTo(NULL, 0, "%Y") == 0);
+}
+
+static void testDelta()
+{
+	// 3 days, 4:05:06
+	Span::Seconds delta(3 * 86400 + 4 * 3600 + 5 * 60 + 6);
+
+	CHECK(formats(delta, "%d", "3"));
+	CHECK(formats(delta, "%H", "04"));
+	CHECK(formats(delta, "%M", "05"));
+	CHECK(formats(delta, "%S", "06"));
+	CHECK(formats(delta, "%s", "273906"));
+	CHECK(formats(delta, "%T", "04:05:06"));
+	CHECK(formats(delta, "%%", "%"));
+	CHECK(formats(delta, "%-d %-H %-M %-S %-T", "3 4 5 6 4:05:06"));
+
+	char buf[32];
+	CHECK(delta.formatTo(buf, sizeof(buf)) == 11 && strcmp(buf, "3d 04:05:06") == 0);
+	CHECK(formats(Span::Seconds(0), "%dd %T", "0d 00:00:00"));
+
+	// the DateTime-only conversions aren't Delta ones
+	CHECK(formats(delta, "%Y %-b", "%Y %-b"));
+	CHECK(formats(delta, "%T%", "04:05:06%"));
+	CHECK(formats(delta, "%", "%"));
+
+	memset(buf, 'x', sizeof(buf));
+	CHECK(delta.formatTo(buf, 6, "%T") == 5 && strcmp(buf, "04:05") == 0 && buf[6] == 'x');
+	CHECK(delta.formatTo(buf, 1, "%T") == 0 && buf[0] == '\0');
+	memset(buf, 'x', sizeof(buf));
+	CHECK(delta.formatTo(buf, 0, "%T") == 0 && buf[0] == 'x');
+}
+
+int main()
+{
+	testNames();
+	testDateTimeConversions();
+	testDateTimeOddities();
+	testDateTimeTruncation();
+	testDelta();
+	return CHECK_RESULT();
+}
@@ -0,0 +1,236 @@
+/*
+ * test_ics.cpp
+ * IcsImporter: the same events however the input is chunked or folded, and the events
+ * it can't import faithfully (EXDATEs, TZIDs...) skipped.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "check.h"
+
+using namespace Chronos;
+
+DefineCalendarType(Agenda, 16);
+
+static const char * const lines[] = {
+	"BEGIN:VCALENDAR",
+	"VERSION:2.0",
+	"PRODID:-//Chronos//test_ics//EN",
+	"BEGIN:VEVENT",
+	"UID:dentist@test",
+	"SUMMARY:Dentist\\, again",
+	"DTSTART:20261104T140000",
+	"DTEND:20261104T150000",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:standup@test",
+	"SUMMARY:Standup",
+	"DTSTART:20261102T090000",
+	"DURATION:PT15M",
+	"RRULE:FREQ=DAILY;COUNT=10",
+	"BEGIN:VALARM",
+	"TRIGGER:-PT5M",
+	"ACTION:DISPLAY",
+	"END:VALARM",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:class@test",
+	"SUMMARY:Class",
+	"DTSTART:20261102T103000",
+	"DTEND:20261102T113000",
+	"RRULE:FREQ=WEEKLY;BYDAY=MO,WE;UNTIL=20261231T235959",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:council@test",
+	"SUMMARY:Council",
+	"DTSTART:20261105T190000",
+	"DURATION:PT2H",
+	"RRULE:FREQ=MONTHLY;BYDAY=1TH",
+	"DESCRIPTION:", // (made longer than CHRONOS_ICS_LINE_MAX, below)
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:holiday@test",
+	"SUMMARY:Holiday",
+	"DTSTART;VALUE=DATE:20261225",
+	"END:VEVENT",
+	// the rest are skipped...
+	"BEGIN:VEVENT",
+	"UID:cancelled@test",
+	"STATUS:CANCELLED",
+	"DTSTART:20261106T100000",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:exdate@test",
+	"DTSTART:20261102T080000",
+	"RRULE:FREQ=DAILY",
+	"EXDATE:20261103T080000",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:rdate@test",
+	"DTSTART:20261102T070000",
+	"RRULE:FREQ=WEEKLY",
+	"RDATE:20261104T070000",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:standup@test",
+	"RECURRENCE-ID:20261104T090000",
+	"DTSTART:20261104T093000",
+	"DURATION:PT15M",
+	"END:VEVENT",
+	"BEGIN:VEVENT",
+	"UID:tz@test",
+	"DTSTART;TZID=\"America/New_York\":20261110T090000",
+	"DTEND;TZID=\"America/New_York\":20261110T100000",
+	"END:VEVENT",
+	// ... and this one too, unless there's a UTC offset
+	"BEGIN:VEVENT",
+	"UID:utc@test",
+	"SUMMARY:Call",
+	"DTSTART:20261111T170000Z",
+	"DTEND:20261111T180000Z",
+	"END:VEVENT",
+	"END:VCALENDAR"
+};
+#define NUM_LINES	(sizeof(lines)/sizeof(lines[0]))
+
+// what each imported event amounts to, as text
+class Recorder : public IcsImporter::Listener {
+public:
+	virtual bool imported(Chronos::Event & event, const char * uid, const char * summary)
+	{
+		char desc[160];
+		int len = snprintf(desc, sizeof(desc), "%s|%s|", uid, summary);
+		DateTime from(2026, 11, 1, 0, 0, 0);
+		for (int i=0; i<3 && event.hasNext(from); i++)
+		{
+			Event::Occurrence occ(event.nextOccurrence(from));
+			len += snprintf(&(desc[len]), sizeof(desc) - len, "%u-%u,",
+					(unsigned)occ.start.asEpoch(), (unsigned)occ.finish.asEpoch());
+			from = occ.start;
+		}
+		events.push_back(desc);
+		return true;
+	}
+
+	std::vector<std::string> events;
+};
+
+class Result {
+public:
+	std::vector<std::string> events;
+	uint32_t numAdded;
+	uint32_t numSkipped;
+	uint16_t numInCalendar;
+
+	bool operator==(const Result & other) const {
+		return events == other.events && numAdded == other.numAdded
+				&& numSkipped == other.numSkipped && numInCalendar == other.numInCalendar;
+	}
+};
+
+static Result import(const std::string & ics, uint32_t chunkSize, int32_t utcOffset=0, bool withOffset=false)
+{
+	Agenda agenda;
+	Recorder recorder;
+	IcsImporter importer(agenda, 1, &recorder);
+	if (withOffset)
+		importer.setUtcOffset(utcOffset);
+
+	for (uint32_t pos=0; pos<ics.size(); pos += chunkSize)
+	{
+		uint32_t len = (ics.size() - pos) < chunkSize ? (ics.size() - pos) : chunkSize;
+		importer.feed(ics.data() + pos, len);
+	}
+	importer.finish();
+
+	Result result;
+	result.events = recorder.events;
+	result.numAdded = importer.numAdded();
+	result.numSkipped = importer.numSkipped();
+	result.numInCalendar = agenda.numEvents();
+	return result;
+}
+
+// the lines, each folded every foldAt chars (0: not at all)
+static std::string ics(uint16_t foldAt, const char * eol)
+{
+	std::string all;
+	for (size_t l=0; l<NUM_LINES; l++)
+	{
+		std::string line(lines[l]);
+		if (line == "DESCRIPTION:")
+			line += std::string(CHRONOS_ICS_LINE_MAX + 10, 'x');
+
+		for (size_t pos=0; foldAt && pos + foldAt < line.size(); pos += foldAt + 1)
+		{
+			// CRLF, then a space or a tab, which don't count
+			line.insert(pos + foldAt, std::string(eol) + ((pos / foldAt) % 2 ? "\t" : " "));
+			pos += strlen(eol);
+		}
+		all += line + eol;
+	}
+	return all;
+}
+
+int main()
+{
+	Result whole(import(ics(0, "\r\n"), 0xffff));
+
+	// dentist, standup, class (Mondays and Wednesdays), council and the holiday
+	CHECK(whole.numAdded == 6);
+	CHECK(whole.numInCalendar == 6);
+	// cancelled, EXDATE, RDATE, RECURRENCE-ID, TZID and UTC
+	CHECK(whole.numSkipped == 6);
+	CHECK(whole.events.size() == 6);
+	CHECK(whole.events.size() && whole.events[0].find("dentist@test|Dentist, again|") == 0);
+
+	// however the input comes in
+	for (uint32_t chunk=1; chunk<=64; chunk++)
+	{
+		CHECK(import(ics(0, "\r\n"), chunk) == whole);
+	}
+
+	// and however it's folded, with either line ending
+	const uint16_t folds[] = { 1, 2, 3, 5, 8, 13, 75 };
+	for (size_t f=0; f<sizeof(folds)/sizeof(folds[0]); f++)
+	{
+		CHECK(import(ics(folds[f], "\r\n"), 0xffff) == whole);
+		CHECK(import(ics(folds[f], "\n"), 0xffff) == whole);
+		CHECK(import(ics(folds[f], "\r\n"), 1 + f) == whole);
+	}
+
+	// UTC times, given where Chronos' time is
+	Result withOffset(import(ics(0, "\r\n"), 0xffff, -5 * 3600, true));
+	CHECK(withOffset.numAdded == 7);
+	CHECK(withOffset.numSkipped == 5);
+	char expected[64];
+	snprintf(expected, sizeof(expected), "utc@test|Call|%u-%u,",
+			(unsigned)DateTime(2026, 11, 11, 12, 0, 0).asEpoch(), (unsigned)DateTime(2026, 11, 11, 13, 0, 0).asEpoch());
+	CHECK(withOffset.events.size() == 7 && withOffset.events[6] == expected);
+
+	return CHECK_RESULT();
+}
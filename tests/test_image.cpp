@@ -0,0 +1,231 @@
+/*
+ * test_image.cpp
+ * CalendarImage round trips: Builder -> write() -> attach() answers like the calendar it was
+ * built from, and truncated or corrupt images are turned down.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include "check.h"
+
+#define NUM_ONETIME		100
+#define LIST_SIZE		20
+
+using namespace Chronos;
+
+DefineCalendarType(Reference, NUM_ONETIME + 4);
+
+static Reference reference;
+static CalendarImage::Builder builder;
+
+static bool sameLists(const char * what, const DateTime & dt,
+		uint8_t numRef, const Event::Occurrence ref[], uint8_t numImg, const Event::Occurrence img[])
+{
+	bool same = (numRef == numImg);
+	for (uint8_t i=0; same && i<numRef; i++)
+	{
+		same = (ref[i].id == img[i].id && ref[i].start == img[i].start
+				&& ref[i].finish == img[i].finish && ref[i].isOngoing == img[i].isOngoing);
+	}
+
+	if (! same)
+		fprintf(stderr, "%s at %u: %u vs %u occurrences\n", what, (unsigned)dt.asEpoch(), numRef, numImg);
+
+	return same;
+}
+
+static void addBoth(const Chronos::Event & evt)
+{
+	CHECK(reference.add(evt));
+	CHECK(builder.add(evt));
+}
+
+// every query, from a few hundred points, the same on both
+static void compareQueries(Calendar & image, const DateTime & base)
+{
+	Event::Occurrence ref[LIST_SIZE];
+	Event::Occurrence img[LIST_SIZE];
+	for (int q=0; q<300; q++)
+	{
+		DateTime dt(base - (Chronos::EpochTime)86400 + (Chronos::EpochTime)(rand() % (12 * 86400)));
+
+		CHECK(sameLists("listNext", dt, reference.listNext(LIST_SIZE, ref, dt), ref,
+				image.listNext(LIST_SIZE, img, dt), img));
+		CHECK(sameLists("listNext(tag)", dt, reference.listNext(5, LIST_SIZE, ref, dt), ref,
+				image.listNext(5, LIST_SIZE, img, dt), img));
+		CHECK(sameLists("listOngoing", dt, reference.listOngoing(LIST_SIZE, ref, dt), ref,
+				image.listOngoing(LIST_SIZE, img, dt), img));
+		CHECK(sameLists("listForDay", dt, reference.listForDay(LIST_SIZE, ref, dt), ref,
+				image.listForDay(LIST_SIZE, img, dt), img));
+
+		DateTime refNext, imgNext;
+		bool refFound = reference.nextDateTimeOfInterest(dt, refNext);
+		CHECK(refFound == image.nextDateTimeOfInterest(dt, imgNext));
+		CHECK(! refFound || refNext == imgNext);
+
+		EventID id = 1 + (rand() % 70);
+		Event::Occurrence refOcc, imgOcc;
+		refFound = reference.nextOccurrenceOf(id, dt, refOcc);
+		CHECK(refFound == image.nextOccurrenceOf(id, dt, imgOcc));
+		CHECK(! refFound || (refOcc.start == imgOcc.start && refOcc.finish == imgOcc.finish));
+
+		refFound = reference.currentOccurrenceOf(id, dt, refOcc);
+		CHECK(refFound == image.currentOccurrenceOf(id, dt, imgOcc));
+		CHECK(! refFound || (refOcc.start == imgOcc.start && refOcc.finish == imgOcc.finish));
+	}
+}
+
+int main()
+{
+	DateTime base(2026, 11, 2, 0, 0, 1);
+
+	// recurring events, bounded and not, at whole minutes...
+	Chronos::Event standup(1, Mark::Daily(9, 0, 0), Span::Minutes(15));
+	standup.setCount(8, base);
+	addBoth(standup);
+
+	Chronos::Event weekly(2, Mark::Weekly(Weekday::Monday, 10, 30, 0), Span::Hours(1));
+	weekly.setUntil(base + Span::Days(9));
+	weekly.setTag(5);
+	addBoth(weekly);
+
+	addBoth(Chronos::Event(3, Mark::MonthlyNthWeekday(1, Weekday::Thursday, 19, 0, 0), Span::Hours(2)));
+
+	// ... and one-time ones, at distinct odd seconds over ten days, some sharing ids
+	srand(47);
+	for (int i=0; i<NUM_ONETIME; i++)
+	{
+		DateTime start(base + (Chronos::EpochTime)(((i * 37) % NUM_ONETIME) * 8642));
+		Chronos::Event evt(10 + (i % 60), start, start + Span::Seconds(rand() % (5 * 3600)));
+		if (i % 7 == 0)
+			evt.setTag(5);
+		addBoth(evt);
+	}
+
+	// what images can't hold
+	Chronos::Event withExceptions(standup);
+	static const DateTime holidays[] = { DateTime(2026, 11, 3, 9, 0, 0) };
+	withExceptions.setExceptions(holidays, 1);
+	CHECK(! builder.add(withExceptions));
+	CHECK(! builder.add(Chronos::Event(4, Mark::Union(Mark::Daily(8, 0, 0), Mark::Daily(20, 0, 0)),
+			Span::Minutes(5))));
+
+	// written to a (4-byte aligned) buffer...
+	uint32_t size = builder.size();
+	std::vector<uint32_t> buffer((size + 3) / 4 + 1);
+	CHECK(builder.write(&(buffer[0]), size - 1) == 0);
+	CHECK(builder.write(&(buffer[0]), size) == size);
+
+	CalendarImage image;
+	CHECK(image.attach(&(buffer[0]), size));
+	CHECK(image.numEvents() == reference.numEvents());
+	CHECK(image.numOneTime() == NUM_ONETIME);
+	compareQueries(image, base);
+
+	// ... holding all it was given: built again from eventAt(), it's the same image
+	CalendarImage::Builder again;
+	Chronos::Event evt;
+	for (uint32_t i=0; image.eventAt(i, evt); i++)
+	{
+		CHECK(again.add(evt));
+	}
+	CHECK(again.size() == size);
+	std::vector<uint32_t> rebuilt(buffer.size());
+	CHECK(again.write(&(rebuilt[0]), size) == size);
+	CHECK(! memcmp(&(buffer[0]), &(rebuilt[0]), size));
+
+	// and through a file
+	char path[] = "/tmp/chronos_test_image_XXXXXX";
+	int fd = mkstemp(path);
+	CHECK(fd >= 0);
+	close(fd);
+	CHECK(builder.writeFile(path));
+	CalendarImage mapped;
+	CHECK(mapped.map(path));
+	compareQueries(mapped, base);
+	mapped.clear();
+	CHECK(! mapped.isAttached());
+
+	// a truncated file isn't an image
+	CHECK(0 == truncate(path, size - 4));
+	CHECK(! mapped.map(path));
+	unlink(path);
+
+	// truncated, misaligned or tampered with: turned down, leaving the calendar empty
+	for (uint32_t truncated=0; truncated<size; truncated += 7)
+	{
+		CHECK(! image.attach(&(buffer[0]), truncated));
+		CHECK(! image.isAttached() && image.numEvents() == 0);
+	}
+
+	std::vector<uint32_t> shifted(buffer.size() + 1);
+	memcpy(reinterpret_cast<uint8_t *>(&(shifted[0])) + 1, &(buffer[0]), size);
+	CHECK(! image.attach(reinterpret_cast<uint8_t *>(&(shifted[0])) + 1, size));
+
+	const CalendarImage::Header & hdr = *reinterpret_cast<const CalendarImage::Header *>(&(buffer[0]));
+	const size_t headerFields[] = { 0, 4, 6, 8, 12, 16, 24, 28, 32, 36, 40, 44 };
+	for (size_t f=0; f<sizeof(headerFields)/sizeof(headerFields[0]); f++)
+	{
+		std::vector<uint32_t> tampered(buffer);
+		reinterpret_cast<uint8_t *>(&(tampered[0]))[headerFields[f]] ^= 0x41;
+		CHECK(! image.attach(&(tampered[0]), size));
+	}
+
+	// a recurring event whose mark isn't one
+	std::vector<uint32_t> badMark(buffer);
+	reinterpret_cast<CalendarImage::Record *>(reinterpret_cast<uint8_t *>(&(badMark[0]))
+			+ hdr.recurring)->mark.kind = 0xee;
+	CHECK(! image.attach(&(badMark[0]), size));
+	CHECK(image.numEvents() == 0);
+
+	// anything else may get past attach(), but must not send queries astray
+	Event::Occurrence occs[LIST_SIZE];
+	for (int run=0; run<200; run++)
+	{
+		std::vector<uint32_t> flipped(buffer);
+		for (int b=0; b<8; b++)
+		{
+			uint32_t offset = sizeof(CalendarImage::Header) + rand() % (size - sizeof(CalendarImage::Header));
+			reinterpret_cast<uint8_t *>(&(flipped[0]))[offset] ^= (1 << (rand() % 8));
+		}
+
+		if (image.attach(&(flipped[0]), size))
+		{
+			DateTime dt(base + (Chronos::EpochTime)(rand() % (10 * 86400)));
+			DateTime next;
+			Event::Occurrence occ;
+			image.listNext(LIST_SIZE, occs, dt);
+			image.listOngoing(LIST_SIZE, occs, dt);
+			image.nextDateTimeOfInterest(dt, next);
+			image.nextOccurrenceOf(10 + (run % 60), dt, occ);
+			image.currentOccurrenceOf(10 + (run % 60), dt, occ);
+		}
+		image.clear();
+	}
+
+	return CHECK_RESULT();
+}
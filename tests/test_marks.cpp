@@ -0,0 +1,128 @@
+/*
+ * test_marks.cpp
+ * Mark stepping: cursors must agree with chained next()/previous() calls.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include "check.h"
+
+// (yearly marks walk as many years: all stays within 1970..2106)
+#define NUM_STEPS	40
+
+using namespace Chronos;
+
+// walks mark from dt both ways, with a cursor and with chained searches, each
+// from one second past the last occurrence (as listNext() always did)
+static bool cursorMatchesSearch(const Mark::Event & mark, const DateTime & dt)
+{
+	Mark::Cursor fwd(mark.cursor(dt));
+	DateTime search(dt);
+	for (int i=0; i<NUM_STEPS; i++)
+	{
+		search = mark.next(i ? search + 1 : search);
+		DateTime stepped(fwd.advance());
+		if (stepped != search)
+		{
+			fprintf(stderr, "next #%d from %u: cursor %u, next() %u\n", i,
+					(unsigned)dt.asEpoch(), (unsigned)stepped.asEpoch(), (unsigned)search.asEpoch());
+			return false;
+		}
+	}
+
+	Mark::Cursor back(mark.reverseCursor(dt));
+	search = dt;
+	for (int i=0; i<NUM_STEPS; i++)
+	{
+		search = mark.previous(i ? search - 1 : search);
+		DateTime stepped(back.advance());
+		if (stepped != search)
+		{
+			fprintf(stderr, "previous #%d from %u: cursor %u, previous() %u\n", i,
+					(unsigned)dt.asEpoch(), (unsigned)stepped.asEpoch(), (unsigned)search.asEpoch());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static DateTime at(Year y, Month mo, Day d, Hours h, Minutes mi, Seconds s)
+{
+	return DateTime(y, mo, d, h, mi, s);
+}
+
+int main()
+{
+	Mark::Hourly hourly(15, 3);
+	Mark::Daily daily(9, 0, 0);
+	Mark::Weekly weeklyAt(Weekday::Monday, 10, 30, 0);
+	Mark::Weekly weekly(Weekday::Friday);
+	Mark::Monthly monthly31(31, 19, 0, 0);
+	Mark::Monthly monthly29(29, 0, 0, 0);
+	Mark::Monthly monthly(15);
+	Mark::Yearly leapDay(2, 29, 12, 0, 0);
+	Mark::Yearly yearly(7, 4);
+	Mark::Every every(at(2016, 1, 1, 0, 0, 17), Span::Minutes(97));
+	Mark::MonthlyNthWeekday lastFriday(-1, Weekday::Friday, 17, 0, 0);
+	Mark::MonthlyNthWeekday secondTuesday(2, Weekday::Tuesday, 8, 0, 0);
+	Mark::Union both(daily, weeklyAt);
+	Mark::Except weekdaysOnly(daily, Mark::Union(Mark::Weekly(Weekday::Saturday, 9, 0, 0),
+			Mark::Weekly(Weekday::Sunday, 9, 0, 0)));
+
+	const Mark::Event * marks[] = { &hourly, &daily, &weeklyAt, &weekly, &monthly31,
+			&monthly29, &monthly, &leapDay, &yearly, &every, &lastFriday, &secondTuesday,
+			&both, &weekdaysOnly };
+
+	// around month, year and leap day edges, then anywhere in 2020..2042
+	DateTime froms[40] = { at(2015, 12, 21, 17, 30, 0), at(2016, 1, 31, 9, 0, 0),
+			at(2016, 2, 29, 23, 59, 59), at(2015, 12, 31, 23, 59, 59), at(2016, 3, 1, 0, 0, 0),
+			at(2015, 12, 21, 10, 30, 0), at(2044, 2, 28, 12, 0, 0), at(2024, 2, 29, 12, 0, 0) };
+	srand(26);
+	for (int f=8; f<40; f++)
+		froms[f] = DateTime((Chronos::EpochTime)(1577836800UL + (rand() % 700000000UL)));
+
+	for (size_t m=0; m<sizeof(marks)/sizeof(marks[0]); m++)
+	{
+		for (int f=0; f<40; f++)
+		{
+			if (! cursorMatchesSearch(*marks[m], froms[f]))
+			{
+				fprintf(stderr, "... for mark #%u\n", (unsigned)m);
+				CHECK(false);
+			}
+		}
+	}
+
+	// days some months lack are skipped, and the result is a real 31st
+	DateTime thirtyFirst(monthly31.next(at(2015, 2, 10, 0, 0, 0)));
+	CHECK(thirtyFirst == at(2015, 3, 31, 19, 0, 0));
+	CHECK(thirtyFirst.day() == 31 && thirtyFirst.month() == 3);
+	CHECK(monthly31.previous(at(2015, 3, 15, 0, 0, 0)) == at(2015, 1, 31, 19, 0, 0));
+
+	// weekly marks from element-built DateTimes land on the right day
+	CHECK(weeklyAt.next(at(2015, 12, 22, 9, 0, 0)) == at(2015, 12, 28, 10, 30, 0));
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,291 @@
+/*
+ * test_mutationlog.cpp
+ * MutationLog recovery: a torn last frame is dropped and the commits before it replayed,
+ * snapshots reload, a log the snapshot already covers is skipped, and snapshots (taken by
+ * hand, by commit(), or both at once) move the generation on by one each.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "check.h"
+
+// (this test is built with CHRONOS_MUTATION_LOG_SNAPSHOT_BYTES=1024, see CMakeLists.txt)
+#define NUM_EVENTS		100
+
+using namespace Chronos;
+
+DefineCalendarType(TestCalendar, NUM_EVENTS);
+
+static TestCalendar calendar;
+static std::string base;
+
+static Event meeting(EventID id)
+{
+	return Event(id, DateTime(2026, 10, 19, 9) + Span::Days(id), Span::Hours(1));
+}
+
+static bool hasEvent(EventID id)
+{
+	Event evt;
+	for (uint32_t i=0; calendar.eventAt(i, evt); i++)
+	{
+		if (evt.id() == id)
+			return evt.start() == meeting(id).start() && evt.finish() == meeting(id).finish();
+	}
+	return false;
+}
+
+static off_t fileSize(const std::string & path)
+{
+	struct stat st;
+	return (stat(path.c_str(), &st) == 0) ? st.st_size : -1;
+}
+
+static void copyFile(const std::string & from, const std::string & to)
+{
+	std::string cmd("cp '" + from + "' '" + to + "'");
+	CHECK(system(cmd.c_str()) == 0);
+}
+
+static void removeFiles(const std::string & path)
+{
+	unlink((path + ".log").c_str());
+	unlink((path + ".snap").c_str());
+	rmdir((path + ".snap.tmp").c_str());
+}
+
+// a crash mid-write leaves part of a frame: it's dropped, and the frames before it kept
+static void testTornTail()
+{
+	std::string path(base + "/torn");
+	MutationLog log(calendar);
+	CHECK(log.open(path.c_str()));
+	CHECK(log.add(meeting(1)));
+	CHECK(log.add(meeting(2)));
+	CHECK(log.commit());
+	uint32_t goodSize = log.logSize();
+	CHECK(log.add(meeting(3)));
+	CHECK(log.remove(1));
+	CHECK(log.commit());
+	uint32_t fullSize = log.logSize();
+	log.close();
+	CHECK(fileSize(path + ".log") == (off_t)fullSize);
+	copyFile(path + ".log", path + ".full");
+
+	// torn in the frame header, then in the records
+	uint32_t tears[] = { goodSize + 3, (goodSize + fullSize) / 2, fullSize - 1 };
+	for (uint8_t t=0; t<sizeof(tears)/sizeof(tears[0]); t++)
+	{
+		copyFile(path + ".full", path + ".log");
+		CHECK(truncate((path + ".log").c_str(), tears[t]) == 0);
+		CHECK(log.open(path.c_str()));
+		CHECK(log.numReplayed() == 2);
+		CHECK(calendar.numEvents() == 2 && hasEvent(1) && hasEvent(2) && ! hasEvent(3));
+
+		// the tail is gone from the file too, and logging carries on after the good part
+		CHECK(log.logSize() == goodSize);
+		CHECK(fileSize(path + ".log") == (off_t)goodSize);
+		CHECK(log.add(meeting(4)));
+		log.close();
+		CHECK(log.open(path.c_str()));
+		CHECK(calendar.numEvents() == 3 && hasEvent(4));
+		log.close();
+	}
+
+	// even the first frame
+	CHECK(truncate((path + ".log").c_str(), goodSize - 1) == 0);
+	CHECK(log.open(path.c_str()));
+	CHECK(log.numReplayed() == 0 && calendar.numEvents() == 0);
+	log.close();
+	unlink((path + ".full").c_str());
+	removeFiles(path);
+}
+
+// snapshot, more changes, reopen: snapshot and log both applied
+static void testSnapshot()
+{
+	std::string path(base + "/snap");
+	MutationLog log(calendar);
+	CHECK(log.open(path.c_str()));
+	CHECK(log.generation() == 0);
+	for (EventID id=1; id<=20; id++)
+		CHECK(log.add(meeting(id)));
+	CHECK(log.snapshot());
+	CHECK(log.generation() == 1);
+	CHECK(log.remove(5));
+	CHECK(log.add(meeting(21)));
+	log.close();
+
+	CHECK(log.open(path.c_str()));
+	CHECK(log.generation() == 1);
+	CHECK(log.numReplayed() == 22);
+	CHECK(calendar.numEvents() == 20 && ! hasEvent(5) && hasEvent(21) && hasEvent(20));
+	log.close();
+	removeFiles(path);
+}
+
+// a crash between writing the snapshot and starting the new log leaves the old log,
+// whose changes the snapshot already has: it isn't replayed again
+static void testStaleLog()
+{
+	std::string path(base + "/stale");
+	MutationLog log(calendar);
+	CHECK(log.open(path.c_str()));
+	for (EventID id=1; id<=10; id++)
+		CHECK(log.add(meeting(id)));
+	CHECK(log.commit());
+	copyFile(path + ".log", path + ".old");
+	CHECK(log.snapshot());
+	log.close();
+
+	copyFile(path + ".old", path + ".log");
+	unlink((path + ".old").c_str());
+	CHECK(log.open(path.c_str()));
+	CHECK(log.generation() == 1);
+	CHECK(log.numReplayed() == 10);
+	CHECK(calendar.numEvents() == 10);
+
+	// and it's replaced by a log for the snapshot's generation
+	CHECK(log.add(meeting(11)));
+	log.close();
+	CHECK(log.open(path.c_str()));
+	CHECK(log.generation() == 1 && calendar.numEvents() == 11);
+	log.close();
+	removeFiles(path);
+}
+
+// log some changes that leave the calendar as it was, for a size
+static void churn(MutationLog & log, uint32_t untilSize)
+{
+	while (log.logSize() < untilSize)
+	{
+		CHECK(log.add(meeting(100)));
+		CHECK(log.remove(100));
+		CHECK(log.commit());
+	}
+}
+
+static void testGenerations()
+{
+	std::string path(base + "/gen");
+	MutationLog log(calendar);
+	CHECK(log.open(path.c_str()));
+	CHECK(log.add(meeting(1)));
+
+	// commit() past the threshold takes the snapshot itself
+	uint32_t before = log.generation();
+	churn(log, 1024 - 100);
+	CHECK(log.generation() == before);
+	while (log.generation() == before)
+	{
+		CHECK(log.add(meeting(100)));
+		CHECK(log.remove(100));
+		CHECK(log.commit());
+	}
+	CHECK(log.generation() == before + 1);
+	CHECK(log.logSize() < 100);
+
+	// snapshot() whose own commit crosses the threshold: still only one
+	churn(log, 1024 - 100);
+	for (EventID id=10; id<30; id++)
+		CHECK(log.add(meeting(id)));
+	before = log.generation();
+	CHECK(log.snapshot());
+	CHECK(log.generation() == before + 1);
+	log.close();
+
+	CHECK(log.open(path.c_str()));
+	CHECK(log.generation() == before + 1);
+	CHECK(calendar.numEvents() == 21 && hasEvent(1) && hasEvent(29) && ! hasEvent(100));
+	log.close();
+	removeFiles(path);
+}
+
+// a snapshot that fails isn't tried again by every commit after it
+static void testSnapshotBackoff()
+{
+	std::string path(base + "/backoff");
+	MutationLog log(calendar);
+	CHECK(log.open(path.c_str()));
+	CHECK(log.add(meeting(1)));
+
+	// nothing can be created where the snapshot gets written
+	CHECK(mkdir((path + ".snap.tmp").c_str(), 0755) == 0);
+	churn(log, 1024);
+	CHECK(log.generation() == 0);
+	uint32_t failedAt = log.logSize();
+
+	// once it could work again, it waits for the log to grow by the threshold...
+	CHECK(rmdir((path + ".snap.tmp").c_str()) == 0);
+	churn(log, failedAt + 1024 - 100);
+	CHECK(log.generation() == 0);
+	CHECK(fileSize(path + ".snap") < 0);
+
+	// ... then goes ahead
+	while (log.generation() == 0)
+	{
+		CHECK(log.add(meeting(100)));
+		CHECK(log.remove(100));
+		CHECK(log.commit());
+	}
+	CHECK(log.generation() == 1);
+	CHECK(log.logSize() < 100);
+
+	// and a snapshot() asked for is tried regardless
+	CHECK(mkdir((path + ".snap.tmp").c_str(), 0755) == 0);
+	CHECK(! log.snapshot());
+	CHECK(rmdir((path + ".snap.tmp").c_str()) == 0);
+	CHECK(log.snapshot());
+	CHECK(log.generation() == 2);
+	log.close();
+
+	CHECK(log.open(path.c_str()));
+	CHECK(calendar.numEvents() == 1 && hasEvent(1));
+	log.close();
+	removeFiles(path);
+}
+
+int main()
+{
+	char dir[] = "/tmp/chronos_mutationlog_XXXXXX";
+	if (! mkdtemp(dir))
+	{
+		perror("mkdtemp");
+		return 1;
+	}
+	base = dir;
+
+	testTornTail();
+	testSnapshot();
+	testStaleLog();
+	testGenerations();
+	testSnapshotBackoff();
+
+	rmdir(dir);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,156 @@
+/*
+ * test_mutationqueue.cpp
+ * Changes posted to a MutationQueue from several threads, applied in batches by the thread owning the calendar.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "check.h"
+
+#define NUM_PRODUCERS	4
+#define IDS_PER_PRODUCER	30
+#define ROUNDS			20
+#define SHARED_ID		121
+#define LIST_SIZE		40
+
+using namespace Chronos;
+
+DefineColumnarCalendarType(Columnar, NUM_PRODUCERS * IDS_PER_PRODUCER + 8, 2 * NUM_PRODUCERS);
+
+static Columnar calendar;
+static MutationQueue changes;
+static std::atomic<unsigned> numDone(0);
+
+static const DateTime base(2016, 3, 1, 0, 0, 0);
+
+// copied (along with its user-defined mark) by every producer at once
+static Chronos::Event shared(SHARED_ID,
+		Mark::Union(Mark::Daily(23, 0, 0), Mark::Weekly(Weekday::Sunday, 22, 0, 0)), Span::Minutes(10));
+
+static DateTime firstStart(EventID id) { return base + (Chronos::EpochTime)(id * 600 + 7); }
+static DateTime finalStart(EventID id) { return base + (Chronos::EpochTime)(id * 600 + 1); }
+
+/*
+ * Each producer has its own ids, and posts changes that only succeed in the order
+ * they were posted: anything applied out of order gets rejected.
+ */
+static void producer(int p)
+{
+	EventTag tag = p + 1;
+	for (int round=0; round<ROUNDS; round++)
+	{
+		for (int i=0; i<IDS_PER_PRODUCER; i++)
+		{
+			EventID id = 1 + p * IDS_PER_PRODUCER + i;
+			Chronos::Event first(id, firstStart(id), firstStart(id) + Span::Minutes(5));
+			changes.add(first);
+			changes.setTag(id, tag);
+			changes.remove(id);
+			changes.add(Chronos::Event(id, finalStart(id), finalStart(id) + Span::Minutes(5)));
+			changes.setTag(id, tag);
+			if (round < ROUNDS - 1)
+				changes.remove(id);
+		}
+	}
+
+	changes.add(shared);
+	changes.add(shared);
+	numDone.fetch_add(1);
+}
+
+static void checkFinal()
+{
+	CHECK(calendar.numEvents() == NUM_PRODUCERS * IDS_PER_PRODUCER + 2 * NUM_PRODUCERS);
+	CHECK(calendar.numRecurring() == 2 * NUM_PRODUCERS);
+
+	Event::Occurrence occ;
+	for (EventID id=1; id<=NUM_PRODUCERS * IDS_PER_PRODUCER; id++)
+	{
+		CHECK(calendar.nextOccurrenceOf(id, base, occ) && occ.start == finalStart(id));
+	}
+
+	// each producer's events, and only those, carry its tag
+	Event::Occurrence list[LIST_SIZE];
+	for (int p=0; p<NUM_PRODUCERS; p++)
+	{
+		uint8_t num = calendar.listNext(p + 1, LIST_SIZE, list, base);
+		CHECK(num == IDS_PER_PRODUCER);
+		for (uint8_t i=0; i<num; i++)
+		{
+			CHECK(list[i].id == 1 + p * IDS_PER_PRODUCER + i);
+		}
+	}
+}
+
+int main()
+{
+	std::vector<std::thread> producers;
+	for (int p=0; p<NUM_PRODUCERS; p++)
+		producers.push_back(std::thread(producer, p));
+
+	// apply in small batches, querying in between, while the producers post
+	Event::Occurrence list[LIST_SIZE];
+	uint32_t numApplied = 0;
+	unsigned numBatches = 0;
+	while (numDone.load() < NUM_PRODUCERS)
+	{
+		numApplied += changes.applyTo(calendar, 37);
+		numBatches++;
+
+		uint8_t num = calendar.listNext(LIST_SIZE, list, base);
+		for (uint8_t i=1; i<num; i++)
+		{
+			CHECK(list[i - 1].start <= list[i].start);
+		}
+	}
+
+	for (size_t p=0; p<producers.size(); p++)
+		producers[p].join();
+
+	// and whatever's left, inside an outer batch: nothing changes in the tag
+	// index until the outermost endUpdate()
+	calendar.beginUpdate();
+	uint16_t numLeft;
+	while ((numLeft = changes.applyTo(calendar)))
+		numApplied += numLeft;
+	CHECK(changes.applyTo(calendar) == 0);
+	calendar.endUpdate();
+
+	CHECK(numBatches > 0);
+	CHECK(numApplied == NUM_PRODUCERS * (IDS_PER_PRODUCER * (6 * ROUNDS - 1) + 2));
+	CHECK(changes.numRejected() == 0);
+	checkFinal();
+
+	// a clear() takes effect in order too
+	changes.remove(1);
+	changes.clear();
+	changes.add(Chronos::Event(2, finalStart(2), finalStart(2) + Span::Minutes(5)));
+	CHECK(changes.applyTo(calendar) == 3);
+	CHECK(changes.numRejected() == 0);
+	CHECK(calendar.numEvents() == 1 && calendar.listNext(LIST_SIZE, list, base) == 1 && list[0].id == 2);
+
+	return CHECK_RESULT();
+}
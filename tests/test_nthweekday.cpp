@@ -0,0 +1,102 @@
+/*
+ * test_nthweekday.cpp
+ * Mark::MonthlyNthWeekday dates: 2nd tuesday, last friday, and a 5th monday that skips
+ * the months without one, both ways and through a cursor.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include "check.h"
+
+using namespace Chronos;
+
+typedef struct {
+	Year year;
+	Month month;
+	Day day;
+} Date;
+
+// walk mark both ways over dates (all at h:00), with next()/previous() and with cursors
+static void checkDates(const Mark::Event & mark, const Date dates[], int num, Hours h)
+{
+	DateTime dt(dates[0].year, dates[0].month, 1, 0, 0, 0);
+	Mark::Cursor fwd(mark.cursor(dt));
+	for (int i=0; i<num; i++)
+	{
+		DateTime expected(dates[i].year, dates[i].month, dates[i].day, h, 0, 0);
+		dt = mark.next(dt);
+		if (dt != expected)
+		{
+			fprintf(stderr, "next #%d: %u-%u-%u, expected %u-%u-%u\n", i, dt.year(), dt.month(), dt.day(),
+					dates[i].year, dates[i].month, dates[i].day);
+			CHECK(false);
+		}
+		CHECK(fwd.advance() == expected);
+	}
+
+	Mark::Cursor back(mark.reverseCursor(dt + 1));
+	for (int i=num-1; i>=0; i--)
+	{
+		DateTime expected(dates[i].year, dates[i].month, dates[i].day, h, 0, 0);
+		CHECK(mark.previous(dt + 1) == expected);
+		CHECK(back.advance() == expected);
+		dt = mark.previous(dt);
+	}
+}
+
+int main()
+{
+	const Date secondTuesdays[] = { {2016, 1, 12}, {2016, 2, 9}, {2016, 3, 8}, {2016, 4, 12},
+			{2016, 5, 10}, {2016, 6, 14}, {2016, 7, 12}, {2016, 8, 9}, {2016, 9, 13},
+			{2016, 10, 11}, {2016, 11, 8}, {2016, 12, 13} };
+	checkDates(Mark::MonthlyNthWeekday(2, Weekday::Tuesday, 8, 0, 0), secondTuesdays, 12, 8);
+
+	const Date lastFridays[] = { {2016, 1, 29}, {2016, 2, 26}, {2016, 3, 25}, {2016, 4, 29},
+			{2016, 5, 27}, {2016, 6, 24}, {2016, 7, 29}, {2016, 8, 26}, {2016, 9, 30},
+			{2016, 10, 28}, {2016, 11, 25}, {2016, 12, 30} };
+	checkDates(Mark::MonthlyNthWeekday(-1, Weekday::Friday, 17, 0, 0), lastFridays, 12, 17);
+
+	// only some months have a fifth monday, the others are skipped
+	const Date fifthMondays[] = { {2016, 2, 29}, {2016, 5, 30}, {2016, 8, 29}, {2016, 10, 31},
+			{2017, 1, 30}, {2017, 5, 29}, {2017, 7, 31}, {2017, 10, 30} };
+	checkDates(Mark::MonthlyNthWeekday(5, Weekday::Monday, 9, 0, 0), fifthMondays, 8, 9);
+
+	// in those, the 5th-last is the first one
+	Mark::MonthlyNthWeekday fifthLastMonday(-5, Weekday::Monday, 9, 0, 0);
+	CHECK(fifthLastMonday.next(DateTime(2016, 2, 1, 0, 0, 0)) == DateTime(2016, 2, 1, 9, 0, 0));
+	CHECK(fifthLastMonday.next(DateTime(2016, 2, 2, 0, 0, 0)) == DateTime(2016, 5, 2, 9, 0, 0));
+
+	// at exactly an occurrence, next() and previous() move on
+	Mark::MonthlyNthWeekday secondTuesday(2, Weekday::Tuesday, 8, 0, 0);
+	CHECK(secondTuesday.next(DateTime(2016, 3, 8, 8, 0, 0)) == DateTime(2016, 4, 12, 8, 0, 0));
+	CHECK(secondTuesday.previous(DateTime(2016, 3, 8, 8, 0, 0)) == DateTime(2016, 2, 9, 8, 0, 0));
+	CHECK(secondTuesday.next(DateTime(2016, 3, 8, 7, 59, 59)) == DateTime(2016, 3, 8, 8, 0, 0));
+
+	// out of range n is kept within [-5, 5], and 0 is the first
+	CHECK(Mark::MonthlyNthWeekday(9, Weekday::Monday, 9, 0, 0).next(DateTime(2016, 2, 1, 0, 0, 0))
+			== DateTime(2016, 2, 29, 9, 0, 0));
+	CHECK(Mark::MonthlyNthWeekday(0, Weekday::Monday, 9, 0, 0).next(DateTime(2016, 2, 1, 0, 0, 0))
+			== DateTime(2016, 2, 1, 9, 0, 0));
+
+	return CHECK_RESULT();
+}
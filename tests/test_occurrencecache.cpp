@@ -0,0 +1,226 @@
+/*
+ * test_occurrencecache.cpp
+ * With CHRONOS_EVENT_OCCURRENCE_CACHE, a calendar polled over and over (caches warm)
+ * answers exactly as one rebuilt from fresh events for each query, through removes,
+ * setTag()s, clear()s and jumps back in time.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <vector>
+#include "check.h"
+
+#define NUM_QUERIES		4000
+#define LIST_SIZE		12
+#define NUM_KINDS		11
+
+using namespace Chronos;
+
+DefineCalendarType(TestCalendar, 40);
+
+typedef struct {
+	EventID id;
+	uint8_t kind;
+	EventTag tag;
+} Spec;
+
+static const DateTime holidays[] = { DateTime(2016, 1, 4, 7, 0, 0), DateTime(2016, 1, 11, 7, 0, 0),
+		DateTime(2016, 2, 1, 7, 0, 0) };
+
+// a fresh event (cold cache) for the spec
+static Chronos::Event build(const Spec & spec)
+{
+	Chronos::Event evt;
+	switch (spec.kind)
+	{
+	case 0: evt = Chronos::Event(spec.id, Mark::Daily(9, 0, 0), Span::Hours(1)); break;
+	case 1: evt = Chronos::Event(spec.id, Mark::Hourly(15, 0), Span::Minutes(10)); break;
+	case 2: evt = Chronos::Event(spec.id, Mark::Weekly(Weekday::Monday, 10, 30, 0), Span::Hours(2)); break;
+	case 3: evt = Chronos::Event(spec.id, Mark::Weekly(Weekday::Friday), Span::Hours(1)); break; // not fixed
+	case 4: evt = Chronos::Event(spec.id, Mark::Every(DateTime(2016, 1, 1, 0, 2, 0), Span::Minutes(97)),
+			Span::Minutes(20)); break;
+	case 5: evt = Chronos::Event(spec.id, Mark::MonthlyNthWeekday(-1, Weekday::Friday, 17, 0, 0),
+			Span::Hours(3)); break;
+	case 6: evt = Chronos::Event(spec.id, Mark::Union(Mark::Daily(12, 0, 0), Mark::Weekly(Weekday::Saturday, 8, 0, 0)),
+			Span::Minutes(30)); break;
+	case 7:
+		evt = Chronos::Event(spec.id, Mark::Daily(18, 0, 0), Span::Minutes(45));
+		evt.setCount(20, DateTime(2016, 1, 3, 0, 0, 0));
+		break;
+	case 8:
+		evt = Chronos::Event(spec.id, Mark::Daily(7, 0, 0), Span::Minutes(15));
+		evt.setExceptions(holidays, 3);
+		break;
+	case 9: evt = Chronos::Event(spec.id, DateTime(2016, 1, 5, 14, 0, 0), Span::Hours(2)); break;
+	default: evt = Chronos::Event(spec.id, Mark::Daily(23, 30, 0), Span::Hours(2)); break;
+	}
+	evt.setTag(spec.tag);
+	return evt;
+}
+
+static bool sameLists(const char * what, uint8_t numA, const Chronos::Event::Occurrence a[],
+		uint8_t numB, const Chronos::Event::Occurrence b[])
+{
+	bool same = (numA == numB);
+	for (uint8_t i=0; same && i<numA; i++)
+	{
+		same = (a[i].id == b[i].id && a[i].start == b[i].start && a[i].finish == b[i].finish
+				&& a[i].isOngoing == b[i].isOngoing);
+	}
+	if (! same)
+		fprintf(stderr, "%s differs (%u vs %u)\n", what, numA, numB);
+	return same;
+}
+
+static bool sameOccurrence(bool foundA, const Chronos::Event::Occurrence & a,
+		bool foundB, const Chronos::Event::Occurrence & b)
+{
+	if (foundA != foundB)
+		return false;
+	return ! foundA || (a.id == b.id && a.start == b.start && a.finish == b.finish && a.isOngoing == b.isOngoing);
+}
+
+static TestCalendar polled;
+static TestCalendar fresh;
+static std::vector<Spec> specs;
+
+static void compareAt(const DateTime & dt)
+{
+	fresh.clear();
+	for (size_t i=0; i<specs.size(); i++)
+		fresh.add(build(specs[i]));
+
+	Chronos::Event::Occurrence a[LIST_SIZE], b[LIST_SIZE];
+	CHECK(sameLists("listNext", polled.listNext(LIST_SIZE, a, dt), a, fresh.listNext(LIST_SIZE, b, dt), b));
+	CHECK(sameLists("listOngoing", polled.listOngoing(LIST_SIZE, a, dt), a, fresh.listOngoing(LIST_SIZE, b, dt), b));
+	CHECK(sameLists("listNext(tag)", polled.listNext(2, LIST_SIZE, a, dt), a, fresh.listNext(2, LIST_SIZE, b, dt), b));
+
+	DateTime nextA, nextB;
+	bool foundA = polled.nextDateTimeOfInterest(dt, nextA);
+	bool foundB = fresh.nextDateTimeOfInterest(dt, nextB);
+	CHECK(foundA == foundB && (! foundA || nextA == nextB));
+
+	for (size_t i=0; i<specs.size(); i++)
+	{
+		Chronos::Event::Occurrence occA, occB;
+		foundA = polled.nextOccurrenceOf(specs[i].id, dt, occA);
+		foundB = fresh.nextOccurrenceOf(specs[i].id, dt, occB);
+		CHECK(sameOccurrence(foundA, occA, foundB, occB));
+		foundA = polled.currentOccurrenceOf(specs[i].id, dt, occA);
+		foundB = fresh.currentOccurrenceOf(specs[i].id, dt, occB);
+		CHECK(sameOccurrence(foundA, occA, foundB, occB));
+	}
+}
+
+static void addSpec(EventID id, uint8_t kind, EventTag tag)
+{
+	Spec spec = { id, kind, tag };
+	if (polled.add(build(spec)))
+		specs.push_back(spec);
+}
+
+static void populate()
+{
+	for (uint8_t k=0; k<NUM_KINDS; k++)
+		addSpec(10 + k, k, k % 4);
+}
+
+static void mutate(int step)
+{
+	switch (step % 4)
+	{
+	case 0:
+		// remove one (its later slots move down)
+		if (! specs.empty())
+		{
+			EventID id = specs[rand() % specs.size()].id;
+			CHECK(polled.remove(id));
+			for (size_t i=0; i<specs.size(); i++)
+			{
+				if (specs[i].id == id)
+				{
+					specs.erase(specs.begin() + i);
+					break;
+				}
+			}
+		}
+		break;
+	case 1:
+		if (! specs.empty())
+		{
+			EventID id = specs[rand() % specs.size()].id;
+			EventTag tag = rand() % 4;
+			CHECK(polled.setTag(id, tag));
+			for (size_t i=0; i<specs.size(); i++)
+			{
+				if (specs[i].id == id)
+					specs[i].tag = tag;
+			}
+		}
+		break;
+	case 2:
+		addSpec(30 + (rand() % 40), rand() % NUM_KINDS, rand() % 4);
+		break;
+	default:
+		polled.clear();
+		specs.clear();
+		populate();
+		break;
+	}
+}
+
+int main()
+{
+	srand(34);
+	populate();
+
+	DateTime dt(2016, 1, 1, 0, 0, 0);
+	for (int q=0; q<NUM_QUERIES; q++)
+	{
+		compareAt(dt);
+
+		int r = rand() % 100;
+		if (r < 60)
+		{
+			// creep forward, the case the cache is for
+			dt += (Chronos::EpochTime)(rand() % 1800);
+		} else if (r < 85)
+		{
+			// right onto (or just before, or after) a boundary
+			DateTime boundary;
+			if (polled.nextDateTimeOfInterest(dt, boundary))
+				dt = boundary + (Chronos::EpochTime)(rand() % 3) - (Chronos::EpochTime)1;
+		} else if (r < 95)
+		{
+			dt -= (Chronos::EpochTime)(rand() % (3 * SECS_PER_DAY));
+		} else {
+			dt = DateTime(2016, 1, 1, 0, 0, 0) + (Chronos::EpochTime)(rand() % (60 * SECS_PER_DAY));
+		}
+
+		if (q % 150 == 149)
+			mutate(q / 150);
+	}
+
+	return CHECK_RESULT();
+}
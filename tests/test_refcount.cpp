@@ -0,0 +1,100 @@
+/*
+ * test_refcount.cpp
+ * Heap marks shared between copies of events: saturation and threads.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <thread>
+#include <vector>
+#include "check.h"
+
+using namespace Chronos;
+
+static int num_alive = 0;
+
+// a user-defined mark, so events hold it on the heap and share it
+class EveryOtherDay : public Mark::Event {
+public:
+	EveryOtherDay() { num_alive++; }
+	virtual ~EveryOtherDay() { num_alive--; }
+
+	virtual DateTime next(const DateTime & dt) const {
+		return DateTime(((dt.asEpoch() / (2 * SECS_PER_DAY)) + 1) * 2 * SECS_PER_DAY);
+	}
+	virtual DateTime previous(const DateTime & dt) const {
+		return DateTime(((dt.asEpoch() - 1) / (2 * SECS_PER_DAY)) * 2 * SECS_PER_DAY);
+	}
+	virtual Mark::Event * clone() const { return new EveryOtherDay(); }
+};
+
+int main()
+{
+	{
+		Chronos::Event original(1, EveryOtherDay(), Span::Hours(1));
+		CHECK(num_alive == 1);
+
+		// more copies than a count can hold: past CHRONOS_MARK_MAX_REFERENCES
+		// (the original's own included), each copy gets a clone
+		std::vector<Chronos::Event> copies(70000);
+		for (size_t i=0; i<copies.size(); i++)
+		{
+			copies[i] = original;
+		}
+		CHECK(num_alive == 1 + (int)(copies.size() - (CHRONOS_MARK_MAX_REFERENCES - 1)));
+
+		DateTime from(2026, 1, 1, 12, 0, 0);
+		Chronos::Event::Occurrence expected(original.nextOccurrence(from));
+		CHECK(copies.front().nextOccurrence(from).start == expected.start);
+		CHECK(copies.back().nextOccurrence(from).start == expected.start);
+
+		copies.clear();
+		CHECK(num_alive == 1);
+	}
+	CHECK(num_alive == 0);
+
+	{
+		// copies made and dropped on several threads at once
+		Chronos::Event original(2, EveryOtherDay(), Span::Hours(1));
+		std::vector<std::thread> threads;
+		for (int t=0; t<4; t++)
+		{
+			threads.push_back(std::thread([&original] {
+				for (int i=0; i<100000; i++)
+				{
+					Chronos::Event copy(original);
+					Chronos::Event other;
+					other = copy;
+				}
+			}));
+		}
+		for (size_t t=0; t<threads.size(); t++)
+		{
+			threads[t].join();
+		}
+		CHECK(num_alive == 1);
+	}
+	CHECK(num_alive == 0);
+
+	return CHECK_RESULT();
+}
@@ -0,0 +1,170 @@
+/*
+ * test_replay.cpp
+ * A year of ScheduleReplay, in simulated time: every start and end, once, in order.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <vector>
+#include "check.h"
+
+#define NUM_POINTS		40
+
+using namespace Chronos;
+
+DefineCalendarType(Calendar8, 8);
+DefineColumnarCalendarType(Columnar, NUM_POINTS + 4, 2);
+
+static const DateTime yearStart(2017, 1, 1, 0, 0, 0);
+static const DateTime yearEnd(2017, 12, 31, 23, 59, 59);
+
+// counts per event id, and the order of the calls
+class Counter : public ScheduleReplay::Listener {
+public:
+	Counter() : numCalls(0), numClockWrong(0), numOutOfOrder(0), numStartedTwice(0), lastAt(0), startedAt(0)
+	{
+		for (int i=0; i<128; i++)
+		{
+			numStarted[i] = 0;
+			numEnded[i] = 0;
+		}
+	}
+
+	virtual void ended(const DateTime & at, const Event::Occurrence occurrences[], uint8_t num)
+	{
+		called(at);
+		for (uint8_t i=0; i<num; i++)
+		{
+			numEnded[occurrences[i].id]++;
+			// ends come before the starts at the same time, but for zero-length ones
+			if (occurrences[i].start != occurrences[i].finish && startedAt == at.asEpoch())
+				numOutOfOrder++;
+			if (occurrences[i].finish != at)
+				numOutOfOrder++;
+		}
+	}
+
+	virtual void started(const DateTime & at, const Event::Occurrence occurrences[], uint8_t num)
+	{
+		called(at);
+		if (startedAt == at.asEpoch())
+			numStartedTwice++;
+		startedAt = at.asEpoch();
+		for (uint8_t i=0; i<num; i++)
+		{
+			numStarted[occurrences[i].id]++;
+			if (occurrences[i].start != at)
+				numOutOfOrder++;
+		}
+	}
+
+	uint32_t numStarted[128];
+	uint32_t numEnded[128];
+	uint32_t numCalls;
+	uint32_t numClockWrong;
+	uint32_t numOutOfOrder;
+	uint32_t numStartedTwice;
+
+private:
+	void called(const DateTime & at)
+	{
+		numCalls++;
+		// the clock's where the replay is, and it only ever moves forward
+		if (DateTime::now() != at)
+			numClockWrong++;
+		if (at.asEpoch() < lastAt)
+			numOutOfOrder++;
+		lastAt = at.asEpoch();
+	}
+
+	Chronos::EpochTime lastAt;
+	Chronos::EpochTime startedAt;
+};
+
+static void testYear()
+{
+	Calendar8 calendar;
+	CHECK(calendar.add(Chronos::Event(1, Mark::Hourly(0, 0), Span::Minutes(10))));
+	CHECK(calendar.add(Chronos::Event(2, Mark::Daily(9, 0, 0), Span::Hours(1))));
+	CHECK(calendar.add(Chronos::Event(3, Mark::Weekly(Weekday::Monday, 10, 0, 0), Span::Hours(2))));
+	CHECK(calendar.add(Chronos::Event(4, DateTime(2017, 7, 4, 12, 0, 0), DateTime(2017, 7, 4, 18, 0, 0))));
+	// zero-length
+	CHECK(calendar.add(Chronos::Event(5, DateTime(2017, 3, 15, 6, 30, 0), DateTime(2017, 3, 15, 6, 30, 0))));
+	// ends as event 1 starts
+	CHECK(calendar.add(Chronos::Event(6, Mark::Daily(22, 30, 0), Span::Minutes(30))));
+	// already on at the start: only its end is reported
+	CHECK(calendar.add(Chronos::Event(7, DateTime(2016, 12, 31, 23, 30, 0), DateTime(2017, 1, 1, 0, 30, 0))));
+
+	ScheduleReplay replay(calendar);
+	Counter counter;
+	uint32_t numSteps = replay.run(yearStart, yearEnd, counter);
+
+	CHECK(counter.numStarted[1] == 8760 && counter.numEnded[1] == 8760);
+	CHECK(counter.numStarted[2] == 365 && counter.numEnded[2] == 365);
+	CHECK(counter.numStarted[3] == 52 && counter.numEnded[3] == 52);
+	CHECK(counter.numStarted[4] == 1 && counter.numEnded[4] == 1);
+	CHECK(counter.numStarted[5] == 1 && counter.numEnded[5] == 1);
+	CHECK(counter.numStarted[6] == 365 && counter.numEnded[6] == 365);
+	CHECK(counter.numStarted[7] == 0 && counter.numEnded[7] == 1);
+
+	CHECK(replay.numStarted() == 8760 + 365 + 52 + 1 + 1 + 365);
+	CHECK(replay.numEnded() == replay.numStarted() + 1);
+
+	// every hour and ten past, and (as the other edges fall on the hour) 6:30 on
+	// March 15th, 22:30 every day and 0:30 on January 1st
+	CHECK(numSteps == 2 * 8760 + 1 + 365 + 1);
+
+	CHECK(counter.numClockWrong == 0);
+	CHECK(counter.numOutOfOrder == 0);
+	CHECK(counter.numStartedTwice == 0);
+}
+
+static void testManyPoints()
+{
+	// more zero-length occurrences at once than numEvents() tells, through a Calendar &
+	Columnar columnar;
+	CHECK(columnar.add(Chronos::Event(1, Mark::Hourly(0, 0), Span::Minutes(10))));
+	DateTime noon(2017, 6, 1, 12, 0, 0);
+	for (int i=0; i<NUM_POINTS; i++)
+		CHECK(columnar.emplace(10 + i, noon, noon));
+
+	Calendar & calendar = columnar;
+	CHECK(calendar.numEvents() == 1);
+
+	ScheduleReplay replay(calendar);
+	Counter counter;
+	replay.run(DateTime(2017, 6, 1, 0, 0, 0), DateTime(2017, 6, 1, 23, 59, 59), counter);
+
+	for (int i=0; i<NUM_POINTS; i++)
+		CHECK(counter.numStarted[10 + i] == 1 && counter.numEnded[10 + i] == 1);
+	CHECK(counter.numStarted[1] == 24 && counter.numEnded[1] == 24);
+	CHECK(counter.numOutOfOrder == 0);
+	CHECK(counter.numClockWrong == 0);
+}
+
+int main()
+{
+	testYear();
+	testManyPoints();
+	return CHECK_RESULT();
+}
@@ -0,0 +1,163 @@
+/*
+ * test_sharded.cpp
+ * A ShardedCalendar must answer queries just like a single CalendarColumnar holding the same events.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include "check.h"
+
+#define NUM_SHARDS		4
+#define NUM_ONETIME		190
+#define LIST_SIZE		30
+
+using namespace Chronos;
+
+DefineColumnarCalendarType(Reference, NUM_ONETIME + 10, 8);
+typedef ShardedCalendar<CalendarColumnar<NUM_ONETIME / 2, 4>, NUM_SHARDS> Sharded;
+
+static Reference reference;
+static Sharded sharded(NUM_SHARDS - 1);
+
+static bool sameLists(const char * what, const DateTime & dt,
+		uint8_t numRef, const Event::Occurrence ref[], uint8_t numSh, const Event::Occurrence sh[])
+{
+	bool same = (numRef == numSh);
+	for (uint8_t i=0; same && i<numRef; i++)
+	{
+		same = (ref[i].id == sh[i].id && ref[i].start == sh[i].start
+				&& ref[i].finish == sh[i].finish && ref[i].isOngoing == sh[i].isOngoing);
+	}
+
+	if (! same)
+		fprintf(stderr, "%s at %u: %u vs %u occurrences\n", what, (unsigned)dt.asEpoch(), numRef, numSh);
+
+	return same;
+}
+
+static void addBoth(const Chronos::Event & evt)
+{
+	CHECK(reference.add(evt));
+	CHECK(sharded.add(evt));
+}
+
+static void compareAt(const DateTime & dt)
+{
+	Event::Occurrence ref[LIST_SIZE];
+	Event::Occurrence sh[LIST_SIZE];
+
+	CHECK(sameLists("listNext", dt, reference.listNext(LIST_SIZE, ref, dt), ref,
+			sharded.listNext(LIST_SIZE, sh, dt), sh));
+	CHECK(sameLists("listNext(tag)", dt, reference.listNext(7, LIST_SIZE, ref, dt), ref,
+			sharded.listNext(7, LIST_SIZE, sh, dt), sh));
+	CHECK(sameLists("listOngoing", dt, reference.listOngoing(LIST_SIZE, ref, dt), ref,
+			sharded.listOngoing(LIST_SIZE, sh, dt), sh));
+	CHECK(sameLists("listOngoing(tag)", dt, reference.listOngoing(7, LIST_SIZE, ref, dt), ref,
+			sharded.listOngoing(7, LIST_SIZE, sh, dt), sh));
+	CHECK(sameLists("listForDay", dt, reference.listForDay(LIST_SIZE, ref, dt), ref,
+			sharded.listForDay(LIST_SIZE, sh, dt), sh));
+
+	DateTime refNext, shNext;
+	bool refFound = reference.nextDateTimeOfInterest(dt, refNext);
+	CHECK(refFound == sharded.nextDateTimeOfInterest(dt, shNext));
+	CHECK(! refFound || refNext == shNext);
+}
+
+int main()
+{
+	DateTime base(2016, 3, 1, 0, 0, 1);
+
+	// recurring events (one per shard): whole minutes, so they never share a start
+	// with the one-time ones, which would leave the order of ties up to the merge
+	addBoth(Chronos::Event(1, Mark::Daily(9, 0, 0), Span::Minutes(45)));
+	addBoth(Chronos::Event(2, Mark::Weekly(Weekday::Monday, 10, 30, 0), Span::Hours(1)));
+	addBoth(Chronos::Event(3, Mark::Monthly(2, 19, 0, 0), Span::Hours(2)));
+	addBoth(Chronos::Event(4, Mark::Hourly(20), Span::Minutes(5)));
+
+	// one-time events at distinct (odd) seconds over a week, as in test_columnar
+	srand(40);
+	for (int i=0; i<NUM_ONETIME; i++)
+	{
+		DateTime start(base + (Chronos::EpochTime)(((i * 7919) % NUM_ONETIME) * 3572));
+		Span::Seconds length((i % 17) ? (rand() % (6 * 3600)) : 0);
+		addBoth(Chronos::Event(10 + (i % 110), start, start + length));
+	}
+
+	for (EventID id=10; id<40; id += 3)
+	{
+		CHECK(reference.setTag(id, 7) == sharded.setTag(id, 7));
+	}
+
+	CHECK(reference.numEvents() == sharded.numEvents());
+	CHECK(reference.numRecurring() == sharded.numRecurring());
+
+	// each event went to the shard for its id
+	for (uint8_t s=0; s<NUM_SHARDS; s++)
+	{
+		Event::Occurrence occ;
+		for (EventID id=1; id<120; id++)
+		{
+			if (Sharded::shardFor(id) != s)
+				CHECK(! sharded.shard(s).nextOccurrenceOf(id, base, occ));
+		}
+	}
+
+	for (int q=0; q<400; q++)
+	{
+		// from before the first to after the last
+		compareAt(DateTime(base - (Chronos::EpochTime)86400 + (Chronos::EpochTime)(rand() % (9 * 86400))));
+	}
+
+	// and still, once some are gone
+	for (EventID id=10; id<120; id += 4)
+	{
+		while (reference.remove(id))
+		{
+			CHECK(sharded.remove(id));
+		}
+		CHECK(! sharded.remove(id));
+	}
+	CHECK(reference.numEvents() == sharded.numEvents());
+
+	for (int q=0; q<100; q++)
+	{
+		compareAt(DateTime(base + (Chronos::EpochTime)(rand() % (7 * 86400))));
+	}
+
+	// and with nothing but the recurring ones, one shard at a time
+	for (EventID id=10; id<120; id++)
+	{
+		while (reference.remove(id))
+		{
+			CHECK(sharded.remove(id));
+		}
+	}
+	CHECK(sharded.numEvents() == 4);
+	for (int q=0; q<50; q++)
+	{
+		compareAt(DateTime(base + (Chronos::EpochTime)(rand() % (40 * 86400))));
+	}
+
+	return CHECK_RESULT();
+}
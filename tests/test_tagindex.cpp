@@ -0,0 +1,201 @@
+/*
+ * test_tagindex.cpp
+ * Tagged queries through the per-tag index answer as an unfiltered query over a calendar
+ * holding only that tag's events, through removes, setTag()s, clear()s and update batches.
+ *
+ *  http://flyingcarsandstuff.com/projects/chronos
+ *  Created on: Oct 19, 2026
+ *      Author: agent <agent@local>
+ *      Part of the Chronos library project
+ *      Copyright (C) 2026 agent <agent@local>
+ *
+ *  This file is part of the Chronos embedded datetime/calendar library.
+ *
+ *     Chronos is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU Lesser Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     Chronos is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU Lesser Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser Public License
+ *    along with Chronos.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Chronos.h>
+#include <stdlib.h>
+#include <vector>
+#include "check.h"
+
+#define NUM_ROUNDS		400
+#define LIST_SIZE		10
+// indexed tags, and a few past them (which take the full scan)
+#define NUM_TAGS		(CHRONOS_CALENDAR_INDEXED_TAGS + 3)
+
+using namespace Chronos;
+
+DefineCalendarType(TestCalendar, 48);
+
+typedef struct {
+	EventID id;
+	uint8_t kind;
+	EventTag tag;
+} Spec;
+
+static Chronos::Event build(const Spec & spec)
+{
+	Chronos::Event evt;
+	switch (spec.kind % 6)
+	{
+	case 0: evt = Chronos::Event(spec.id, Mark::Daily(9, spec.id % 60, 0), Span::Hours(1)); break;
+	case 1: evt = Chronos::Event(spec.id, Mark::Hourly(spec.id % 60, 0), Span::Minutes(10)); break;
+	case 2: evt = Chronos::Event(spec.id, Mark::Weekly(Weekday::Monday, 10, spec.id % 60, 0), Span::Hours(2)); break;
+	case 3: evt = Chronos::Event(spec.id, Mark::Every(DateTime(2016, 1, 1, 0, 0, spec.id % 60), Span::Minutes(97)),
+			Span::Minutes(20)); break;
+	default:
+		evt = Chronos::Event(spec.id, DateTime(2016, 1, 1, 0, 0, 0) + (Chronos::EpochTime)(spec.kind * 7919UL + spec.id * 60),
+				Span::Hours(3));
+		break;
+	}
+	evt.setTag(spec.tag);
+	return evt;
+}
+
+static bool sameLists(const char * what, EventTag tag, uint8_t numA, const Chronos::Event::Occurrence a[],
+		uint8_t numB, const Chronos::Event::Occurrence b[])
+{
+	bool same = (numA == numB);
+	for (uint8_t i=0; same && i<numA; i++)
+	{
+		same = (a[i].id == b[i].id && a[i].start == b[i].start && a[i].finish == b[i].finish
+				&& a[i].isOngoing == b[i].isOngoing);
+	}
+	if (! same)
+		fprintf(stderr, "%s(%u) differs (%u vs %u)\n", what, tag, numA, numB);
+	return same;
+}
+
+static TestCalendar calendar;
+static TestCalendar onlyTagged;
+static std::vector<Spec> specs;
+
+// every tag's filtered queries, at a few points
+static void compareTags()
+{
+	Chronos::Event::Occurrence a[LIST_SIZE], b[LIST_SIZE];
+	for (EventTag tag=0; tag<NUM_TAGS; tag++)
+	{
+		onlyTagged.clear();
+		for (size_t i=0; i<specs.size(); i++)
+		{
+			if (specs[i].tag == tag)
+				onlyTagged.add(build(specs[i]));
+		}
+
+		for (int q=0; q<3; q++)
+		{
+			DateTime dt(DateTime(2016, 1, 1, 0, 0, 0) + (Chronos::EpochTime)(rand() % (20 * SECS_PER_DAY)));
+			CHECK(sameLists("listNext", tag, calendar.listNext(tag, LIST_SIZE, a, dt), a,
+					onlyTagged.listNext(LIST_SIZE, b, dt), b));
+			CHECK(sameLists("listOngoing", tag, calendar.listOngoing(tag, LIST_SIZE, a, dt), a,
+					onlyTagged.listOngoing(LIST_SIZE, b, dt), b));
+		}
+	}
+}
+
+static EventID newId()
+{
+	// EventIDs are small: reuse them, but not while one's in the calendar
+	for (;;)
+	{
+		EventID id = 1 + rand() % 100;
+		bool used = false;
+		for (size_t i=0; i<specs.size() && ! used; i++)
+			used = (specs[i].id == id);
+		if (! used)
+			return id;
+	}
+}
+
+static void addOne()
+{
+	Spec spec = { newId(), (uint8_t)(rand() % 12), (EventTag)(rand() % NUM_TAGS) };
+	if (calendar.add(build(spec)))
+		specs.push_back(spec);
+}
+
+static void removeOne()
+{
+	if (specs.empty())
+		return;
+
+	size_t i = rand() % specs.size();
+	CHECK(calendar.remove(specs[i].id));
+	specs.erase(specs.begin() + i);
+}
+
+static void retagOne()
+{
+	if (specs.empty())
+		return;
+
+	size_t i = rand() % specs.size();
+	EventTag tag = rand() % NUM_TAGS;
+	CHECK(calendar.setTag(specs[i].id, tag));
+	specs[i].tag = tag;
+}
+
+static void change()
+{
+	int r = rand() % 10;
+	if (r < 4)
+		addOne();
+	else if (r < 7)
+		removeOne();
+	else
+		retagOne();
+}
+
+int main()
+{
+	srand(38);
+	for (int i=0; i<30; i++)
+		addOne();
+	compareTags();
+
+	for (int round=0; round<NUM_ROUNDS; round++)
+	{
+		int r = rand() % 20;
+		if (r < 14)
+		{
+			change();
+		} else if (r < 19)
+		{
+			// a batch (sometimes nested), queried midway and after
+			calendar.beginUpdate();
+			bool nested = rand() % 2;
+			if (nested)
+				calendar.beginUpdate();
+			for (int i=0; i<5; i++)
+				change();
+			compareTags();
+			if (nested)
+				calendar.endUpdate();
+			for (int i=0; i<3; i++)
+				change();
+			calendar.endUpdate();
+		} else {
+			calendar.clear();
+			specs.clear();
+			for (int i=0; i<20; i++)
+				addOne();
+		}
+
+		compareTags();
+	}
+
+	return CHECK_RESULT();
+}